@@ -0,0 +1,306 @@
+/*							besgrad.c
+ *
+ *	Bessel functions and their derivatives
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sv, sx;
+ * double v[], x[], y[n], dy[n];
+ *
+ * j0_grad( n, x, sx, y, dy );	j1_grad( n, x, sx, y, dy );
+ * y0_grad( n, x, sx, y, dy );	y1_grad( n, x, sx, y, dy );
+ * i0_grad( n, x, sx, y, dy );	i1_grad( n, x, sx, y, dy );
+ * i0e_grad( n, x, sx, y, dy );	i1e_grad( n, x, sx, y, dy );
+ * k0_grad( n, x, sx, y, dy );	k1_grad( n, x, sx, y, dy );
+ * k0e_grad( n, x, sx, y, dy );	k1e_grad( n, x, sx, y, dy );
+ * jv_grad( n, v, sv, x, sx, y, dy );
+ * iv_grad( n, v, sv, x, sx, y, dy );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Each kernel sets y[i] to the Bessel function of the argument
+ * x[i*sx], and of the order v[i*sv] for jv and iv, and dy[i] to its
+ * derivative with respect to x.  Strides of 0 broadcast a single
+ * value.
+ *
+ * The derivatives follow from the functions of the neighbouring
+ * orders, which the value shares:
+ *
+ *   J0' = -J1,            J1' = J0 - J1/x,
+ *   Y0' = -Y1,            Y1' = Y0 - Y1/x,
+ *   I0' =  I1,            I1' = I0 - I1/x,
+ *   K0' = -K1,            K1' = -K0 - K1/x,
+ *   Jv' = (v/x) Jv - Jv+1,
+ *   Iv' = (v/x) Iv + Iv+1,
+ *
+ * and, for the exponentially scaled functions,
+ *
+ *   i0e' = i1e - sgn(x) i0e,     k0e' = k0e - k1e,
+ *   i1e' = i0e - i1e/x - sgn(x) i1e,
+ *   k1e' = k1e - k0e - k1e/x.
+ *
+ * At x = 0 the derivatives of J1, I1 and i1e are 1/2, and those of
+ * Jv and Iv are taken from (f    - f   )/2.
+ *                            v-1    v+1
+ *
+ * The elements are computed in parallel.
+ *
+ *
+ *
+ * ACCURACY:
+ *
+ * The values are those of the scalar functions.  The derivatives
+ * have the absolute accuracy of the functions they are formed of.
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * Those of the scalar functions.
+ *
+ */
+
+#include "mconf.h"
+#ifdef ANSIPROT
+extern double torch_cephes_j0 ( double );
+extern double torch_cephes_j1 ( double );
+extern double torch_cephes_y0 ( double );
+extern double torch_cephes_y1 ( double );
+extern double torch_cephes_i0 ( double );
+extern double torch_cephes_i1 ( double );
+extern double torch_cephes_i0e ( double );
+extern double torch_cephes_i1e ( double );
+extern double torch_cephes_k0 ( double );
+extern double torch_cephes_k1 ( double );
+extern double torch_cephes_k0e ( double );
+extern double torch_cephes_k1e ( double );
+extern double torch_cephes_jv ( double, double );
+extern double torch_cephes_iv ( double, double );
+static void besgr ( int, double, double, double *, double * );
+static void besgrad ( int, int, double *, int, double *, int, double *,
+		      double * );
+#else
+double torch_cephes_j0(), torch_cephes_j1(), torch_cephes_y0();
+double torch_cephes_y1(), torch_cephes_i0(), torch_cephes_i1();
+double torch_cephes_i0e(), torch_cephes_i1e(), torch_cephes_k0();
+double torch_cephes_k1(), torch_cephes_k0e(), torch_cephes_k1e();
+double torch_cephes_jv(), torch_cephes_iv();
+static void besgr(), besgrad();
+#endif
+
+/* Functions of besgr() */
+#define J0 0
+#define J1 1
+#define Y0 2
+#define Y1 3
+#define I0 4
+#define I1 5
+#define I0E 6
+#define I1E 7
+#define K0 8
+#define K1 9
+#define K0E 10
+#define K1E 11
+#define JV 12
+#define IV 13
+
+
+/* Value and derivative of the function f of order v at x */
+static void besgr( f, v, x, y, dy )
+int f;
+double v, x;
+double *y, *dy;
+{
+double a, b, s;
+
+s = x < 0.0 ? -1.0 : 1.0;
+switch( f )
+	{
+	case J0:
+		*y = torch_cephes_j0( x );
+		*dy = -torch_cephes_j1( x );
+		break;
+	case J1:
+		*y = torch_cephes_j1( x );
+		*dy = x == 0.0 ? 0.5 : torch_cephes_j0( x ) - *y / x;
+		break;
+	case Y0:
+		*y = torch_cephes_y0( x );
+		*dy = -torch_cephes_y1( x );
+		break;
+	case Y1:
+		*y = torch_cephes_y1( x );
+		*dy = torch_cephes_y0( x ) - *y / x;
+		break;
+	case I0:
+		*y = torch_cephes_i0( x );
+		*dy = torch_cephes_i1( x );
+		break;
+	case I1:
+		*y = torch_cephes_i1( x );
+		*dy = x == 0.0 ? 0.5 : torch_cephes_i0( x ) - *y / x;
+		break;
+	case I0E:
+		*y = torch_cephes_i0e( x );
+		*dy = torch_cephes_i1e( x ) - s * *y;
+		break;
+	case I1E:
+		*y = torch_cephes_i1e( x );
+		*dy = x == 0.0 ? 0.5 : torch_cephes_i0e( x ) - *y / x - s * *y;
+		break;
+	case K0:
+		*y = torch_cephes_k0( x );
+		*dy = -torch_cephes_k1( x );
+		break;
+	case K1:
+		*y = torch_cephes_k1( x );
+		*dy = -torch_cephes_k0( x ) - *y / x;
+		break;
+	case K0E:
+		*y = torch_cephes_k0e( x );
+		*dy = *y - torch_cephes_k1e( x );
+		break;
+	case K1E:
+		*y = torch_cephes_k1e( x );
+		*dy = *y - torch_cephes_k0e( x ) - *y / x;
+		break;
+	case JV:
+		*y = torch_cephes_jv( v, x );
+		if( x == 0.0 )
+			{
+			a = torch_cephes_jv( v - 1.0, x );
+			b = torch_cephes_jv( v + 1.0, x );
+			*dy = 0.5 * (a - b);
+			}
+		else
+			*dy = (v / x) * *y - torch_cephes_jv( v + 1.0, x );
+		break;
+	case IV:
+		*y = torch_cephes_iv( v, x );
+		if( x == 0.0 )
+			{
+			a = torch_cephes_iv( v - 1.0, x );
+			b = torch_cephes_iv( v + 1.0, x );
+			*dy = 0.5 * (a + b);
+			}
+		else
+			*dy = (v / x) * *y + torch_cephes_iv( v + 1.0, x );
+		break;
+	}
+}
+
+
+
+static void besgrad( f, n, v, sv, x, sx, y, dy )
+int f, n, sv, sx;
+double *v, *x, *y, *dy;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	besgr( f, v ? v[i*sv] : 0.0, x[i*sx], &y[i], &dy[i] );
+}
+
+
+
+void torch_cephes_j0_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( J0, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_j1_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( J1, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_y0_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( Y0, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_y1_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( Y1, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_i0_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( I0, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_i1_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( I1, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_i0e_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( I0E, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_i1e_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( I1E, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_k0_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( K0, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_k1_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( K1, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_k0e_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( K0E, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_k1e_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+besgrad( K1E, n, (double *)0, 0, x, sx, y, dy );
+}
+
+void torch_cephes_jv_grad( n, v, sv, x, sx, y, dy )
+int n, sv, sx;
+double *v, *x, *y, *dy;
+{
+besgrad( JV, n, v, sv, x, sx, y, dy );
+}
+
+void torch_cephes_iv_grad( n, v, sv, x, sx, y, dy )
+int n, sv, sx;
+double *v, *x, *y, *dy;
+{
+besgrad( IV, n, v, sv, x, sx, y, dy );
+}
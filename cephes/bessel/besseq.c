@@ -0,0 +1,331 @@
+/*							besseq.c
+ *
+ *	Bessel functions of all integer orders 0..nmax
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int nmax, n;
+ * double x[n], y[n * (nmax+1)];
+ *
+ * jn_seq( nmax, n, x, y );
+ * yn_seq( nmax, n, x, y );
+ * in_seq( nmax, n, x, y );
+ * kn_seq( nmax, n, x, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * For each of the n arguments x[i], writes the Bessel functions
+ * J, Y, I or K of orders 0, 1, ..., nmax to the row
+ * y[i*(nmax+1)], ..., y[i*(nmax+1) + nmax].
+ *
+ * Each row costs a single pass of the three-term recurrence
+ *
+ *             2k
+ *  f    (x) = -- f (x) -+ f   (x)
+ *   k+1        x   k       k-1
+ *
+ * run in its stable direction.  Y and K are dominant solutions and
+ * are recurred forward from y0, y1 and k0, k1.  J and I are
+ * recurred backward from an order well above nmax (Miller's
+ * algorithm), then normalized by J0 + 2 J2 + 2 J4 + ... = 1 and by
+ * i0(x) respectively.  When |x| > nmax every order of J is below
+ * the turning point and J is recurred forward from j0, j1 instead.
+ * Where i0(x) overflows, |x| > 713 or so, the orders of I are all
+ * returned infinite, without a recurrence of |x| steps; a NaN x
+ * gives a row of NaN.
+ *
+ * The rows are independent and computed in parallel.
+ *
+ *
+ *
+ * ACCURACY:
+ *
+ * Absolute error of J and relative error of Y, I, K are comparable
+ * to those of j0, y0, i0, k0 and their order-1 companions, growing
+ * slowly with nmax.  This is better than kn(), whose series and
+ * asymptotic expansions are good to about 1e-8.
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ *   message         condition              value returned
+ * yn_seq singularity  x = 0                  -MAXNUM
+ * yn_seq domain       x < 0                  -MAXNUM
+ * yn_seq overflow     |y| > MAXNUM           -MAXNUM
+ * kn_seq singularity  x = 0                   MAXNUM
+ * kn_seq domain       x < 0                   MAXNUM
+ * kn_seq overflow     y > MAXNUM              MAXNUM
+ *
+ */
+
+#include "mconf.h"
+#ifdef ANSIPROT
+extern double torch_cephes_fabs ( double );
+extern double torch_cephes_sqrt ( double );
+extern double torch_cephes_j0 ( double );
+extern double torch_cephes_j1 ( double );
+extern double torch_cephes_y0 ( double );
+extern double torch_cephes_y1 ( double );
+extern double torch_cephes_i0 ( double );
+extern double torch_cephes_k0 ( double );
+extern double torch_cephes_k1 ( double );
+static int mstart ( int, double );
+static void miller ( int, int, double, double *, int );
+#else
+double torch_cephes_fabs(), torch_cephes_sqrt(), torch_cephes_j0();
+double torch_cephes_j1(), torch_cephes_y0(), torch_cephes_y1();
+double torch_cephes_i0(), torch_cephes_k0(), torch_cephes_k1();
+static int mstart();
+static void miller();
+#endif
+extern double torch_cephes_MAXNUM, torch_cephes_INFINITY;
+
+/* Rescaling threshold of the backward recurrence */
+#define BIG 1.0e250
+#define BIGINV 1.0e-250
+/* Largest starting order, within the range of int */
+#define MAXSTART 2.0e9
+
+
+/* Even starting order of the backward recurrence for orders up to
+ * nmax at argument |x| = ax.
+ */
+static int mstart( nmax, ax )
+int nmax;
+double ax;
+{
+double m;
+
+m = ax > nmax ? ax : nmax;
+m = m + 20.0 + torch_cephes_sqrt( 160.0 * m );
+if( !(m <= MAXSTART) )
+	m = MAXSTART;
+return( 2 * ((int) m / 2) );
+}
+
+
+/* Miller's backward recurrence from order m down to 0, storing
+ * orders 0..nmax into y.  sign is -1 for J, +1 for I.  J is
+ * normalized here; I is left to the caller, up to a constant factor.
+ */
+static void miller( nmax, m, ax, y, sign )
+int nmax, m;
+double ax;
+double *y;
+int sign;
+{
+double fkp1, fk, fkm1, tox, sum;
+int k, j;
+
+tox = 2.0 / ax;
+fkp1 = 0.0;
+fk = 1.0;
+sum = 0.0;
+for( k=m; k>0; k-- )
+	{
+	/* f(k-1) from f(k) and f(k+1) */
+	fkm1 = k * tox * fk + sign * fkp1;
+	fkp1 = fk;
+	fk = fkm1;
+	if( torch_cephes_fabs(fk) > BIG )
+		{
+		fk *= BIGINV;
+		fkp1 *= BIGINV;
+		sum *= BIGINV;
+		for( j=k; j<=nmax; j++ )
+			y[j] *= BIGINV;
+		}
+	if( (k-1) <= nmax )
+		y[k-1] = fk;
+	if( ((k-1) & 1) == 0 && k > 1 )
+		sum += 2.0 * fk;
+	}
+sum += fk;
+/* For J, scale by the identity J0 + 2 J2 + 2 J4 + ... = 1.
+ * For I, the caller rescales by i0(x) / y[0].
+ */
+if( sign < 0 )
+	{
+	sum = 1.0 / sum;
+	for( j=0; j<=nmax; j++ )
+		y[j] *= sum;
+	}
+}
+
+
+
+void torch_cephes_jn_seq( nmax, n, x, y )
+int nmax, n;
+double *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double ax, tox, *row;
+	int k;
+
+	row = y + (long) i * (nmax + 1);
+	ax = torch_cephes_fabs( x[i] );
+	if( ax == 0.0 )
+		{
+		row[0] = 1.0;
+		for( k=1; k<=nmax; k++ )
+			row[k] = 0.0;
+		continue;
+		}
+	if( !(ax <= nmax) )
+		{
+		/* below the turning point: forward recurrence is stable;
+		 * NaN from j0 and j1 too */
+		row[0] = torch_cephes_j0( ax );
+		if( nmax > 0 )
+			row[1] = torch_cephes_j1( ax );
+		tox = 2.0 / ax;
+		for( k=1; k<nmax; k++ )
+			row[k+1] = k * tox * row[k] - row[k-1];
+		}
+	else
+		miller( nmax, mstart( nmax, ax ), ax, row, -1 );
+	/* J_k(-x) = (-1)^k J_k(x) */
+	if( x[i] < 0.0 )
+		for( k=1; k<=nmax; k+=2 )
+			row[k] = -row[k];
+	}
+}
+
+
+
+void torch_cephes_in_seq( nmax, n, x, y )
+int nmax, n;
+double *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double ax, t, scale, *row;
+	int k;
+
+	row = y + (long) i * (nmax + 1);
+	ax = torch_cephes_fabs( x[i] );
+	if( ax == 0.0 )
+		{
+		row[0] = 1.0;
+		for( k=1; k<=nmax; k++ )
+			row[k] = 0.0;
+		continue;
+		}
+	t = ax < torch_cephes_INFINITY ? torch_cephes_i0( ax ) : ax;
+	if( !(t <= torch_cephes_MAXNUM) )
+		{
+		/* overflow, or x infinite or NaN */
+		for( k=0; k<=nmax; k++ )
+			row[k] = t;
+		}
+	else
+		{
+		miller( nmax, mstart( nmax, ax ), ax, row, 1 );
+		scale = t / row[0];
+		row[0] = t;
+		for( k=1; k<=nmax; k++ )
+			row[k] *= scale;
+		}
+	/* I_k(-x) = (-1)^k I_k(x) */
+	if( x[i] < 0.0 )
+		for( k=1; k<=nmax; k+=2 )
+			row[k] = -row[k];
+	}
+}
+
+
+
+void torch_cephes_yn_seq( nmax, n, x, y )
+int nmax, n;
+double *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double tox, *row;
+	int k;
+
+	row = y + (long) i * (nmax + 1);
+	if( x[i] <= 0.0 )
+		{
+		if( x[i] == 0.0 )
+			torch_cephes_mtherr( "yn_seq", SING );
+		else
+			torch_cephes_mtherr( "yn_seq", DOMAIN );
+		for( k=0; k<=nmax; k++ )
+			row[k] = -torch_cephes_MAXNUM;
+		continue;
+		}
+	row[0] = torch_cephes_y0( x[i] );
+	if( nmax > 0 )
+		row[1] = torch_cephes_y1( x[i] );
+	tox = 2.0 / x[i];
+	for( k=1; k<nmax; k++ )
+		{
+		row[k+1] = k * tox * row[k] - row[k-1];
+		if( row[k+1] < -torch_cephes_MAXNUM )
+			{
+			torch_cephes_mtherr( "yn_seq", OVERFLOW );
+			for( k=k+1; k<=nmax; k++ )
+				row[k] = -torch_cephes_MAXNUM;
+			break;
+			}
+		}
+	}
+}
+
+
+
+void torch_cephes_kn_seq( nmax, n, x, y )
+int nmax, n;
+double *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double tox, *row;
+	int k;
+
+	row = y + (long) i * (nmax + 1);
+	if( x[i] <= 0.0 )
+		{
+		if( x[i] == 0.0 )
+			torch_cephes_mtherr( "kn_seq", SING );
+		else
+			torch_cephes_mtherr( "kn_seq", DOMAIN );
+		for( k=0; k<=nmax; k++ )
+			row[k] = torch_cephes_MAXNUM;
+		continue;
+		}
+	row[0] = torch_cephes_k0( x[i] );
+	if( nmax > 0 )
+		row[1] = torch_cephes_k1( x[i] );
+	tox = 2.0 / x[i];
+	for( k=1; k<nmax; k++ )
+		{
+		row[k+1] = k * tox * row[k] + row[k-1];
+		if( row[k+1] > torch_cephes_MAXNUM )
+			{
+			torch_cephes_mtherr( "kn_seq", OVERFLOW );
+			for( k=k+1; k<=nmax; k++ )
+				row[k] = torch_cephes_MAXNUM;
+			break;
+			}
+		}
+	}
+}
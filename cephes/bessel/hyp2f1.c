@@ -66,6 +66,7 @@ Copyright 1984, 1987, 1992, 2000 by Stephen L. Moshier
 
 
 #include "mconf.h"
+#include "../torch_profile.h"
 
 #ifdef DEC
 #define EPS 1.0e-14
@@ -89,6 +90,23 @@ Copyright 1984, 1987, 1992, 2000 by Stephen L. Moshier
 
 #define ETHRESH 1.0e-12
 
+/* Branches of hyp2f1() */
+#define HDIV 0		/* rejected, MAXNUM */
+#define HPOWA 1		/* c = b: (1-x)^-a */
+#define HPOWB 2		/* c = a: (1-x)^-b */
+#define HONE 3		/* x = 1: gamma function ratio */
+#define HREC 4		/* recurrence on c, one at a time */
+#define HNEGC 5		/* c-a or c-b negative integer, AMS55 #15.3.3 */
+#define HNEG 6		/* x < -0.5, AMS55 #15.3.4 */
+#define HNEAR 7		/* x > 0.9, AMS55 #15.3.6 */
+#define HPSI 8		/* x > 0.9, c-a-b integer, AMS55 #15.3.10-12 */
+#define HSER 9		/* defining power series */
+#define NBRANCH 10
+
+/* Code paths of the instrumentation build besides the branches */
+#define PSER 10		/* power series hys2f1() */
+#define PPSI 11		/* psi function expansion */
+
 #ifdef ANSIPROT
 extern double torch_cephes_fabs ( double );
 extern double torch_cephes_pow ( double, double );
@@ -100,6 +118,8 @@ extern double torch_cephes_psi ( double );
 static double hyt2f1(double, double, double, double, double *);
 static double hys2f1(double, double, double, double, double *);
 double torch_cephes_hyp2f1(double, double, double, double);
+extern void * malloc ( unsigned long );
+extern void free ( void * );
 #else
 double torch_cephes_fabs(), torch_cephes_pow(),
     torch_cephes_round(), torch_cephes_gamma(), torch_cephes_log(),
@@ -107,6 +127,8 @@ double torch_cephes_fabs(), torch_cephes_pow(),
 static double hyt2f1();
 static double hys2f1();
 double torch_cephes_hyp2f1();
+void * malloc();
+void free();
 #endif
 extern double torch_cephes_MAXNUM, torch_cephes_MACHEP;
 
@@ -141,11 +163,13 @@ if( ax < 1.0 )
 	{
 	if( torch_cephes_fabs(b-c) < EPS )		/* b = c */
 		{
+		PROFILE( PROF_HYP2F1, HPOWA, 0 );
 		y = torch_cephes_pow( s, -a );	/* s to the -a power */
 		goto hypdon;
 		}
 	if( torch_cephes_fabs(a-c) < EPS )		/* a = c */
 		{
+		PROFILE( PROF_HYP2F1, HPOWB, 0 );
 		y = torch_cephes_pow( s, -b );	/* s to the -b power */
 		goto hypdon;
 		}
@@ -202,6 +226,7 @@ if( torch_cephes_fabs(ax-1.0) < EPS )			/* |x| == 1.0	*/
 			}
 		if( d <= 0.0 )
 			goto hypdiv;
+		PROFILE( PROF_HYP2F1, HONE, 0 );
 		y = torch_cephes_gamma(c)*torch_cephes_gamma(d)/
                     (torch_cephes_gamma(p)*torch_cephes_gamma(r));
 		goto hypdon;
@@ -224,6 +249,7 @@ if( d < 0.0 )
 /* Apply the recurrence if power series fails */
 	err = 0.0;
 	aid = 2 - id;
+	PROFILE( PROF_HYP2F1, HREC, aid );
 	e = c + aid;
 	d2 = torch_cephes_hyp2f1(a,b,e,x);
 	d1 = torch_cephes_hyp2f1(a,b,e+1.0,x);
@@ -259,11 +285,13 @@ return(y);
  * AMS55 #15.3.3
  */
 hypf:
+PROFILE( PROF_HYP2F1, HNEGC, 0 );
 y = torch_cephes_pow( s, d ) * hys2f1( c-a, c-b, c, x, &err );
 goto hypdon;
 
 /* The alarm exit */
 hypdiv:
+PROFILE( PROF_HYP2F1, HDIV, 0 );
 torch_cephes_mtherr( "hyp2f1", OVERFLOW );
 return( torch_cephes_MAXNUM );
 }
@@ -288,6 +316,7 @@ err = 0.0;
 s = 1.0 - x;
 if( x < -0.5 )
 	{
+	PROFILE( PROF_HYP2F1, HNEG, 0 );
 	if( b > a )
 		y = torch_cephes_pow( s, -a ) *
                     hys2f1( a, c-b, c, -x/s, &err );
@@ -309,8 +338,12 @@ if( torch_cephes_fabs(d-id) > EPS ) /* test for integer c-a-b */
 /* Try the power series first */
 	y = hys2f1( a, b, c, x, &err );
 	if( err < ETHRESH )
+		{
+		PROFILE( PROF_HYP2F1, HSER, 0 );
 		goto done;
+		}
 /* If power series fails, then apply AMS55 #15.3.6 */
+	PROFILE( PROF_HYP2F1, HNEAR, 0 );
 	q = hys2f1( a, b, 1.0-d, s, &err );
 	q *= torch_cephes_gamma(d) /(torch_cephes_gamma(c-a) *
                                      torch_cephes_gamma(c-b));
@@ -347,6 +380,7 @@ else
 		aid = -id;
 		}
 
+	PROFILE( PROF_HYP2F1, HPSI, 0 );
 	ax = torch_cephes_log(s);
 
 	/* sum for t = 0 */
@@ -368,6 +402,7 @@ else
 		t += 1.0;
 		}
 	while( torch_cephes_fabs(q/y) > EPS );
+	PROFILE( PROF_HYP2F1, PPSI, (int) t - 1 );
 
 
 	if( id == 0.0 )
@@ -415,6 +450,7 @@ psidon:
 }
 
 /* Use defining power series if no special cases */
+PROFILE( PROF_HYP2F1, HSER, 0 );
 y = hys2f1( a, b, c, x, &err );
 
 done:
@@ -464,6 +500,7 @@ do
 		}
 	}
 while( torch_cephes_fabs(u/s) > torch_cephes_MACHEP );
+PROFILE( PROF_HYP2F1, PSER, i );
 
 /* return estimated relative error */
 *loss = (torch_cephes_MACHEP*umax)/torch_cephes_fabs(s) +
@@ -471,3 +508,591 @@ while( torch_cephes_fabs(u/s) > torch_cephes_MACHEP );
 
 return(s);
 }
+
+
+
+/*							hyp2f1_plan
+ *
+ *	Gauss hypergeometric function at many x for fixed a, b, c
+ *
+ *
+ * SYNOPSIS:
+ *
+ * hyp2f1plan plan;
+ * double a, b, c, x[n], y[n];
+ *
+ * hyp2f1_plan( a, b, c, &plan );
+ * hyp2f1_eval( &plan, n, x, y );
+ *
+ *
+ * DESCRIPTION:
+ *
+ * hyp2f1_plan() makes the tests of hyp2f1() that depend only on the
+ * parameters, once.  hyp2f1_eval() then sets y[i] = hyp2f1(a,b,c,x[i]).
+ *
+ * The x values are first sorted by the branch of hyp2f1() they
+ * take.  The gamma and psi function ratios of the transformations
+ * near x = 1 are computed once per plan, the first time a branch
+ * needs them.  The power series of the branches that reduce to one
+ * (the defining series, the transformation for x < -0.5 and the one
+ * for negative integer c-a or c-b) run on LANES values of x at a
+ * time, sharing the parameter part of each term.  The cases hyp2f1()
+ * handles by recurrence on c are evaluated one x at a time.
+ *
+ * The error messages are those of hyp2f1(), issued at most once per
+ * call.
+ */
+
+#define LANES 8
+#define CHUNK 256
+
+/* Parameter-only state of hyp2f1(), see hyp2f1_plan() */
+typedef struct
+	{
+	double a, b, c;
+	double d, id;		/* c-a-b and the nearest integer */
+	int flag;		/* as in hyp2f1(): negative integer a, b, c-a, c-b */
+	int cneg;		/* c negative integer: 1 polynomial, -1 divergent */
+	int have;		/* which of the constants below are set */
+	double gone;		/* value at x = 1 */
+	double gq, gr, gc;	/* gamma ratios of AMS55 #15.3.6, gamma(c) */
+	double e, d1, d2;	/* psi function expansion */
+	int aid;
+	double psi1, psie, psia, psib, ge1, ge2, gy, gy1;
+	}hyp2f1plan;
+
+/* Cached constants of the plan */
+#define HAVEONE 1
+#define HAVENEAR 2
+#define HAVEPSI 4
+
+#ifdef ANSIPROT
+static int hypbranch ( hyp2f1plan *, double );
+static void hypconst ( hyp2f1plan *, int );
+static void hys2f1v ( double, double, double, int, double *, double * );
+static double hypnear ( hyp2f1plan *, double, double *, double );
+static double hyppsi ( hyp2f1plan *, double );
+#else
+static int hypbranch();
+static void hypconst();
+static void hys2f1v();
+static double hypnear(), hyppsi();
+#endif
+
+void torch_cephes_hyp2f1_plan( a, b, c, plan )
+double a, b, c;
+hyp2f1plan *plan;
+{
+double ia, ib, ic;
+
+plan->a = a;
+plan->b = b;
+plan->c = c;
+plan->have = 0;
+plan->flag = 0;
+ia = torch_cephes_round(a);
+ib = torch_cephes_round(b);
+if( a <= 0 && torch_cephes_fabs(a-ia) < EPS )
+	plan->flag |= 1;
+if( b <= 0 && torch_cephes_fabs(b-ib) < EPS )
+	plan->flag |= 2;
+
+/* c negative integer: the polynomial cases terminate before the
+ * explosion, all others diverge.
+ */
+plan->cneg = 0;
+if( c <= 0.0 )
+	{
+	ic = torch_cephes_round(c);
+	if( torch_cephes_fabs(c-ic) < EPS )
+		{
+		plan->cneg = -1;
+		if( ((plan->flag & 1) && (ia > ic)) || ((plan->flag & 2) && (ib > ic)) )
+			plan->cneg = 1;
+		}
+	}
+
+ia = torch_cephes_round(c - a);
+if( (ia <= 0.0) && (torch_cephes_fabs(c-a-ia) < EPS) )
+	plan->flag |= 4;
+ib = torch_cephes_round(c - b);
+if( (ib <= 0.0) && (torch_cephes_fabs(c-b-ib) < EPS) )
+	plan->flag |= 8;
+
+plan->d = c - a - b;
+plan->id = torch_cephes_round(plan->d);
+}
+
+
+/* The branch hyp2f1() and hyt2f1() take for x, in the same order */
+static int hypbranch( plan, x )
+hyp2f1plan *plan;
+double x;
+{
+double ax, d;
+
+d = plan->d;
+ax = torch_cephes_fabs(x);
+if( ax < 1.0 )
+	{
+	if( torch_cephes_fabs(plan->b - plan->c) < EPS )
+		return( HPOWA );
+	if( torch_cephes_fabs(plan->a - plan->c) < EPS )
+		return( HPOWB );
+	}
+if( plan->cneg < 0 )
+	return( HDIV );
+if( plan->cneg == 0 && (plan->flag & 3) == 0 )
+	{
+	if( ax > 1.0 )
+		return( HDIV );
+	if( torch_cephes_fabs(ax-1.0) < EPS )
+		{
+		if( x > 0.0 )
+			{
+			if( plan->flag & 12 )
+				return( d >= 0.0 ? HNEGC : HDIV );
+			if( d <= 0.0 )
+				return( HDIV );
+			return( HONE );
+			}
+		if( d <= -1.0 )
+			return( HDIV );
+		}
+	if( d < 0.0 )
+		return( HREC );
+	if( plan->flag & 12 )
+		return( HNEGC );
+	}
+/* hyt2f1() */
+if( x < -0.5 )
+	return( HNEG );
+if( x > 0.9 )
+	{
+	if( torch_cephes_fabs(d - plan->id) > EPS )
+		return( HNEAR );
+	return( HPSI );
+	}
+return( HSER );
+}
+
+
+/* Compute the constants of branch br, if not already done */
+static void hypconst( plan, br )
+hyp2f1plan *plan;
+int br;
+{
+double a, b, c, d, e;
+
+a = plan->a;
+b = plan->b;
+c = plan->c;
+d = plan->d;
+if( br == HONE && !(plan->have & HAVEONE) )
+	{
+	plan->gone = torch_cephes_gamma(c) * torch_cephes_gamma(d) /
+		(torch_cephes_gamma(c-a) * torch_cephes_gamma(c-b));
+	plan->have |= HAVEONE;
+	}
+if( br == HNEAR && !(plan->have & HAVENEAR) )
+	{
+	plan->gq = torch_cephes_gamma(d) /
+		(torch_cephes_gamma(c-a) * torch_cephes_gamma(c-b));
+	plan->gr = torch_cephes_gamma(-d) /
+		(torch_cephes_gamma(a) * torch_cephes_gamma(b));
+	plan->gc = torch_cephes_gamma(c);
+	plan->have |= HAVENEAR;
+	}
+if( br == HPSI && !(plan->have & HAVEPSI) )
+	{
+	if( plan->id >= 0.0 )
+		{
+		e = d;
+		plan->d1 = d;
+		plan->d2 = 0.0;
+		plan->aid = plan->id;
+		}
+	else
+		{
+		e = -d;
+		plan->d1 = 0.0;
+		plan->d2 = d;
+		plan->aid = -plan->id;
+		}
+	plan->e = e;
+	plan->psi1 = torch_cephes_psi(1.0);
+	plan->psie = torch_cephes_psi(1.0+e);
+	plan->psia = torch_cephes_psi(a+plan->d1);
+	plan->psib = torch_cephes_psi(b+plan->d1);
+	plan->ge1 = torch_cephes_gamma(e+1.0);
+	plan->ge2 = torch_cephes_gamma(e+2.0);
+	plan->gc = torch_cephes_gamma(c);
+	if( plan->id == 0.0 )
+		plan->gy = plan->gc / (torch_cephes_gamma(a) * torch_cephes_gamma(b));
+	else
+		{
+		plan->gy1 = torch_cephes_gamma(e) * plan->gc /
+			(torch_cephes_gamma(a+plan->d1) * torch_cephes_gamma(b+plan->d1));
+		plan->gy = plan->gc /
+			(torch_cephes_gamma(a+plan->d2) * torch_cephes_gamma(b+plan->d2));
+		}
+	plan->have |= HAVEPSI;
+	}
+}
+
+
+/* hys2f1() of n values of x, LANES at a time.  The parameter part
+ * of each term is computed once for all lanes; each lane stops
+ * accumulating when its own series has converged.  Stores the sums
+ * in y and the estimated relative errors in x.
+ */
+static void hys2f1v( a, b, c, n, x, y )
+double a, b, c;
+int n;
+double *x, *y;
+{
+double u[LANES], s[LANES], umax[LANES], xv[LANES];
+int it[LANES], live[LANES];
+double k, t, au;
+int i, j, nl, active;
+
+for( i=0; i<n; i+=LANES )
+	{
+	nl = n - i < LANES ? n - i : LANES;
+	if( torch_cephes_fabs(c) < EPS )
+		{
+		for( j=0; j<nl; j++ )
+			{
+			y[i+j] = torch_cephes_MAXNUM;
+			x[i+j] = 1.0;
+			}
+		continue;
+		}
+	for( j=0; j<LANES; j++ )
+		{
+		xv[j] = j < nl ? x[i+j] : 0.0;
+		u[j] = 1.0;
+		s[j] = 1.0;
+		umax[j] = 0.0;
+		it[j] = 0;
+		live[j] = j < nl;
+		}
+	k = 0.0;
+	do
+		{
+		t = (a+k) * (b+k) / ((c+k) * (k+1.0));
+		active = 0;
+		for( j=0; j<LANES; j++ )
+			{
+			if( !live[j] )
+				continue;
+			u[j] *= t * xv[j];
+			s[j] += u[j];
+			au = torch_cephes_fabs(u[j]);
+			if( au > umax[j] )
+				umax[j] = au;
+			it[j] += 1;
+			if( torch_cephes_fabs(u[j]/s[j]) > torch_cephes_MACHEP )
+				active += 1;
+			else
+				live[j] = 0;
+			}
+		k += 1.0;
+		}
+	while( active && k < 10000.0 );
+	for( j=0; j<nl; j++ )
+		{
+		PROFILE( PROF_HYP2F1, PSER, it[j] );
+		y[i+j] = s[j];
+		if( live[j] )
+			x[i+j] = 1.0;
+		else
+			x[i+j] = (torch_cephes_MACHEP*umax[j])/torch_cephes_fabs(s[j]) +
+				(torch_cephes_MACHEP*it[j]);
+		}
+	}
+}
+
+
+/* AMS55 #15.3.6 for x > 0.9, after the power series y, with
+ * estimated error *loss, failed.
+ */
+static double hypnear( plan, x, loss, y )
+hyp2f1plan *plan;
+double x, *loss, y;
+{
+double a, b, c, d, s, q, r, err1;
+
+if( *loss < ETHRESH )
+	return( y );
+a = plan->a;
+b = plan->b;
+c = plan->c;
+d = plan->d;
+s = 1.0 - x;
+q = hys2f1( a, b, 1.0-d, s, loss ) * plan->gq;
+r = torch_cephes_pow(s,d) * hys2f1( c-a, c-b, d+1.0, s, &err1 ) * plan->gr;
+y = q + r;
+q = torch_cephes_fabs(q);
+r = torch_cephes_fabs(r);
+if( q > r )
+	r = q;
+*loss += err1 + (torch_cephes_MACHEP*r)/y;
+return( y * plan->gc );
+}
+
+
+/* Psi function expansion of hyt2f1(), with the parameter-only
+ * gamma and psi values taken from the plan, and the psi values
+ * along the sum advanced by psi(z+1) = psi(z) + 1/z where the
+ * arguments are positive.
+ */
+static double hyppsi( plan, x )
+hyp2f1plan *plan;
+double x;
+{
+double a, b, e, d1, d2, s, ax, y, y1, p, q, r, t;
+double p1, pe, pa, pb;
+int i, aid, rec;
+
+a = plan->a;
+b = plan->b;
+e = plan->e;
+d1 = plan->d1;
+d2 = plan->d2;
+aid = plan->aid;
+s = 1.0 - x;
+ax = torch_cephes_log(s);
+rec = (a+d1 > 0.0) && (b+d1 > 0.0);
+
+/* sum for t = 0 */
+y = plan->psi1 + plan->psie - plan->psia - plan->psib - ax;
+y /= plan->ge1;
+
+p = (a+d1) * (b+d1) * s / plan->ge2; /* Poch for t=1 */
+p1 = plan->psi1 + 1.0;
+pe = plan->psie + 1.0/(1.0+e);
+pa = plan->psia + 1.0/(a+d1);
+pb = plan->psib + 1.0/(b+d1);
+t = 1.0;
+do
+	{
+	if( rec )
+		r = p1 + pe - pa - pb - ax;
+	else
+		r = torch_cephes_psi(1.0+t) + torch_cephes_psi(1.0+t+e)
+			- torch_cephes_psi(a+t+d1) - torch_cephes_psi(b+t+d1) - ax;
+	q = p * r;
+	y += q;
+	p *= s * (a+t+d1) / (t+1.0);
+	p *= (b+t+d1) / (t+1.0+e);
+	p1 += 1.0/(1.0+t);
+	pe += 1.0/(1.0+t+e);
+	pa += 1.0/(a+t+d1);
+	pb += 1.0/(b+t+d1);
+	t += 1.0;
+	}
+while( torch_cephes_fabs(q/y) > EPS );
+PROFILE( PROF_HYP2F1, PPSI, (int) t - 1 );
+
+if( plan->id == 0.0 )
+	return( y * plan->gy );
+
+y1 = 1.0;
+t = 0.0;
+p = 1.0;
+for( i=1; i<aid; i++ )
+	{
+	r = 1.0-e+t;
+	p *= s * (a+t+d2) * (b+t+d2) / r;
+	t += 1.0;
+	p /= t;
+	y1 += p;
+	}
+y1 *= plan->gy1;
+y *= plan->gy;
+if( (aid & 1) != 0 )
+	y = -y;
+
+q = torch_cephes_pow( s, plan->id );	/* s to the id power */
+if( plan->id > 0.0 )
+	y *= q;
+else
+	y1 *= q;
+return( y + y1 );
+}
+
+
+
+void torch_cephes_hyp2f1_eval( plan, n, x, y )
+hyp2f1plan *plan;
+int n;
+double *x, *y;
+{
+int count[NBRANCH], start[NBRANCH];
+int *br, *idx;
+double *xs, *ys;
+double a, b, c, d;
+int i, k, g, nloss, ndiv;
+
+br = (int *) malloc( n * sizeof(int) + 1 );
+idx = (int *) malloc( n * sizeof(int) + 1 );
+xs = (double *) malloc( n * sizeof(double) + 1 );
+ys = (double *) malloc( n * sizeof(double) + 1 );
+if( br == 0 || idx == 0 || xs == 0 || ys == 0 )
+	{
+	for( i=0; i<n; i++ )
+		y[i] = torch_cephes_hyp2f1( plan->a, plan->b, plan->c, x[i] );
+	goto freeall;
+	}
+a = plan->a;
+b = plan->b;
+c = plan->c;
+d = plan->d;
+
+/* Sort the x values by branch */
+for( g=0; g<NBRANCH; g++ )
+	count[g] = 0;
+for( i=0; i<n; i++ )
+	{
+	br[i] = hypbranch( plan, x[i] );
+	count[br[i]] += 1;
+	/* HREC goes through hyp2f1(), which records its own path */
+	if( br[i] != HREC )
+		PROFILE( PROF_HYP2F1, br[i], 0 );
+	}
+k = 0;
+for( g=0; g<NBRANCH; g++ )
+	{
+	start[g] = k;
+	k += count[g];
+	if( count[g] > 0 )
+		hypconst( plan, g );
+	}
+for( i=0; i<n; i++ )
+	idx[start[br[i]]++] = i;
+for( g=0; g<NBRANCH; g++ )
+	start[g] -= count[g];
+
+/* The arguments of the power series of each branch */
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( k=0; k<n; k++ )
+	{
+	double xi;
+
+	xi = x[idx[k]];
+	if( br[idx[k]] == HNEG )
+		xi = -xi/(1.0 - xi);
+	xs[k] = xi;
+	}
+
+nloss = 0;
+ndiv = 0;
+for( g=0; g<NBRANCH; g++ )
+	{
+	int i0, m;
+
+	i0 = start[g];
+	m = count[g];
+	if( m == 0 )
+		continue;
+	switch( g )
+		{
+		case HSER:
+		case HNEAR:
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+			for( k=0; k<m; k+=CHUNK )
+				hys2f1v( a, b, c, m-k < CHUNK ? m-k : CHUNK,
+					 xs+i0+k, ys+i0+k );
+			break;
+		case HNEGC:
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+			for( k=0; k<m; k+=CHUNK )
+				hys2f1v( c-a, c-b, c, m-k < CHUNK ? m-k : CHUNK,
+					 xs+i0+k, ys+i0+k );
+			break;
+		case HNEG:
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+			for( k=0; k<m; k+=CHUNK )
+				{
+				if( b > a )
+					hys2f1v( a, c-b, c, m-k < CHUNK ? m-k : CHUNK,
+						 xs+i0+k, ys+i0+k );
+				else
+					hys2f1v( c-a, b, c, m-k < CHUNK ? m-k : CHUNK,
+						 xs+i0+k, ys+i0+k );
+				}
+			break;
+		}
+	}
+
+/* Finish each value according to its branch.  After hys2f1v, xs
+ * holds the estimated error of the series.
+ */
+#pragma omp parallel for reduction(+:nloss,ndiv) copyin(torch_cephes_stats_id)
+for( k=0; k<n; k++ )
+	{
+	double xi, s, yi, loss;
+	int i;
+
+	i = idx[k];
+	xi = x[i];
+	s = 1.0 - xi;
+	loss = 0.0;
+	switch( br[i] )
+		{
+		case HDIV:
+			ndiv += 1;
+			yi = torch_cephes_MAXNUM;
+			break;
+		case HPOWA:
+			yi = torch_cephes_pow( s, -a );
+			break;
+		case HPOWB:
+			yi = torch_cephes_pow( s, -b );
+			break;
+		case HONE:
+			yi = plan->gone;
+			break;
+		case HREC:
+			yi = torch_cephes_hyp2f1( a, b, c, xi );
+			break;
+		case HNEGC:
+			yi = torch_cephes_pow( s, d ) * ys[k];
+			loss = xs[k];
+			break;
+		case HNEG:
+			yi = torch_cephes_pow( s, b > a ? -a : -b ) * ys[k];
+			loss = xs[k];
+			break;
+		case HNEAR:
+			loss = xs[k];
+			yi = hypnear( plan, xi, &loss, ys[k] );
+			break;
+		case HPSI:
+			yi = hyppsi( plan, xi );
+			break;
+		default:
+			yi = ys[k];
+			loss = xs[k];
+			break;
+		}
+	if( loss > ETHRESH )
+		nloss += 1;
+	y[i] = yi;
+	}
+if( ndiv )
+	torch_cephes_mtherr( "hyp2f1", OVERFLOW );
+else if( nloss )
+	torch_cephes_mtherr( "hyp2f1", PLOSS );
+
+freeall:
+if( br )
+	free( br );
+if( idx )
+	free( idx );
+if( xs )
+	free( xs );
+if( ys )
+	free( ys );
+}
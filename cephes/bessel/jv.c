@@ -48,6 +48,7 @@ Copyright 1984, 1987, 1989, 1992, 2000 by Stephen L. Moshier
 
 
 #include "mconf.h"
+#include "../torch_profile.h"
 #define DEBUG 0
 
 #ifdef DEC
@@ -121,13 +122,20 @@ if( y == an )
 		x = -x;
 		}
 	if( n == 0.0 )
+		{
+		PROFILE( PROF_JV, 0, 0 );
 		return( torch_cephes_j0(x) );
+		}
 	if( n == 1.0 )
+		{
+		PROFILE( PROF_JV, 0, 0 );
 		return( sign * torch_cephes_j1(x) );
+		}
 	}
 
 if( (x < 0.0) && (y != an) )
 	{
+	PROFILE( PROF_JV, 6, 0 );
 	torch_cephes_mtherr( "Jv", DOMAIN );
 	y = 0.0;
 	goto done;
@@ -157,11 +165,13 @@ if( an < 500.0 )
 		q = recur( &n, x, &k, 1 );
 		if( k == 0.0 )
 			{
+			PROFILE( PROF_JV, 0, 0 );
 			y = torch_cephes_j0(x)/q;
 			goto done;
 			}
 		if( k == 1.0 )
 			{
+			PROFILE( PROF_JV, 0, 0 );
 			y = torch_cephes_j1(x)/q;
 			goto done;
 			}
@@ -213,6 +223,7 @@ rlarger:
 		if( q == 0.0 )
 			{
 underf:
+			PROFILE( PROF_JV, 6, 0 );
 			y = 0.0;
 			goto done;
 			}
@@ -255,6 +266,7 @@ else
  */
 	if( n < 0.0 )
 		{
+		PROFILE( PROF_JV, 6, 0 );
 		torch_cephes_mtherr( "Jv", TLOSS );
 		y = 0.0;
 		goto done;
@@ -412,6 +424,7 @@ if( cancel )
 		pkm2 = pk;
 		}
 	}
+PROFILE( PROF_JV, 3, ctr + (int) (*n - k) );
 *newn = k;
 #if DEBUG
 printf( "newn %.6e rans %.6e\n", k, pkm2 );
@@ -448,6 +461,7 @@ while( t > torch_cephes_MACHEP )
 	if( y != 0 )
 		t = torch_cephes_fabs( u/y );
 	}
+PROFILE( PROF_JV, 1, (int) k - 1 );
 #if DEBUG
 printf( "power series=%.5e ", y );
 #endif
@@ -553,6 +567,7 @@ while( t > torch_cephes_MACHEP )
 	}	
 
 hank1:
+PROFILE( PROF_JV, 2, (int) (j - 1.0) / 2 );
 u = x - (0.5*n + 0.25) * torch_cephes_PI;
 t = torch_cephes_sqrt( 2.0/(torch_cephes_PI*x) ) *
     ( pp * torch_cephes_cos(u) - qq * torch_cephes_sin(u) );
@@ -785,6 +800,7 @@ for( k=0; k<=3; k++ )
 		break;
 	np /= n*n;
 	}
+PROFILE( PROF_JV, 4, k < 4 ? k + 1 : 4 );
 
 /* normalizing factor ( 4*zeta/(1 - z**2) )**1/4	*/
 t = 4.0 * zeta/zz;
@@ -840,6 +856,7 @@ double nk, fk, gk, pp, qq;
 double F[5], G[4];
 int k;
 
+PROFILE( PROF_JV, 5, 0 );
 cbn = cbrt(n);
 z = (x - n)/cbn;
 cbtwo = cbrt( 2.0 );
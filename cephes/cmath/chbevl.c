@@ -48,6 +48,11 @@
  * addition per loop than evaluating a nested polynomial of
  * the same degree.
  *
+ * chbevl_batch( m, x, array, n, y ) sets y[i], i < m, to the
+ * series at x[i], running the recurrence for blocks of elements
+ * at once.  The results are those of chbevl().  y[] must not
+ * overlap x[].
+ *
  */
 /*							chbevl.c	*/
 
@@ -80,3 +85,40 @@ while( --i );
 
 return( 0.5*(b0-b2) );
 }
+
+
+/*							chbevl_batch()	*/
+
+#define CHUNK 256
+
+void torch_cephes_chbevl_batch( m, x, array, n, y )
+int m;
+double x[];
+double array[];
+int n;
+double y[];
+{
+double b1[CHUNK], b2[CHUNK], *b0;
+int i, j, k, nc;
+
+for( i=0; i<m; i+=CHUNK )
+	{
+	nc = m - i < CHUNK ? m - i : CHUNK;
+	b0 = &y[i];
+	for( j=0; j<nc; j++ )
+		{
+		b0[j] = array[0];
+		b1[j] = 0.0;
+		b2[j] = 0.0;
+		}
+	for( k=1; k<n; k++ )
+		for( j=0; j<nc; j++ )
+			{
+			b2[j] = b1[j];
+			b1[j] = b0[j];
+			b0[j] = x[i+j] * b1[j]  -  b2[j]  +  array[k];
+			}
+	for( j=0; j<nc; j++ )
+		b0[j] = 0.5*(b0[j]-b2[j]);
+	}
+}
@@ -31,6 +31,12 @@
  * omitted from the array.  Its calling arguments are
  * otherwise the same as polevl().
  *
+ * polevl_batch( n, x, coef, N, y ) and p1evl_batch() set y[i],
+ * i < n, to the polynomial at x[i].  The terms are accumulated
+ * coefficient by coefficient over the whole vector, which lets
+ * the compiler evaluate several elements at once; the results
+ * are those of polevl() and p1evl().  y[] must not overlap x[].
+ *
  *
  * SPEED:
  *
@@ -95,3 +101,40 @@ while( --i );
 
 return( ans );
 }
+
+
+/*							polevl_batch()	*/
+
+void torch_cephes_polevl_batch( n, x, coef, N, y )
+int n;
+double x[];
+double coef[];
+int N;
+double y[];
+{
+int i, k;
+
+for( i=0; i<n; i++ )
+	y[i] = coef[0];
+for( k=1; k<=N; k++ )
+	for( i=0; i<n; i++ )
+		y[i] = y[i] * x[i]  +  coef[k];
+}
+
+/*							p1evl_batch()	*/
+
+void torch_cephes_p1evl_batch( n, x, coef, N, y )
+int n;
+double x[];
+double coef[];
+int N;
+double y[];
+{
+int i, k;
+
+for( i=0; i<n; i++ )
+	y[i] = x[i] + coef[0];
+for( k=1; k<N; k++ )
+	for( i=0; i<n; i++ )
+		y[i] = y[i] * x[i]  +  coef[k];
+}
@@ -153,11 +153,19 @@ extern double torch_cephes_incbi ( double, double, double );
 extern double torch_cephes_pow ( double, double );
 extern double torch_cephes_log1p ( double );
 extern double torch_cephes_expm1 ( double );
+extern void torch_cephes_incbetv ( int, double *, int, double *, int,
+				   double *, double * );
+static void bdtrbatch ( char *, int, double *, int, double *, int,
+			double *, int, int, double * );
 #else
 double torch_cephes_incbet(), torch_cephes_incbi(), torch_cephes_pow(),
     torch_cephes_log1p(), torch_cephes_expm1();
+void torch_cephes_incbetv();
+static void bdtrbatch();
 #endif
 
+#define CHUNK 256
+
 double torch_cephes_bdtrc( k, n, p )
 int k, n;
 double p;
@@ -262,3 +270,107 @@ else
 	}
 return( p );
 }
+
+
+
+/*							bdtr_batch()
+ *
+ * bdtr_batch( n, k, sk, nn, snn, p, sp, y );
+ * bdtrc_batch( n, k, sk, nn, snn, p, sp, y );
+ *
+ * Set y[i] to bdtr() or bdtrc() of ( k[i*sk], nn[i*snn], p[i*sp] ),
+ * k and nn being truncated to integers.  A stride of 0 broadcasts
+ * the first value.  The incomplete beta integrals of each chunk are
+ * evaluated together by incbetv().
+ */
+
+static void bdtrbatch( name, n, k, sk, nn, snn, p, sp, comp, y )
+char *name;
+int n, sk, snn, sp, comp;
+double *k, *nn, *p, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double av[CHUNK], bv[CHUNK], xv[CHUNK], sv[CHUNK];
+	int isp[CHUNK];
+	double pj, dn;
+	int j, nc, kj, nj;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	for( j=0; j<nc; j++ )
+		{
+		kj = (int) k[(i+j)*sk];
+		nj = (int) nn[(i+j)*snn];
+		pj = p[(i+j)*sp];
+		/* placeholder argument, result replaced below */
+		av[j] = 1.0;
+		bv[j] = 1.0;
+		xv[j] = 0.0;
+		isp[j] = 1;
+		/* in the order of the checks of bdtrc() */
+		if( comp && kj < 0 && !((pj < 0.0) || (pj > 1.0)) )
+			{
+			sv[j] = 1.0;
+			continue;
+			}
+		if( (pj < 0.0) || (pj > 1.0) || (kj < 0) || (nj < kj) )
+			{
+			torch_cephes_mtherr( name, DOMAIN );
+			sv[j] = 0.0;
+			continue;
+			}
+		if( kj == nj )
+			{
+			sv[j] = comp ? 0.0 : 1.0;
+			continue;
+			}
+		dn = nj - kj;
+		if( kj == 0 )
+			{
+			if( !comp )
+				sv[j] = torch_cephes_pow( 1.0-pj, dn );
+			else if( pj < .01 )
+				sv[j] = -torch_cephes_expm1( dn * torch_cephes_log1p(-pj) );
+			else
+				sv[j] = 1.0 - torch_cephes_pow( 1.0-pj, dn );
+			continue;
+			}
+		isp[j] = 0;
+		if( comp )
+			{
+			av[j] = kj + 1;
+			bv[j] = dn;
+			xv[j] = pj;
+			}
+		else
+			{
+			av[j] = dn;
+			bv[j] = kj + 1;
+			xv[j] = 1.0 - pj;
+			}
+		}
+	torch_cephes_incbetv( nc, av, 1, bv, 1, xv, y + i );
+	for( j=0; j<nc; j++ )
+		if( isp[j] )
+			y[i+j] = sv[j];
+	}
+}
+
+
+void torch_cephes_bdtr_batch( n, k, sk, nn, snn, p, sp, y )
+int n, sk, snn, sp;
+double *k, *nn, *p, *y;
+{
+bdtrbatch( "bdtr", n, k, sk, nn, snn, p, sp, 0, y );
+}
+
+
+void torch_cephes_bdtrc_batch( n, k, sk, nn, snn, p, sp, y )
+int n, sk, snn, sp;
+double *k, *nn, *p, *y;
+{
+bdtrbatch( "bdtrc", n, k, sk, nn, snn, p, sp, 1, y );
+}
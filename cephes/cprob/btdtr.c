@@ -52,8 +52,11 @@ Copyright 1984, 1987, 1995, 2000 by Stephen L. Moshier
 #include "mconf.h"
 #ifdef ANSIPROT
 extern double torch_cephes_incbet ( double, double, double );
+extern void torch_cephes_incbet_batch ( int, double *, int, double *, int,
+					double *, int, double * );
 #else
 double torch_cephes_incbet();
+void torch_cephes_incbet_batch();
 #endif
 
 double torch_cephes_btdtr( a, b, x )
@@ -62,3 +65,17 @@ double a, b, x;
 
 return( torch_cephes_incbet( a, b, x ) );
 }
+
+
+
+/* btdtr_batch( n, a, sa, b, sb, x, sx, y ) sets y[i] to
+ * btdtr( a[i*sa], b[i*sb], x[i*sx] ); see incbet_batch().
+ */
+
+void torch_cephes_btdtr_batch( n, a, sa, b, sb, x, sx, y )
+int n, sa, sb, sx;
+double *a, *b, *x, *y;
+{
+
+torch_cephes_incbet_batch( n, a, sa, b, sb, x, sx, y );
+}
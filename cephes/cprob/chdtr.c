@@ -152,10 +152,20 @@ Copyright 1984, 1987, 2000 by Stephen L. Moshier
 extern double torch_cephes_igamc ( double, double );
 extern double torch_cephes_igam ( double, double );
 extern double torch_cephes_igami ( double, double );
+extern double torch_cephes_lgam ( double );
+extern void torch_cephes_igamv ( int, double *, int, double *, double *, int,
+				 double * );
+static void chdtrbatch ( char *, int, double *, int, double *, int, int,
+			 double * );
 #else
 double torch_cephes_igamc(), torch_cephes_igam(), torch_cephes_igami();
+double torch_cephes_lgam();
+void torch_cephes_igamv();
+static void chdtrbatch();
 #endif
 
+#define CHUNK 256
+
 double torch_cephes_chdtrc(df,x)
 double df, x;
 {
@@ -198,3 +208,82 @@ if( (y < 0.0) || (y > 1.0) || (df < 1.0) )
 x = torch_cephes_igami( 0.5 * df, y );
 return( 2.0 * x );
 }
+
+
+
+/*							chdtr_batch()
+ *
+ * chdtr_batch( n, df, sdf, x, sx, y );
+ * chdtrc_batch( n, df, sdf, x, sx, y );
+ *
+ * Set y[i] to chdtr() or chdtrc() of ( df[i*sdf], x[i*sx] ).
+ * A stride of 0 broadcasts the first value.  With shared degrees
+ * of freedom, lgam(df/2) is computed once for the batch.
+ */
+
+static void chdtrbatch( name, n, df, sdf, x, sx, comp, y )
+char *name;
+int n, sdf, sx, comp;
+double *df, *x, *y;
+{
+double lgm;
+int i, shared;
+
+shared = (sdf == 0) && (df[0] >= 1.0);
+if( shared )
+	lgm = torch_cephes_lgam( 0.5 * df[0] );
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double av[CHUNK], xv[CHUNK];
+	int j, nc, nbad;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nbad = 0;
+	for( j=0; j<nc; j++ )
+		{
+		xv[j] = x[(i+j)*sx];
+		av[j] = df[(i+j)*sdf];
+		if( (xv[j] < 0.0) || (av[j] < 1.0) )
+			{
+			/* placeholder argument, result replaced below */
+			xv[j] = 0.0;
+			av[j] = 1.0;
+			nbad += 1;
+			}
+		else
+			{
+			xv[j] *= 0.5;
+			av[j] *= 0.5;
+			}
+		}
+	torch_cephes_igamv( nc, av, 1, shared ? &lgm : (double *)0,
+			    xv, comp, y + i );
+	if( nbad == 0 )
+		continue;
+	for( j=0; j<nc; j++ )
+		{
+		if( (x[(i+j)*sx] < 0.0) || (df[(i+j)*sdf] < 1.0) )
+			{
+			torch_cephes_mtherr( name, DOMAIN );
+			y[i+j] = 0.0;
+			}
+		}
+	}
+}
+
+
+void torch_cephes_chdtr_batch( n, df, sdf, x, sx, y )
+int n, sdf, sx;
+double *df, *x, *y;
+{
+chdtrbatch( "chdtr", n, df, sdf, x, sx, 0, y );
+}
+
+
+void torch_cephes_chdtrc_batch( n, df, sdf, x, sx, y )
+int n, sdf, sx;
+double *df, *x, *y;
+{
+chdtrbatch( "chdtrc", n, df, sdf, x, sx, 1, y );
+}
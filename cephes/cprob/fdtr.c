@@ -164,10 +164,18 @@ Copyright 1984, 1987, 1995, 2000 by Stephen L. Moshier
 #ifdef ANSIPROT
 extern double torch_cephes_incbet ( double, double, double );
 extern double torch_cephes_incbi ( double, double, double );
+extern void torch_cephes_incbetv ( int, double *, int, double *, int,
+				   double *, double * );
+static void fdtrbatch ( char *, int, double *, int, double *, int,
+			double *, int, int, double * );
 #else
 double torch_cephes_incbet(), torch_cephes_incbi();
+void torch_cephes_incbetv();
+static void fdtrbatch();
 #endif
 
+#define CHUNK 256
+
 double torch_cephes_fdtrc( ia, ib, x )
 int ia, ib;
 double x;
@@ -235,3 +243,87 @@ else
 	}
 return(x);
 }
+
+
+
+/*							fdtr_batch()
+ *
+ * fdtr_batch( n, ia, sia, ib, sib, x, sx, y );
+ * fdtrc_batch( n, ia, sia, ib, sib, x, sx, y );
+ *
+ * Set y[i] to fdtr() or fdtrc() of ( ia[i*sia], ib[i*sib], x[i*sx] ),
+ * the degrees of freedom being truncated to integers.  A stride of
+ * 0 broadcasts the first value.  The incomplete beta integrals of
+ * each chunk are evaluated together by incbetv().
+ */
+
+static void fdtrbatch( name, n, ia, sia, ib, sib, x, sx, comp, y )
+char *name;
+int n, sia, sib, sx, comp;
+double *ia, *ib, *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double av[CHUNK], bv[CHUNK], xv[CHUNK];
+	int bad[CHUNK];
+	double a, b, w;
+	int j, nc, nbad;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nbad = 0;
+	for( j=0; j<nc; j++ )
+		{
+		a = (int) ia[(i+j)*sia];
+		b = (int) ib[(i+j)*sib];
+		w = x[(i+j)*sx];
+		bad[j] = (a < 1.0) || (b < 1.0) || (w < 0.0);
+		if( bad[j] )
+			{
+			torch_cephes_mtherr( name, DOMAIN );
+			/* placeholder argument, result replaced below */
+			av[j] = 1.0;
+			bv[j] = 1.0;
+			xv[j] = 0.0;
+			nbad += 1;
+			}
+		else if( comp )
+			{
+			av[j] = 0.5*b;
+			bv[j] = 0.5*a;
+			xv[j] = b / (b + a * w);
+			}
+		else
+			{
+			w = a * w;
+			av[j] = 0.5*a;
+			bv[j] = 0.5*b;
+			xv[j] = w / (b + w);
+			}
+		}
+	torch_cephes_incbetv( nc, av, 1, bv, 1, xv, y + i );
+	if( nbad == 0 )
+		continue;
+	for( j=0; j<nc; j++ )
+		if( bad[j] )
+			y[i+j] = 0.0;
+	}
+}
+
+
+void torch_cephes_fdtr_batch( n, ia, sia, ib, sib, x, sx, y )
+int n, sia, sib, sx;
+double *ia, *ib, *x, *y;
+{
+fdtrbatch( "fdtr", n, ia, sia, ib, sib, x, sx, 0, y );
+}
+
+
+void torch_cephes_fdtrc_batch( n, ia, sia, ib, sib, x, sx, y )
+int n, sia, sib, sx;
+double *ia, *ib, *x, *y;
+{
+fdtrbatch( "fdtrc", n, ia, sia, ib, sib, x, sx, 1, y );
+}
@@ -99,10 +99,19 @@ Copyright 1984, 1987, 1995, 2000 by Stephen L. Moshier
 #ifdef ANSIPROT
 extern double torch_cephes_igam ( double, double );
 extern double torch_cephes_igamc ( double, double );
+extern double torch_cephes_lgam ( double );
+extern void torch_cephes_igamv ( int, double *, int, double *, double *, int,
+				 double * );
+static void gdtrbatch ( char *, int, double *, int, double *, int,
+			double *, int, int, double * );
 #else
-double torch_cephes_igam(), torch_cephes_igamc();
+double torch_cephes_igam(), torch_cephes_igamc(), torch_cephes_lgam();
+void torch_cephes_igamv();
+static void gdtrbatch();
 #endif
 
+#define CHUNK 256
+
 double torch_cephes_gdtr( a, b, x )
 double a, b, x;
 {
@@ -128,3 +137,79 @@ if( x < 0.0 )
 	}
 return(  torch_cephes_igamc( b, a * x )  );
 }
+
+
+
+/*							gdtr_batch()
+ *
+ * gdtr_batch( n, a, sa, b, sb, x, sx, y );
+ * gdtrc_batch( n, a, sa, b, sb, x, sx, y );
+ *
+ * Set y[i] to gdtr() or gdtrc() of ( a[i*sa], b[i*sb], x[i*sx] ).
+ * A stride of 0 broadcasts the first value.  With a shared shape b,
+ * lgam(b) is computed once for the batch; see igamv().
+ */
+
+static void gdtrbatch( name, n, a, sa, b, sb, x, sx, comp, y )
+char *name;
+int n, sa, sb, sx, comp;
+double *a, *b, *x, *y;
+{
+double lgm;
+int i, shared;
+
+shared = (sb == 0) && (b[0] > 0.0);
+if( shared )
+	lgm = torch_cephes_lgam( b[0] );
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double bv[CHUNK], xv[CHUNK];
+	int j, nc, nbad;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nbad = 0;
+	for( j=0; j<nc; j++ )
+		{
+		xv[j] = x[(i+j)*sx];
+		bv[j] = b[(i+j)*sb];
+		if( xv[j] < 0.0 )
+			{
+			/* placeholder argument, result replaced below */
+			xv[j] = 0.0;
+			bv[j] = 1.0;
+			nbad += 1;
+			}
+		else
+			xv[j] *= a[(i+j)*sa];
+		}
+	torch_cephes_igamv( nc, bv, 1, shared ? &lgm : (double *)0,
+			    xv, comp, y + i );
+	if( nbad == 0 )
+		continue;
+	for( j=0; j<nc; j++ )
+		{
+		if( x[(i+j)*sx] < 0.0 )
+			{
+			torch_cephes_mtherr( name, DOMAIN );
+			y[i+j] = 0.0;
+			}
+		}
+	}
+}
+
+
+void torch_cephes_gdtr_batch( n, a, sa, b, sb, x, sx, y )
+int n, sa, sb, sx;
+double *a, *b, *x, *y;
+{
+gdtrbatch( "gdtr", n, a, sa, b, sb, x, sx, 0, y );
+}
+
+
+void torch_cephes_gdtrc_batch( n, a, sa, b, sb, x, sx, y )
+int n, sa, sb, sx;
+double *a, *b, *x, *y;
+{
+gdtrbatch( "gdtrc", n, a, sa, b, sb, x, sx, 1, y );
+}
@@ -83,6 +83,7 @@ Copyright 1985, 1987, 2000 by Stephen L. Moshier
 */
 
 #include "mconf.h"
+#include "../torch_profile.h"
 #ifdef ANSIPROT
 extern double torch_cephes_lgam ( double );
 extern double torch_cephes_exp ( double );
@@ -90,12 +91,26 @@ extern double torch_cephes_log ( double );
 extern double torch_cephes_fabs ( double );
 extern double torch_cephes_igam ( double, double );
 extern double torch_cephes_igamc ( double, double );
+void torch_cephes_igamv ( int, double *, int, double *, double *, int,
+			  double * );
+static void igamser ( int, int *, double *, int, double *, double * );
+static void igamcf ( int, int *, double *, int, double *, double * );
+extern double torch_cephes_psi ( double );
+static void igamgr ( double, double, int, double *, double *, double *,
+		     double * );
+static void igamgrad ( int, double *, int, double *, int, int, double *,
+		       double *, double * );
 #else
 double torch_cephes_lgam(), torch_cephes_exp(), torch_cephes_log(),
     torch_cephes_fabs(), torch_cephes_igam(), torch_cephes_igamc();
+void torch_cephes_igamv();
+static void igamser(), igamcf();
+double torch_cephes_psi();
+static void igamgr(), igamgrad();
 #endif
 
-extern double torch_cephes_MACHEP, torch_cephes_MAXLOG, torch_cephes_NAN;
+extern double torch_cephes_MACHEP, torch_cephes_MAXLOG, torch_cephes_MAXNUM;
+extern double torch_cephes_NAN;
 static double big = 4.503599627370496e15;
 static double biginv =  2.22044604925031308085e-16;
 
@@ -108,6 +123,7 @@ double pk, pkm1, pkm2, qk, qkm1, qkm2;
 if( (x < 0) || ( a <= 0) )
     {
     torch_cephes_mtherr("igamc", DOMAIN);
+    PROFILE( PROF_IGAM, 2, 0 );
 	return( torch_cephes_NAN );
     }
 
@@ -118,6 +134,7 @@ ax = a * torch_cephes_log(x) - x - torch_cephes_lgam(a);
 if( ax < -torch_cephes_MAXLOG )
 	{
 	torch_cephes_mtherr( "igamc", UNDERFLOW );
+	PROFILE( PROF_IGAM, 2, 0 );
 	return( 0.0 );
 	}
 ax = torch_cephes_exp(ax);
@@ -161,6 +178,7 @@ do
 		}
 	}
 while( t > torch_cephes_MACHEP );
+PROFILE( PROF_IGAM, 1, (int) c );
 
 return( ans * ax );
 }
@@ -189,6 +207,7 @@ if( x == 0 )
 if( (x < 0) || ( a <= 0) )
     {
     torch_cephes_mtherr("igam", DOMAIN);
+    PROFILE( PROF_IGAM, 2, 0 );
 	return( torch_cephes_NAN );
     }
 
@@ -200,6 +219,7 @@ ax = a * torch_cephes_log(x) - x - torch_cephes_lgam(a);
 if( ax < -torch_cephes_MAXLOG )
 	{
 	torch_cephes_mtherr( "igam", UNDERFLOW );
+	PROFILE( PROF_IGAM, 2, 0 );
 	return( 0.0 );
 	}
 ax = torch_cephes_exp(ax);
@@ -216,6 +236,554 @@ do
 	ans += c;
 	}
 while( c/ans > torch_cephes_MACHEP );
+PROFILE( PROF_IGAM, 0, (int) (r - a) );
 
 return( ans * ax/a );
 }
+
+
+
+
+/*							igamv()
+ *
+ *	Incomplete gamma integrals of a vector
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sa, comp;
+ * double a[], lgm, x[n], y[n];
+ *
+ * igamv( n, a, sa, &lgm, x, comp, y );
+ *
+ * igam_batch( n, a, sa, x, sx, y );
+ * igamc_batch( n, a, sa, x, sx, y );
+ *
+ *
+ * DESCRIPTION:
+ *
+ * igamv() sets y[i] to igam( a[i*sa], x[i] ), or to igamc() if
+ * comp is nonzero.  When every element has the same parameter a,
+ * as with sa = 0, the caller may pass lgam(a) in lgm to skip its
+ * evaluation; otherwise lgm is NULL.
+ *
+ * The elements are sorted into those summed by the power series
+ * and those evaluated by the continued fraction.  Each expansion
+ * then runs on LANES elements at a time with branch-free lane
+ * arithmetic, a lane being masked off when its own iteration has
+ * converged, until all the lanes of the group have converged.
+ *
+ * igam_batch() and igamc_batch() evaluate n elements whose
+ * parameters have strides sa and sx (0 to broadcast a single value),
+ * in parallel chunks.  They compute lgam(a) once when a is shared.
+ *
+ * The results and error messages are those of igam() and igamc().
+ */
+
+#define LANES 8
+#define CHUNK 256
+
+/* Sum the power series of the elements idx[0..m-1], LANES at a time.
+ * On entry y[] holds the prefactor x**a exp(-x) / gamma(a+1).
+ */
+static void igamser( m, idx, a, sa, x, y )
+int m, sa;
+int *idx;
+double *a, *x, *y;
+{
+double r[LANES], c[LANES], ans[LANES], lx[LANES];
+int live[LANES];
+int i, j, k, active;
+#ifdef TORCH_CEPHES_PROFILE
+int it[LANES];
+#endif
+
+for( i=0; i<m; i+=LANES )
+	{
+	for( j=0; j<LANES; j++ )
+		{
+		k = idx[ i + j < m ? i + j : m - 1 ];
+		live[j] = i + j < m;
+		r[j] = a[k*sa];
+		lx[j] = x[k];
+		c[j] = 1.0;
+		ans[j] = 1.0;
+#ifdef TORCH_CEPHES_PROFILE
+		it[j] = 0;
+#endif
+		}
+	do
+		{
+		active = 0;
+		for( j=0; j<LANES; j++ )
+			{
+			r[j] += 1.0;
+			c[j] *= lx[j]/r[j];
+			ans[j] += live[j] ? c[j] : 0.0;
+#ifdef TORCH_CEPHES_PROFILE
+			it[j] += live[j];
+#endif
+			live[j] = live[j] & (c[j]/ans[j] > torch_cephes_MACHEP);
+			active |= live[j];
+			}
+		}
+	while( active );
+	for( j=0; j<LANES && i+j<m; j++ )
+		{
+		PROFILE( PROF_IGAM, 0, it[j] );
+		y[idx[i+j]] *= ans[j];
+		}
+	}
+}
+
+
+/* Evaluate the continued fraction of the elements idx[0..m-1],
+ * LANES at a time.  On entry y[] holds x**a exp(-x) / gamma(a).
+ */
+static void igamcf( m, idx, a, sa, x, y )
+int m, sa;
+int *idx;
+double *a, *x, *y;
+{
+double yy[LANES], z[LANES], c[LANES], ans[LANES];
+double pkm1[LANES], pkm2[LANES], qkm1[LANES], qkm2[LANES];
+int live[LANES];
+double pk, qk, yc, r, t, s;
+int i, j, k, active;
+#ifdef TORCH_CEPHES_PROFILE
+int it[LANES];
+#endif
+
+for( i=0; i<m; i+=LANES )
+	{
+	for( j=0; j<LANES; j++ )
+		{
+		k = idx[ i + j < m ? i + j : m - 1 ];
+		live[j] = i + j < m;
+		yy[j] = 1.0 - a[k*sa];
+		z[j] = x[k] + yy[j] + 1.0;
+		c[j] = 0.0;
+		pkm2[j] = 1.0;
+		qkm2[j] = x[k];
+		pkm1[j] = x[k] + 1.0;
+		qkm1[j] = z[j] * x[k];
+		ans[j] = pkm1[j]/qkm1[j];
+#ifdef TORCH_CEPHES_PROFILE
+		it[j] = 0;
+#endif
+		}
+	do
+		{
+		active = 0;
+		for( j=0; j<LANES; j++ )
+			{
+			c[j] += 1.0;
+			yy[j] += 1.0;
+			z[j] += 2.0;
+			yc = yy[j] * c[j];
+			pk = pkm1[j] * z[j]  -  pkm2[j] * yc;
+			qk = qkm1[j] * z[j]  -  qkm2[j] * yc;
+			r = qk != 0.0 ? pk/qk : ans[j];
+			t = (ans[j] - r)/r;
+			t = t < 0.0 ? -t : t;
+			t = qk != 0.0 ? t : 1.0;
+			ans[j] = live[j] ? r : ans[j];
+#ifdef TORCH_CEPHES_PROFILE
+			it[j] += live[j];
+#endif
+			pkm2[j] = pkm1[j];
+			pkm1[j] = pk;
+			qkm2[j] = qkm1[j];
+			qkm1[j] = qk;
+			s = (pk > big || pk < -big) ? biginv : 1.0;
+			pkm2[j] *= s;
+			pkm1[j] *= s;
+			qkm2[j] *= s;
+			qkm1[j] *= s;
+			live[j] = live[j] & (t > torch_cephes_MACHEP);
+			active |= live[j];
+			}
+		}
+	while( active );
+	for( j=0; j<LANES && i+j<m; j++ )
+		{
+		PROFILE( PROF_IGAM, 1, it[j] );
+		y[idx[i+j]] *= ans[j];
+		}
+	}
+}
+
+
+void torch_cephes_igamv( n, a, sa, lgm, x, comp, y )
+int n, sa, comp;
+double *a, *lgm, *x, *y;
+{
+int sidx[CHUNK], cidx[CHUNK];
+double ai, xi, ax;
+int i, i0, nc, ns, ncf, cf;
+
+for( i0=0; i0<n; i0+=CHUNK )
+	{
+	nc = n - i0 < CHUNK ? n - i0 : CHUNK;
+	ns = 0;
+	ncf = 0;
+	for( i=i0; i<i0+nc; i++ )
+		{
+		ai = a[i*sa];
+		xi = x[i];
+		if( xi == 0.0 && !(ai <= 0.0 && comp) )
+			{
+			/* zero integration limit */
+			y[i] = comp ? 1.0 : 0.0;
+			continue;
+			}
+		if( (xi < 0) || (ai <= 0) )
+			{
+			torch_cephes_mtherr( comp ? "igamc" : "igam", DOMAIN );
+			PROFILE( PROF_IGAM, 2, 0 );
+			y[i] = torch_cephes_NAN;
+			continue;
+			}
+		if( comp )
+			cf = !( (xi < 1.0) || (xi < ai) );
+		else
+			cf = (xi > 1.0) && (xi > ai);
+		/* x**a * exp(-x) / gamma(a) */
+		ax = ai * torch_cephes_log(xi) - xi - (lgm ? *lgm : torch_cephes_lgam(ai));
+		if( ax < -torch_cephes_MAXLOG )
+			{
+			torch_cephes_mtherr( cf ? "igamc" : "igam", UNDERFLOW );
+			PROFILE( PROF_IGAM, 2, 0 );
+			y[i] = (cf == comp) ? 0.0 : 1.0;
+			continue;
+			}
+		if( cf )
+			{
+			y[i] = torch_cephes_exp(ax);
+			cidx[ncf++] = i;
+			}
+		else
+			{
+			y[i] = torch_cephes_exp(ax) / ai;
+			sidx[ns++] = i;
+			}
+		}
+
+	igamser( ns, sidx, a, sa, x, y );
+	igamcf( ncf, cidx, a, sa, x, y );
+
+	/* complement the lanes whose expansion was for the other tail */
+	if( comp )
+		for( i=0; i<ns; i++ )
+			y[sidx[i]] = 1.0 - y[sidx[i]];
+	else
+		for( i=0; i<ncf; i++ )
+			y[cidx[i]] = 1.0 - y[cidx[i]];
+	}
+}
+
+
+/* Chunks of the batch, with lgam(a) hoisted when a is shared */
+static void igambatch( n, a, sa, x, sx, comp, y )
+int n, sa, sx, comp;
+double *a, *x, *y;
+{
+double lgm;
+int i, shared;
+
+shared = (sa == 0) && (a[0] > 0.0);
+if( shared )
+	lgm = torch_cephes_lgam( a[0] );
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double xv[CHUNK];
+	int j, nc;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	for( j=0; j<nc; j++ )
+		xv[j] = x[(i+j)*sx];
+	torch_cephes_igamv( nc, a + i*sa, sa, shared ? &lgm : (double *)0,
+			    xv, comp, y + i );
+	}
+}
+
+
+void torch_cephes_igam_batch( n, a, sa, x, sx, y )
+int n, sa, sx;
+double *a, *x, *y;
+{
+igambatch( n, a, sa, x, sx, 0, y );
+}
+
+
+void torch_cephes_igamc_batch( n, a, sa, x, sx, y )
+int n, sa, sx;
+double *a, *x, *y;
+{
+igambatch( n, a, sa, x, sx, 1, y );
+}
+
+
+
+/*							igam_grad()
+ *
+ *	Incomplete gamma integrals and their derivatives
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sa, sx;
+ * double a[], x[], y[n], da[n], dx[n];
+ *
+ * igam_grad( n, a, sa, x, sx, y, da, dx );
+ * igamc_grad( n, a, sa, x, sx, y, da, dx );
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to igam( a[i*sa], x[i*sx] ), or igamc(), and da[i], dx[i]
+ * to its partial derivatives with respect to a and x.
+ *
+ * The derivative in x is the integrand
+ *
+ *                        a-1  -x    -
+ *   d/dx igam(a,x)  =   x    e   / | (a),
+ *
+ * which is the prefactor of both expansions divided by x.  The
+ * derivative in a is carried along the power series, whose terms
+ * c  = x**k / ((a+1)...(a+k)) have the derivatives
+ *  k
+ *   dc  = (x dc    - c ) / (a+k),
+ *     k        k-1    k
+ *
+ * and along the numerator and denominator recurrences of the
+ * continued fraction, whose coefficients are linear in a.  The
+ * prefactor contributes log(x) - psi(a).  lgam(a) and psi(a) are
+ * evaluated once when a is shared.
+ *
+ * The values are those of igam() and igamc().  The derivatives
+ * have relative errors of a few times those of the values, except
+ * near the zeros of d/da.
+ */
+
+/* Value and derivatives of igam( a, x ), or igamc() if comp is
+ * nonzero.  If lp is not null, it holds lgam(a) and psi(a).
+ */
+static void igamgr( a, x, comp, lp, y, da, dx )
+double a, x;
+int comp;
+double *lp, *y, *da, *dx;
+{
+double ans, dans, ax, lx, lga, psa, c, dc, r, dr, t, u, w, yc, z, val;
+double pk, pkm1, pkm2, qk, qkm1, qkm2;
+double dpk, dpkm1, dpkm2, dqk, dqkm1, dqkm2;
+int cf;
+
+/* zero integration limit first, as in igam(); igamc() checks
+ * its domain first */
+if( x == 0 && !(a <= 0 && comp) )
+	{
+	*y = comp ? 1.0 : 0.0;
+	*da = 0.0;
+	/* the integrand at 0 */
+	if( a > 1.0 )
+		*dx = 0.0;
+	else if( a == 1.0 )
+		*dx = comp ? -1.0 : 1.0;
+	else
+		*dx = comp ? -torch_cephes_MAXNUM : torch_cephes_MAXNUM;
+	return;
+	}
+if( (x < 0) || ( a <= 0) )
+	{
+	torch_cephes_mtherr( comp ? "igamc" : "igam", DOMAIN );
+	*y = torch_cephes_NAN;
+	*da = torch_cephes_NAN;
+	*dx = torch_cephes_NAN;
+	return;
+	}
+
+if( comp )
+	cf = !( (x < 1.0) || (x < a) );
+else
+	cf = (x > 1.0) && (x > a);
+
+if( lp )
+	{
+	lga = lp[0];
+	psa = lp[1];
+	}
+else
+	{
+	lga = torch_cephes_lgam(a);
+	psa = torch_cephes_psi(a);
+	}
+lx = torch_cephes_log(x);
+ax = a * lx - x - lga;
+if( ax < -torch_cephes_MAXLOG )
+	{
+	/* under the name of the scalar function that underflows */
+	torch_cephes_mtherr( cf ? "igamc" : "igam", UNDERFLOW );
+	*y = (cf == comp) ? 0.0 : 1.0;
+	*da = 0.0;
+	*dx = 0.0;
+	return;
+	}
+ax = torch_cephes_exp(ax);
+*dx = comp ? -ax / x : ax / x;
+
+if( !cf )
+	{
+	/* power series */
+	r = a;
+	c = 1.0;
+	dc = 0.0;
+	ans = 1.0;
+	dans = 0.0;
+	do
+		{
+		r += 1.0;
+		c *= x/r;
+		dc = (dc * x/r) - c/r;
+		ans += c;
+		dans += dc;
+		}
+	while( c/ans > torch_cephes_MACHEP );
+	t = ans * ax/a;
+	u = t * (lx - psa - 1.0/a) + dans * ax/a;
+	if( comp )
+		{
+		*y = 1.0 - t;
+		*da = -u;
+		}
+	else
+		{
+		*y = t;
+		*da = u;
+		}
+	return;
+	}
+
+/* continued fraction, with the derivatives in a of its
+ * numerators and denominators
+ */
+u = 1.0 - a;
+z = x + u + 1.0;
+c = 0.0;
+pkm2 = 1.0;
+qkm2 = x;
+pkm1 = x + 1.0;
+qkm1 = z * x;
+dpkm2 = 0.0;
+dqkm2 = 0.0;
+dpkm1 = 0.0;
+dqkm1 = -x;
+ans = pkm1/qkm1;
+dans = -ans * dqkm1/qkm1;
+/* val keeps the value where igamc() stops */
+val = 0.0;
+
+do
+	{
+	c += 1.0;
+	u += 1.0;
+	z += 2.0;
+	yc = u * c;
+	pk = pkm1 * z  -  pkm2 * yc;
+	qk = qkm1 * z  -  qkm2 * yc;
+	dpk = dpkm1 * z - pkm1 - dpkm2 * yc + pkm2 * c;
+	dqk = dqkm1 * z - qkm1 - dqkm2 * yc + qkm2 * c;
+	if( qk != 0 )
+		{
+		r = pk/qk;
+		dr = (dpk - r * dqk)/qk;
+		t = torch_cephes_fabs( (ans - r)/r );
+		if( t <= torch_cephes_MACHEP && val == 0.0 )
+			val = r;
+		/* the derivative converges relative to the larger
+		 * of itself and the value
+		 */
+		w = torch_cephes_fabs(dr) > torch_cephes_fabs(r) ?
+			torch_cephes_fabs(dr) : torch_cephes_fabs(r);
+		if( torch_cephes_fabs( dans - dr ) > t * w )
+			t = torch_cephes_fabs( dans - dr ) / w;
+		ans = r;
+		dans = dr;
+		}
+	else
+		t = 1.0;
+	pkm2 = pkm1;
+	pkm1 = pk;
+	qkm2 = qkm1;
+	qkm1 = qk;
+	dpkm2 = dpkm1;
+	dpkm1 = dpk;
+	dqkm2 = dqkm1;
+	dqkm1 = dqk;
+	if( torch_cephes_fabs(pk) > big )
+		{
+		pkm2 *= biginv;
+		pkm1 *= biginv;
+		qkm2 *= biginv;
+		qkm1 *= biginv;
+		dpkm2 *= biginv;
+		dpkm1 *= biginv;
+		dqkm2 *= biginv;
+		dqkm1 *= biginv;
+		}
+	}
+while( t > torch_cephes_MACHEP && c < 2000.0 );
+
+if( val == 0.0 )
+	val = ans;
+t = val * ax;
+u = ax * (dans + ans * (lx - psa));
+if( comp )
+	{
+	*y = t;
+	*da = u;
+	}
+else
+	{
+	*y = 1.0 - t;
+	*da = -u;
+	}
+}
+
+
+
+static void igamgrad( n, a, sa, x, sx, comp, y, da, dx )
+int n, sa, sx, comp;
+double *a, *x, *y, *da, *dx;
+{
+double lp[2];
+int i, shared;
+
+shared = (sa == 0 && n > 0 && a[0] > 0.0);
+if( shared )
+	{
+	lp[0] = torch_cephes_lgam( a[0] );
+	lp[1] = torch_cephes_psi( a[0] );
+	}
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	igamgr( a[i*sa], x[i*sx], comp, shared ? lp : (double *)0,
+		&y[i], &da[i], &dx[i] );
+}
+
+
+void torch_cephes_igam_grad( n, a, sa, x, sx, y, da, dx )
+int n, sa, sx;
+double *a, *x, *y, *da, *dx;
+{
+igamgrad( n, a, sa, x, sx, 0, y, da, dx );
+}
+
+
+void torch_cephes_igamc_grad( n, a, sa, x, sx, y, da, dx )
+int n, sa, sx;
+double *a, *x, *y, *da, *dx;
+{
+igamgrad( n, a, sa, x, sx, 1, y, da, dx );
+}
@@ -60,15 +60,27 @@ extern double torch_cephes_fabs ( double );
 extern double torch_cephes_log ( double );
 extern double torch_cephes_sqrt ( double );
 extern double torch_cephes_lgam ( double );
+double torch_cephes_igami_lgm ( double, double, double * );
 #else
 double torch_cephes_igamc(), torch_cephes_ndtri(), torch_cephes_exp(),
     torch_cephes_fabs(), torch_cephes_log(), torch_cephes_sqrt(),
-    torch_cephes_lgam();
+    torch_cephes_lgam(), torch_cephes_igami_lgm();
 #endif
 
 double torch_cephes_igami( a, y0 )
 double a, y0;
 {
+return( torch_cephes_igami_lgm( a, y0, (double *)0 ) );
+}
+
+
+/* As igami(), but takes lgam(a) from *plgm when plgm is not NULL.
+ * Batches that share the shape parameter compute it only once.
+ */
+double torch_cephes_igami_lgm( a, y0, plgm )
+double a, y0;
+double *plgm;
+{
 double x0, x1, x, yl, yh, y, d, lgm, dithresh;
 int i, dir;
 
@@ -84,7 +96,10 @@ d = 1.0/(9.0*a);
 y = ( 1.0 - d - torch_cephes_ndtri(y0) * torch_cephes_sqrt(d) );
 x = a * y * y * y;
 
-lgm = torch_cephes_lgam(a);
+if( plgm )
+	lgm = *plgm;
+else
+	lgm = torch_cephes_lgam(a);
 
 for( i=0; i<10; i++ )
 	{
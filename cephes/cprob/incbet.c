@@ -60,6 +60,7 @@ Copyright 1984, 1995, 2000 by Stephen L. Moshier
 */
 
 #include "mconf.h"
+#include "../torch_profile.h"
 
 #ifdef DEC
 #define MAXGAM 34.84425627277176174
@@ -68,6 +69,7 @@ Copyright 1984, 1995, 2000 by Stephen L. Moshier
 #endif
 
 extern double torch_cephes_MACHEP, torch_cephes_MINLOG, torch_cephes_MAXLOG;
+extern double torch_cephes_MAXNUM;
 #ifdef ANSIPROT
 extern double torch_cephes_gamma ( double );
 extern double torch_cephes_lgam ( double );
@@ -78,10 +80,26 @@ extern double torch_cephes_fabs ( double );
 static double incbcf(double, double, double);
 static double incbd(double, double, double);
 static double pseries(double, double, double);
+void torch_cephes_incbetv ( int, double *, int, double *, int, double *,
+			    double * );
+static void pseriesv ( int, int *, double *, double *, double *, double * );
+static void incbcfv ( int, int *, double *, double *, double *, int,
+		      double * );
+extern double torch_cephes_psi ( double );
+extern double torch_cephes_log1p ( double );
+static double pseriesgr ( double, double, double, double * );
+static double cfgr ( double, double, double, int, double * );
+static void incbgr ( double, double, double, double *, double *, double *,
+		     double *, double * );
 #else
 double torch_cephes_gamma(), torch_cephes_lgam(), torch_cephes_exp(),
     torch_cephes_log(), torch_cephes_pow(), torch_cephes_fabs();
 static double incbcf(), incbd(), pseries();
+void torch_cephes_incbetv();
+static void pseriesv(), incbcfv();
+double torch_cephes_psi(), torch_cephes_log1p();
+static double pseriesgr(), cfgr();
+static void incbgr();
 #endif
 
 static double big = 4.503599627370496e15;
@@ -105,6 +123,7 @@ if( (xx <= 0.0) || ( xx >= 1.0) )
 		return( 1.0 );
 domerr:
 	torch_cephes_mtherr( "incbet", DOMAIN );
+	PROFILE( PROF_INCBET, 4, 0 );
 	return( 0.0 );
 	}
 
@@ -176,6 +195,7 @@ done:
 
 if( flag == 1 )
 	{
+	PROFILE( PROF_INCBET, 3, 0 );
 	if( t <= torch_cephes_MACHEP )
 		t = 1.0 - torch_cephes_MACHEP;
 	else
@@ -271,8 +291,11 @@ do
 		}
 	}
 while( ++n < 300 );
+PROFILE( PROF_INCBET, 4, n );
+return(ans);
 
 cdone:
+PROFILE( PROF_INCBET, 1, n + 1 );
 return(ans);
 }
 
@@ -330,7 +353,7 @@ do
 		r = pk/qk;
 	if( r != 0 )
 		{
-		t = fabs( (ans - r)/r );
+		t = torch_cephes_fabs( (ans - r)/r );
 		ans = r;
 		}
 	else
@@ -365,7 +388,10 @@ do
 		}
 	}
 while( ++n < 300 );
+PROFILE( PROF_INCBET, 4, n );
+return(ans);
 cdone:
+PROFILE( PROF_INCBET, 2, n + 1 );
 return(ans);
 }
 
@@ -385,7 +411,7 @@ t = u;
 n = 2.0;
 s = 0.0;
 z = torch_cephes_MACHEP * ai;
-while( fabs(v) > z )
+while( torch_cephes_fabs(v) > z )
 	{
 	u = (n - b) * x / n;
 	t *= u;
@@ -393,6 +419,7 @@ while( fabs(v) > z )
 	s += v; 
 	n += 1.0;
 	}
+PROFILE( PROF_INCBET, 0, (int) n - 2 );
 s += t1;
 s += ai;
 
@@ -414,3 +441,870 @@ else
 	}
 return(s);
 }
+
+
+
+/*							incbetv()
+ *
+ *	Incomplete beta integral of a vector
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sa, sb, sx;
+ * double a[], b[], x[n], y[n];
+ *
+ * incbetv( n, a, sa, b, sb, x, y );
+ *
+ * incbet_batch( n, a, sa, b, sb, x, sx, y );
+ *
+ *
+ * DESCRIPTION:
+ *
+ * incbetv() sets y[i] to incbet( a[i*sa], b[i*sb], x[i] ).
+ * A stride of 0 broadcasts the first parameter to every element.
+ *
+ * Each element is first assigned the expansion incbet() would use:
+ * the power series, or continued fraction #1 or #2, with a and b
+ * exchanged when x is above the mean.  The elements of each
+ * expansion are then iterated LANES at a time with branch-free
+ * lane arithmetic and a per-lane convergence mask.  The gamma
+ * function normalizers of the result are computed once for each
+ * run of elements with the same (a,b), so a batch with shared
+ * parameters evaluates them once per chunk of CHUNK elements.
+ *
+ * incbet_batch() evaluates n elements whose parameters have
+ * strides sa, sb and sx, in parallel chunks.
+ *
+ * The results and error messages are those of incbet().
+ */
+
+#define LANES 8
+#define CHUNK 256
+
+/* Power series of the elements idx[0..m-1]: s[] receives the sum,
+ * to be multiplied by x**a / B(a,b).
+ */
+static void pseriesv( m, idx, a, b, x, s )
+int m;
+int *idx;
+double *a, *b, *x, *s;
+{
+double ai[LANES], la[LANES], lb[LANES], lx[LANES];
+double t[LANES], v[LANES], n[LANES], z[LANES], sum[LANES], t1[LANES];
+int live[LANES];
+double u;
+int i, j, k, active;
+#ifdef TORCH_CEPHES_PROFILE
+int it[LANES];
+#endif
+
+for( i=0; i<m; i+=LANES )
+	{
+	active = 0;
+	for( j=0; j<LANES; j++ )
+		{
+		k = idx[ i + j < m ? i + j : m - 1 ];
+		la[j] = a[k];
+		lb[j] = b[k];
+		lx[j] = x[k];
+		ai[j] = 1.0 / la[j];
+		u = (1.0 - lb[j]) * lx[j];
+		v[j] = u / (la[j] + 1.0);
+		t1[j] = v[j];
+		t[j] = u;
+		n[j] = 2.0;
+		sum[j] = 0.0;
+		z[j] = torch_cephes_MACHEP * ai[j];
+		live[j] = (i + j < m) & (torch_cephes_fabs(v[j]) > z[j]);
+		active |= live[j];
+#ifdef TORCH_CEPHES_PROFILE
+		it[j] = 0;
+#endif
+		}
+	while( active )
+		{
+		active = 0;
+		for( j=0; j<LANES; j++ )
+			{
+			u = (n[j] - lb[j]) * lx[j] / n[j];
+			t[j] *= u;
+			v[j] = t[j] / (la[j] + n[j]);
+			sum[j] += live[j] ? v[j] : 0.0;
+#ifdef TORCH_CEPHES_PROFILE
+			it[j] += live[j];
+#endif
+			n[j] += 1.0;
+			u = v[j] < 0.0 ? -v[j] : v[j];
+			live[j] = live[j] & (u > z[j]);
+			active |= live[j];
+			}
+		}
+	for( j=0; j<LANES && i+j<m; j++ )
+		{
+		PROFILE( PROF_INCBET, 0, it[j] );
+		s[idx[i+j]] = sum[j] + t1[j] + ai[j];
+		}
+	}
+}
+
+
+/* Continued fraction #1 (sg = 1) or #2 (sg = -1) of the elements
+ * idx[0..m-1], into w[].
+ */
+static void incbcfv( m, idx, a, b, x, sg, w )
+int m, sg;
+int *idx;
+double *a, *b, *x, *w;
+{
+double k1[LANES], k2[LANES], k3[LANES], k4[LANES];
+double k5[LANES], k6[LANES], k7[LANES], k8[LANES];
+double pkm1[LANES], pkm2[LANES], qkm1[LANES], qkm2[LANES];
+double xz[LANES], r[LANES], ans[LANES];
+int live[LANES];
+double xk, pk, qk, t, s, ap, aq, thresh;
+int i, j, k, nit, active;
+#ifdef TORCH_CEPHES_PROFILE
+int it[LANES];
+#endif
+
+thresh = 3.0 * torch_cephes_MACHEP;
+for( i=0; i<m; i+=LANES )
+	{
+	for( j=0; j<LANES; j++ )
+		{
+		k = idx[ i + j < m ? i + j : m - 1 ];
+		live[j] = i + j < m;
+		k1[j] = a[k];
+		k3[j] = a[k];
+		k4[j] = a[k] + 1.0;
+		k5[j] = 1.0;
+		k7[j] = a[k] + 1.0;
+		k8[j] = a[k] + 2.0;
+		if( sg > 0 )
+			{
+			k2[j] = a[k] + b[k];
+			k6[j] = b[k] - 1.0;
+			xz[j] = x[k];
+			}
+		else
+			{
+			k2[j] = b[k] - 1.0;
+			k6[j] = a[k] + b[k];
+			xz[j] = x[k] / (1.0 - x[k]);
+			}
+		pkm2[j] = 0.0;
+		qkm2[j] = 1.0;
+		pkm1[j] = 1.0;
+		qkm1[j] = 1.0;
+		ans[j] = 1.0;
+		r[j] = 1.0;
+#ifdef TORCH_CEPHES_PROFILE
+		it[j] = 0;
+#endif
+		}
+	nit = 0;
+	do
+		{
+		active = 0;
+		for( j=0; j<LANES; j++ )
+			{
+			xk = -( xz[j] * k1[j] * k2[j] )/( k3[j] * k4[j] );
+			pk = pkm1[j] +  pkm2[j] * xk;
+			qk = qkm1[j] +  qkm2[j] * xk;
+			pkm2[j] = pkm1[j];
+			pkm1[j] = pk;
+			qkm2[j] = qkm1[j];
+			qkm1[j] = qk;
+
+			xk = ( xz[j] * k5[j] * k6[j] )/( k7[j] * k8[j] );
+			pk = pkm1[j] +  pkm2[j] * xk;
+			qk = qkm1[j] +  qkm2[j] * xk;
+			pkm2[j] = pkm1[j];
+			pkm1[j] = pk;
+			qkm2[j] = qkm1[j];
+			qkm1[j] = qk;
+
+			r[j] = qk != 0.0 ? pk/qk : r[j];
+			t = (ans[j] - r[j])/r[j];
+			t = t < 0.0 ? -t : t;
+			t = r[j] != 0.0 ? t : 1.0;
+			ans[j] = (live[j] & (r[j] != 0.0)) ? r[j] : ans[j];
+#ifdef TORCH_CEPHES_PROFILE
+			it[j] += live[j];
+#endif
+			live[j] = live[j] & (t >= thresh);
+			active |= live[j];
+
+			k1[j] += 1.0;
+			k2[j] += sg;
+			k3[j] += 2.0;
+			k4[j] += 2.0;
+			k5[j] += 1.0;
+			k6[j] -= sg;
+			k7[j] += 2.0;
+			k8[j] += 2.0;
+
+			ap = pk < 0.0 ? -pk : pk;
+			aq = qk < 0.0 ? -qk : qk;
+			s = (aq + ap) > big ? biginv : 1.0;
+			s *= (aq < biginv || ap < biginv) ? big : 1.0;
+			pkm2[j] *= s;
+			pkm1[j] *= s;
+			qkm2[j] *= s;
+			qkm1[j] *= s;
+			}
+		}
+	while( active && ++nit < 300 );
+	for( j=0; j<LANES && i+j<m; j++ )
+		{
+		if( live[j] )
+			PROFILE( PROF_INCBET, 4, it[j] );
+		else
+			PROFILE( PROF_INCBET, sg > 0 ? 1 : 2, it[j] );
+		w[idx[i+j]] = ans[j];
+		}
+	}
+}
+
+
+void torch_cephes_incbetv( n, aa, sa, bb, sb, xx, y )
+int n, sa, sb;
+double *aa, *bb, *xx, *y;
+{
+double a[CHUNK], b[CHUNK], x[CHUNK], xc[CHUNK];
+int flag[CHUNK], ser[CHUNK], sidx[CHUNK], c1idx[CHUNK], c2idx[CHUNK];
+double ai, bi, xi, t, u, w, yy, la, lb;
+double ca, cb, cg, clab, cla, clb;
+int i, j, i0, nc, ns, nc1, nc2, have;
+
+have = -1;
+ca = cb = cg = clab = cla = clb = 0.0;
+t = 0.0;
+for( i0=0; i0<n; i0+=CHUNK )
+	{
+	nc = n - i0 < CHUNK ? n - i0 : CHUNK;
+	ns = 0;
+	nc1 = 0;
+	nc2 = 0;
+	for( j=0; j<nc; j++ )
+		{
+		i = i0 + j;
+		ai = aa[i*sa];
+		bi = bb[i*sb];
+		xi = xx[i];
+		flag[j] = -1;
+		if( ai <= 0.0 || bi <= 0.0 || xi < 0.0 || xi > 1.0 )
+			{
+			torch_cephes_mtherr( "incbet", DOMAIN );
+			PROFILE( PROF_INCBET, 4, 0 );
+			y[i] = 0.0;
+			continue;
+			}
+		if( xi == 0.0 || xi == 1.0 )
+			{
+			y[i] = xi;
+			continue;
+			}
+		if( (bi * xi) <= 1.0 && xi <= 0.95 )
+			{
+			flag[j] = 0;
+			a[j] = ai;
+			b[j] = bi;
+			x[j] = xi;
+			ser[j] = 1;
+			sidx[ns++] = j;
+			continue;
+			}
+		/* Reverse a and b if x is greater than the mean. */
+		if( xi > (ai/(ai+bi)) )
+			{
+			flag[j] = 1;
+			a[j] = bi;
+			b[j] = ai;
+			xc[j] = xi;
+			x[j] = 1.0 - xi;
+			}
+		else
+			{
+			flag[j] = 0;
+			a[j] = ai;
+			b[j] = bi;
+			xc[j] = 1.0 - xi;
+			x[j] = xi;
+			}
+		ser[j] = flag[j] == 1 && (b[j] * x[j]) <= 1.0 && x[j] <= 0.95;
+		if( ser[j] )
+			{
+			sidx[ns++] = j;
+			continue;
+			}
+		/* Choose expansion for better convergence. */
+		yy = x[j] * (a[j]+b[j]-2.0) - (a[j]-1.0);
+		if( yy < 0.0 )
+			c1idx[nc1++] = j;
+		else
+			c2idx[nc2++] = j;
+		}
+
+	pseriesv( ns, sidx, a, b, x, y + i0 );
+	incbcfv( nc1, c1idx, a, b, x, 1, y + i0 );
+	incbcfv( nc2, c2idx, a, b, x, -1, y + i0 );
+	for( i=0; i<nc2; i++ )
+		y[i0 + c2idx[i]] /= xc[c2idx[i]];
+
+	for( j=0; j<nc; j++ )
+		{
+		if( flag[j] < 0 )
+			continue;
+		i = i0 + j;
+		/* gamma(a+b) / (gamma(a) gamma(b)), and the logarithms
+		 * of the gamma functions, once per run of equal parameters
+		 */
+		if( !((a[j] == ca && b[j] == cb) || (a[j] == cb && b[j] == ca)) )
+			{
+			ca = a[j];
+			cb = b[j];
+			have = 0;
+			}
+		if( (a[j]+b[j]) < MAXGAM && !(have & 1) )
+			{
+			cg = torch_cephes_gamma(a[j]+b[j]) /
+				(torch_cephes_gamma(a[j]) * torch_cephes_gamma(b[j]));
+			have |= 1;
+			}
+		w = y[i];
+		u = a[j] * torch_cephes_log(x[j]);
+		if( ser[j] )
+			{
+			/* power series */
+			if( (a[j]+b[j]) < MAXGAM && torch_cephes_fabs(u) < torch_cephes_MAXLOG )
+				{
+				t = w * cg * torch_cephes_pow(x[j],a[j]);
+				goto done;
+				}
+			}
+		else
+			{
+			t = b[j] * torch_cephes_log(xc[j]);
+			if( (a[j]+b[j]) < MAXGAM && torch_cephes_fabs(u) < torch_cephes_MAXLOG &&
+			    torch_cephes_fabs(t) < torch_cephes_MAXLOG )
+				{
+				t = torch_cephes_pow(xc[j],b[j]);
+				t *= torch_cephes_pow(x[j],a[j]);
+				t /= a[j];
+				t *= w;
+				t *= cg;
+				goto done;
+				}
+			}
+		/* Resort to logarithms.  */
+		if( !(have & 2) )
+			{
+			clab = torch_cephes_lgam(ca+cb);
+			cla = torch_cephes_lgam(ca);
+			clb = torch_cephes_lgam(cb);
+			have |= 2;
+			}
+		la = a[j] == ca ? cla : clb;
+		lb = a[j] == ca ? clb : cla;
+		if( ser[j] )
+			t = clab - la - lb + u + torch_cephes_log(w);
+		else
+			{
+			u += t + clab - la - lb;
+			t = u + torch_cephes_log(w/a[j]);
+			}
+		if( t < torch_cephes_MINLOG )
+			t = 0.0;
+		else
+			t = torch_cephes_exp(t);
+done:
+		if( flag[j] == 1 )
+			{
+			PROFILE( PROF_INCBET, 3, 0 );
+			if( t <= torch_cephes_MACHEP )
+				t = 1.0 - torch_cephes_MACHEP;
+			else
+				t = 1.0 - t;
+			}
+		y[i] = t;
+		}
+	}
+}
+
+
+void torch_cephes_incbet_batch( n, a, sa, b, sb, x, sx, y )
+int n, sa, sb, sx;
+double *a, *b, *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double xv[CHUNK];
+	int j, nc;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	for( j=0; j<nc; j++ )
+		xv[j] = x[(i+j)*sx];
+	torch_cephes_incbetv( nc, a + i*sa, sa, b + i*sb, sb, xv, y + i );
+	}
+}
+
+
+
+/*							incbet_grad()
+ *
+ *	Incomplete beta integral and its derivatives
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sa, sb, sx;
+ * double a[], b[], x[], y[n], da[n], db[n], dx[n];
+ *
+ * incbet_grad( n, a, sa, b, sb, x, sx, y, da, db, dx );
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to incbet( a[i*sa], b[i*sb], x[i*sx] ) and da[i], db[i],
+ * dx[i] to its partial derivatives with respect to a, b and x.
+ *
+ * The derivative in x is the beta density
+ *
+ *                      a-1     b-1
+ *   d/dx incbet  =    x   (1-x)    / B(a,b).
+ *
+ * The derivatives in a and b follow the expansion that incbet()
+ * chooses.  They are carried along the power series term by term,
+ * and along the numerator and denominator recurrences of the
+ * continued fractions, whose partial numerators are rational in
+ * a and b.  The prefactor contributes the logarithmic derivatives
+ * log(x) + psi(a+b) - psi(a) and log(1-x) + psi(a+b) - psi(b).
+ * Its lgam and psi values are shared with the density, and are
+ * evaluated once when a and b are both shared.
+ *
+ * The values are those of incbet().  The derivatives in a and b
+ * have relative errors of a few times those of the values, except
+ * near their zeros.
+ */
+
+/* Power series of incbet(), without the factor
+ * x**a gamma(a+b) / (gamma(a) gamma(b)), and in ds[0], ds[1] its
+ * derivatives in a and b.
+ */
+static double pseriesgr( a, b, x, ds )
+double a, b, x;
+double *ds;
+{
+double s, t, u, v, n, t1, z, ai;
+double sa, sb, tb, va, vb;
+
+ai = 1.0 / a;
+u = (1.0 - b) * x;
+v = u / (a + 1.0);
+t1 = v;
+t = u;
+tb = -x;
+n = 2.0;
+s = 0.0;
+sa = 0.0;
+sb = 0.0;
+z = torch_cephes_MACHEP * ai;
+while( torch_cephes_fabs(v) > z )
+	{
+	u = (n - b) * x / n;
+	tb = tb * u - t * x / n;
+	t *= u;
+	v = t / (a + n);
+	va = -v / (a + n);
+	vb = tb / (a + n);
+	s += v;
+	sa += va;
+	sb += vb;
+	n += 1.0;
+	}
+s += t1;
+s += ai;
+ds[0] = sa - t1 / (a + 1.0) - ai * ai;
+ds[1] = sb - x / (a + 1.0);
+return( s );
+}
+
+
+
+/* Continued fraction incbcf( a, b, x ), or incbd( a, b, x ) if kind
+ * is nonzero, and in dw[0], dw[1] its derivatives in a and b.  The
+ * value is the one where incbcf() or incbd() stops; the recurrence
+ * goes on until the derivatives converge as well.
+ */
+static double cfgr( a, b, x, kind, dw )
+double a, b, x;
+int kind;
+double *dw;
+{
+double xk, pk, pkm1, pkm2, qk, qkm1, qkm2;
+double dxk[2], dpk[2], dpkm1[2], dpkm2[2], dqk[2], dqkm1[2], dqkm2[2];
+double dr[2], dans[2];
+double k1, k2, k3, k4, k5, k6, k7, k8, d2a, d6a, g;
+double r, t, td, ans, val, z, thresh;
+int n, j, done;
+
+/* k2 and k6 are a+b and b-1, exchanged in incbd() */
+k1 = a;
+k3 = a;
+k4 = a + 1.0;
+k5 = 1.0;
+k7 = a + 1.0;
+k8 = a + 2.0;
+if( kind )
+	{
+	k2 = b - 1.0;
+	k6 = a + b;
+	d2a = 0.0;
+	d6a = 1.0;
+	z = x / (1.0-x);
+	}
+else
+	{
+	k2 = a + b;
+	k6 = b - 1.0;
+	d2a = 1.0;
+	d6a = 0.0;
+	z = x;
+	}
+
+pkm2 = 0.0;
+qkm2 = 1.0;
+pkm1 = 1.0;
+qkm1 = 1.0;
+for( j=0; j<2; j++ )
+	{
+	dpkm2[j] = 0.0;
+	dqkm2[j] = 0.0;
+	dpkm1[j] = 0.0;
+	dqkm1[j] = 0.0;
+	dans[j] = 0.0;
+	}
+ans = 1.0;
+val = 1.0;
+r = 1.0;
+n = 0;
+done = 0;
+thresh = 3.0 * torch_cephes_MACHEP;
+do
+	{
+	xk = -( z * k1 * k2 )/( k3 * k4 );
+	g = -z / ( k3 * k4 );
+	dxk[0] = g * (k2 + k1 * d2a) - xk * (1.0/k3 + 1.0/k4);
+	dxk[1] = g * k1;
+	pk = pkm1 +  pkm2 * xk;
+	qk = qkm1 +  qkm2 * xk;
+	for( j=0; j<2; j++ )
+		{
+		dpk[j] = dpkm1[j] + dpkm2[j] * xk + pkm2 * dxk[j];
+		dqk[j] = dqkm1[j] + dqkm2[j] * xk + qkm2 * dxk[j];
+		dpkm2[j] = dpkm1[j];
+		dpkm1[j] = dpk[j];
+		dqkm2[j] = dqkm1[j];
+		dqkm1[j] = dqk[j];
+		}
+	pkm2 = pkm1;
+	pkm1 = pk;
+	qkm2 = qkm1;
+	qkm1 = qk;
+
+	xk = ( z * k5 * k6 )/( k7 * k8 );
+	g = z * k5 / ( k7 * k8 );
+	dxk[0] = g * d6a - xk * (1.0/k7 + 1.0/k8);
+	dxk[1] = g;
+	pk = pkm1 +  pkm2 * xk;
+	qk = qkm1 +  qkm2 * xk;
+	for( j=0; j<2; j++ )
+		{
+		dpk[j] = dpkm1[j] + dpkm2[j] * xk + pkm2 * dxk[j];
+		dqk[j] = dqkm1[j] + dqkm2[j] * xk + qkm2 * dxk[j];
+		dpkm2[j] = dpkm1[j];
+		dpkm1[j] = dpk[j];
+		dqkm2[j] = dqkm1[j];
+		dqkm1[j] = dqk[j];
+		}
+	pkm2 = pkm1;
+	pkm1 = pk;
+	qkm2 = qkm1;
+	qkm1 = qk;
+
+	if( qk != 0 )
+		r = pk/qk;
+	if( r != 0 )
+		{
+		t = torch_cephes_fabs( (ans - r)/r );
+		ans = r;
+		}
+	else
+		t = 1.0;
+	if( !done && (t < thresh || n == 299) )
+		{
+		val = ans;
+		done = 1;
+		}
+
+	td = 0.0;
+	if( qk != 0 )
+		for( j=0; j<2; j++ )
+			{
+			dr[j] = (dpk[j] - r * dqk[j])/qk;
+			/* relative to the larger of the derivative and the value */
+			g = torch_cephes_fabs(dr[j]) > torch_cephes_fabs(r) ?
+				torch_cephes_fabs(dr[j]) : torch_cephes_fabs(r);
+			if( g != 0 && torch_cephes_fabs( dans[j] - dr[j] ) > td * g )
+				td = torch_cephes_fabs( dans[j] - dr[j] ) / g;
+			dans[j] = dr[j];
+			}
+	else
+		td = 1.0;
+	if( done && td < thresh )
+		break;
+
+	k1 += 1.0;
+	k3 += 2.0;
+	k4 += 2.0;
+	k5 += 1.0;
+	k7 += 2.0;
+	k8 += 2.0;
+	if( kind )
+		{
+		k2 -= 1.0;
+		k6 += 1.0;
+		}
+	else
+		{
+		k2 += 1.0;
+		k6 -= 1.0;
+		}
+
+	if( (torch_cephes_fabs(qk) + torch_cephes_fabs(pk)) > big )
+		{
+		pkm2 *= biginv;
+		pkm1 *= biginv;
+		qkm2 *= biginv;
+		qkm1 *= biginv;
+		for( j=0; j<2; j++ )
+			{
+			dpkm2[j] *= biginv;
+			dpkm1[j] *= biginv;
+			dqkm2[j] *= biginv;
+			dqkm1[j] *= biginv;
+			}
+		}
+	if( (torch_cephes_fabs(qk) < biginv) ||
+            (torch_cephes_fabs(pk) < biginv) )
+		{
+		pkm2 *= big;
+		pkm1 *= big;
+		qkm2 *= big;
+		qkm1 *= big;
+		for( j=0; j<2; j++ )
+			{
+			dpkm2[j] *= big;
+			dpkm1[j] *= big;
+			dqkm2[j] *= big;
+			dqkm1[j] *= big;
+			}
+		}
+	}
+while( ++n < 600 );
+
+if( !done )
+	val = ans;
+dw[0] = dans[0];
+dw[1] = dans[1];
+return( val );
+}
+
+
+
+/* Value and derivatives of incbet( aa, bb, xx ).  If lp is not null,
+ * it holds lgam(aa+bb) - lgam(aa) - lgam(bb), psi(aa+bb), psi(aa)
+ * and psi(bb).
+ */
+static void incbgr( aa, bb, xx, lp, y, da, db, dx )
+double aa, bb, xx;
+double *lp, *y, *da, *db, *dx;
+{
+double a, b, t, x, xc, w, u, lab, pab, pa, pb, ta, tb, dw[2];
+int flag;
+
+if( aa <= 0.0 || bb <= 0.0 )
+	goto domerr;
+
+if( (xx <= 0.0) || ( xx >= 1.0) )
+	{
+	if( xx == 0.0 || xx == 1.0 )
+		{
+		*y = xx;
+		*da = 0.0;
+		*db = 0.0;
+		/* the density at the end point */
+		a = xx == 0.0 ? aa : bb;
+		if( a > 1.0 )
+			*dx = 0.0;
+		else if( a == 1.0 )
+			*dx = xx == 0.0 ? bb : aa;
+		else
+			*dx = torch_cephes_MAXNUM;
+		return;
+		}
+domerr:
+	torch_cephes_mtherr( "incbet", DOMAIN );
+	*y = 0.0;
+	*da = 0.0;
+	*db = 0.0;
+	*dx = 0.0;
+	return;
+	}
+
+if( lp )
+	{
+	lab = lp[0];
+	pab = lp[1];
+	pa = lp[2];
+	pb = lp[3];
+	}
+else
+	{
+	lab = torch_cephes_lgam(aa+bb) - torch_cephes_lgam(aa)
+		- torch_cephes_lgam(bb);
+	pab = torch_cephes_psi(aa+bb);
+	pa = torch_cephes_psi(aa);
+	pb = torch_cephes_psi(bb);
+	}
+*dx = torch_cephes_exp( (aa - 1.0) * torch_cephes_log(xx)
+		+ (bb - 1.0) * torch_cephes_log1p(-xx) + lab );
+
+flag = 0;
+a = aa;
+b = bb;
+x = xx;
+xc = 1.0 - xx;
+if( (bb * xx) <= 1.0 && xx <= 0.95)
+	goto series;
+
+/* Reverse a and b if x is greater than the mean. */
+if( xx > (aa/(aa+bb)) )
+	{
+	flag = 1;
+	a = bb;
+	b = aa;
+	xc = xx;
+	x = 1.0 - xx;
+	t = pa;
+	pa = pb;
+	pb = t;
+	}
+
+if( flag == 1 && (b * x) <= 1.0 && x <= 0.95)
+	goto series;
+
+/* Choose expansion for better convergence. */
+u = x * (a+b-2.0) - (a-1.0);
+if( u < 0.0 )
+	w = cfgr( a, b, x, 0, dw );
+else
+	{
+	w = cfgr( a, b, x, 1, dw ) / xc;
+	dw[0] /= xc;
+	dw[1] /= xc;
+	}
+
+/* The factor of incbet() */
+u = a * torch_cephes_log(x);
+t = b * torch_cephes_log(xc);
+ta = u / a + pab - pa - 1.0/a + dw[0] / w;
+tb = t / b + pab - pb + dw[1] / w;
+if( (a+b) < MAXGAM && torch_cephes_fabs(u) < torch_cephes_MAXLOG &&
+    torch_cephes_fabs(t) < torch_cephes_MAXLOG )
+	{
+	t = torch_cephes_pow(xc,b);
+	t *= torch_cephes_pow(x,a);
+	t /= a;
+	t *= w;
+	t *= torch_cephes_gamma(a+b) /
+            (torch_cephes_gamma(a) * torch_cephes_gamma(b));
+	goto done;
+	}
+u += t + torch_cephes_lgam(a+b) - torch_cephes_lgam(a) - torch_cephes_lgam(b);
+u += torch_cephes_log(w/a);
+if( u < torch_cephes_MINLOG )
+	t = 0.0;
+else
+	t = torch_cephes_exp(u);
+goto done;
+
+series:
+w = pseriesgr( a, b, x, dw );
+u = a * torch_cephes_log(x);
+ta = u / a + pab - pa + dw[0] / w;
+tb = pab - pb + dw[1] / w;
+if( (a+b) < MAXGAM && torch_cephes_fabs(u) < torch_cephes_MAXLOG )
+	{
+	t = torch_cephes_gamma(a+b)/
+            (torch_cephes_gamma(a)*torch_cephes_gamma(b));
+	t = w * t * torch_cephes_pow(x,a);
+	}
+else
+	{
+	t = torch_cephes_lgam(a+b) - torch_cephes_lgam(a) - 
+            torch_cephes_lgam(b) + u + torch_cephes_log(w);
+	if( t < torch_cephes_MINLOG )
+		t = 0.0;
+	else
+		t = torch_cephes_exp(t);
+	}
+
+done:
+ta *= t;
+tb *= t;
+if( flag == 1 )
+	{
+	if( t <= torch_cephes_MACHEP )
+		t = 1.0 - torch_cephes_MACHEP;
+	else
+		t = 1.0 - t;
+	*da = -tb;
+	*db = -ta;
+	}
+else
+	{
+	*da = ta;
+	*db = tb;
+	}
+*y = t;
+}
+
+
+
+void torch_cephes_incbet_grad( n, a, sa, b, sb, x, sx, y, da, db, dx )
+int n, sa, sb, sx;
+double *a, *b, *x, *y, *da, *db, *dx;
+{
+double lp[4];
+int i, shared;
+
+shared = (sa == 0 && sb == 0 && n > 0 && a[0] > 0.0 && b[0] > 0.0);
+if( shared )
+	{
+	lp[0] = torch_cephes_lgam(a[0]+b[0]) - torch_cephes_lgam(a[0])
+		- torch_cephes_lgam(b[0]);
+	lp[1] = torch_cephes_psi(a[0]+b[0]);
+	lp[2] = torch_cephes_psi(a[0]);
+	lp[3] = torch_cephes_psi(b[0]);
+	}
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	incbgr( a[i*sa], b[i*sb], x[i*sx], shared ? lp : (double *)0,
+		&y[i], &da[i], &db[i], &dx[i] );
+}
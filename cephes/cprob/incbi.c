@@ -56,15 +56,28 @@ extern double torch_cephes_log ( double );
 extern double torch_cephes_sqrt ( double );
 extern double torch_cephes_lgam ( double );
 extern double torch_cephes_incbet ( double, double, double );
+double torch_cephes_incbi_lgm ( double, double, double, double * );
 #else
 double torch_cephes_ndtri(), torch_cephes_exp(), torch_cephes_fabs(),
     torch_cephes_log(), torch_cephes_sqrt(), torch_cephes_lgam(),
-    torch_cephes_incbet();
+    torch_cephes_incbet(), torch_cephes_incbi_lgm();
 #endif
 
 double torch_cephes_incbi( aa, bb, yy0 )
 double aa, bb, yy0;
 {
+return( torch_cephes_incbi_lgm( aa, bb, yy0, (double *)0 ) );
+}
+
+
+/* As incbi(), but takes lgam(a+b) - lgam(a) - lgam(b) from *plgm
+ * when plgm is not NULL.  The term is symmetric in a and b, so
+ * batches that share (a,b) compute it only once.
+ */
+double torch_cephes_incbi_lgm( aa, bb, yy0, plgm )
+double aa, bb, yy0;
+double *plgm;
+{
 double a, b, y0, d, y, x, x0, x1, lgm, yp, di, dithresh, yl, yh, xt;
 int i, rflg, dir, nflg;
 
@@ -242,7 +255,10 @@ newt:
 if( nflg )
 	goto done;
 nflg = 1;
-lgm = torch_cephes_lgam(a+b) - torch_cephes_lgam(a) - torch_cephes_lgam(b);
+if( plgm )
+	lgm = *plgm;
+else
+	lgm = torch_cephes_lgam(a+b) - torch_cephes_lgam(a) - torch_cephes_lgam(b);
 
 for( i=0; i<8; i++ )
 	{
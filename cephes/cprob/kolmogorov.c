@@ -30,14 +30,22 @@ extern double torch_cephes_log ( double );
 extern double torch_cephes_fabs ( double );
 double torch_cephes_smirnov ( int, double );
 double torch_cephes_kolmogorov ( double );
+extern void *malloc ( unsigned long );
+extern void free ( void * );
+static double smirnovc ( int, double *, double );
 #else
 double torch_cephes_pow (), torch_cephes_floor (), torch_cephes_lgam (),
     torch_cephes_exp (), torch_cephes_sqrt (), torch_cephes_log (),
     torch_cephes_fabs ();
 double torch_cephes_smirnov (), torch_cephes_kolmogorov ();
+void *malloc ();
+void free ();
+static double smirnovc ();
 #endif
 extern double torch_cephes_MAXLOG;
 
+#define CHUNK 256
+
 /* Exact Smirnov statistic, for one-sided test.  */
 double
 torch_cephes_smirnov (n, e)
@@ -86,6 +94,115 @@ torch_cephes_smirnov (n, e)
 }
 
 
+/* smirnov (n, e) given the combinatorial terms of the sum for this n:
+   c[v] = nCv if n < 1013, otherwise log(nCv) computed as in smirnov.  */
+static double
+smirnovc (n, c, e)
+     int n;
+     double *c;
+     double e;
+{
+  int v, nn;
+  double evn, omevn, p, t;
+
+  if (n <= 0 || e < 0.0 || e > 1.0)
+    return (-1.0);
+  nn = torch_cephes_floor ((double) n * (1.0 - e));
+  p = 0.0;
+  if (n < 1013)
+    {
+      for (v = 0; v <= nn; v++)
+	{
+	  evn = e + ((double) v) / n;
+	  p += c[v] * torch_cephes_pow (evn, (double) (v - 1))
+	    * torch_cephes_pow (1.0 - evn, (double) (n - v));
+	}
+    }
+  else
+    {
+      for (v = 0; v <= nn; v++)
+	{
+	  evn = e + ((double) v) / n;
+	  omevn = 1.0 - evn;
+	  if (torch_cephes_fabs (omevn) > 0.0)
+	    {
+	      t = c[v]
+		+ (v - 1) * torch_cephes_log (evn)
+		+ (n - v) * torch_cephes_log (omevn);
+	      if (t > -torch_cephes_MAXLOG)
+		p += torch_cephes_exp (t);
+	    }
+	}
+    }
+  return (p * e);
+}
+
+
+/* Batched Smirnov statistic: y[i] = smirnov (n[i*sn], e[i*se]),
+   n being truncated to an integer, for i = 0 .. m-1.  A stride of 0
+   broadcasts the first value.  The combinatorial terms are tabulated
+   once for each run of equal n in a chunk of CHUNK elements, instead
+   of once per element; if the table cannot be allocated, smirnov
+   is called directly.  */
+void
+torch_cephes_smirnov_batch (m, n, sn, e, se, y)
+     int m, sn, se;
+     double *n, *e, *y;
+{
+  int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+  for (i = 0; i < m; i += CHUNK)
+    {
+      double *c, lgamnp1;
+      int j, v, nc, nj, cn;
+
+      nc = m - i < CHUNK ? m - i : CHUNK;
+      c = (double *) 0;
+      cn = 0;
+      for (j = 0; j < nc; j++)
+	{
+	  nj = (int) n[(i + j) * sn];
+	  if (nj <= 0)
+	    {
+	      y[i + j] = -1.0;
+	      continue;
+	    }
+	  if (nj != cn)
+	    {
+	      if (c)
+		free (c);
+	      cn = 0;
+	      c = (double *) malloc ((nj + 1) * sizeof (double));
+	      if (c == (double *) 0)
+		{
+		  y[i + j] = torch_cephes_smirnov (nj, e[(i + j) * se]);
+		  continue;
+		}
+	      cn = nj;
+	      if (nj < 1013)
+		{
+		  c[0] = 1.0;
+		  for (v = 0; v < nj; v++)
+		    c[v + 1] = c[v] * (((double) (nj - v)) / (v + 1));
+		}
+	      else
+		{
+		  lgamnp1 = torch_cephes_lgam ((double) (nj + 1));
+		  for (v = 0; v <= nj; v++)
+		    c[v] = lgamnp1
+		      - torch_cephes_lgam ((double) (v + 1))
+		      - torch_cephes_lgam ((double) (nj - v + 1));
+		}
+	    }
+	  y[i + j] = smirnovc (nj, c, e[(i + j) * se]);
+	}
+      if (c)
+	free (c);
+    }
+}
+
+
 /* Kolmogorov's limiting distribution of two-sided test, returns
    probability that sqrt(n) * max deviation > y,
    or that max deviation > y/sqrt(n).
@@ -114,6 +231,20 @@ torch_cephes_kolmogorov (y)
   return (p + p);
 }
 
+/* Batched Kolmogorov distribution: p[i] = kolmogorov (y[i*sy]),
+   for i = 0 .. m-1, in parallel.  */
+void
+torch_cephes_kolmogorov_batch (m, y, sy, p)
+     int m, sy;
+     double *y, *p;
+{
+  int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+  for (i = 0; i < m; i++)
+    p[i] = torch_cephes_kolmogorov (y[i * sy]);
+}
+
 /* Functional inverse of Smirnov distribution
    finds e such that smirnov(n,e) = p.  */
 double
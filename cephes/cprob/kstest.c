@@ -0,0 +1,153 @@
+/*							kstest.c
+ *
+ *	Kolmogorov-Smirnov statistics of the columns of a matrix
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, m;
+ * double u[n*m], d[m], dplus[m], dminus[m];
+ *
+ * ks_stat( n, m, u, d, dplus, dminus );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * u is an n by m matrix, stored by rows, whose column j holds n
+ * samples already mapped through the distribution function P(x)
+ * under test, u[i*m+j] = P(x[i][j]).  For each column, returns
+ * the one-sided statistics
+ *
+ *      +                                  -
+ *     D  = sup [ S (x) - P(x) ],         D  = sup [ P(x) - S (x) ],
+ *      n          n                        n              n
+ *
+ * of the empirical distribution function S (x) of the column, and
+ *                                         n
+ * the two-sided statistic D = max( D+, D- ).  The columns are
+ * copied, sorted and scanned independently, in parallel.
+ *
+ * The p-values follow from smirnov( n, D+ ) for a one-sided test,
+ * and from kolmogorov( sqrt(n) D ) or from the bound 2 smirnov( n, D )
+ * (exact for D >= 0.5) for the two-sided test; smirnov_batch() and
+ * kolmogorov_batch() evaluate them for all the columns at once.
+ *
+ * If no workspace can be allocated for a column, its statistics
+ * are NAN.
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ *   message         condition         value returned
+ * ks_stat domain     u < 0, u > 1, NaN     -1.0
+ *
+ */
+
+#include "mconf.h"
+#ifdef ANSIPROT
+extern void *malloc ( unsigned long );
+extern void free ( void * );
+static void sift ( double *, int, int );
+static void sortd ( double *, int );
+#else
+void *malloc();
+void free();
+static void sift(), sortd();
+#endif
+extern double torch_cephes_NAN;
+
+
+/* Sift a[i] down the heap a[0..n-1]. */
+static void sift( a, i, n )
+double *a;
+int i, n;
+{
+double t;
+int c;
+
+t = a[i];
+while( (c = 2*i+1) < n )
+	{
+	if( c+1 < n && a[c+1] > a[c] )
+		c += 1;
+	if( a[c] <= t )
+		break;
+	a[i] = a[c];
+	i = c;
+	}
+a[i] = t;
+}
+
+
+/* Sort a[0..n-1] into increasing order (heapsort). */
+static void sortd( a, n )
+double *a;
+int n;
+{
+double t;
+int i;
+
+for( i=n/2-1; i>=0; i-- )
+	sift( a, i, n );
+for( i=n-1; i>0; i-- )
+	{
+	t = a[0];
+	a[0] = a[i];
+	a[i] = t;
+	sift( a, 0, i );
+	}
+}
+
+
+
+void torch_cephes_ks_stat( n, m, u, d, dplus, dminus )
+int n, m;
+double *u, *d, *dplus, *dminus;
+{
+int j;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( j=0; j<m; j++ )
+	{
+	double *w, dp, dm, t;
+	int i;
+
+	w = (double *) malloc( (n > 0 ? n : 1) * sizeof(double) );
+	if( w == (double *) 0 )
+		{
+		d[j] = dplus[j] = dminus[j] = torch_cephes_NAN;
+		continue;
+		}
+	for( i=0; i<n; i++ )
+		{
+		w[i] = u[(long) i*m + j];
+		if( !(w[i] >= 0.0 && w[i] <= 1.0) )
+			break;
+		}
+	if( i < n || n <= 0 )
+		{
+		torch_cephes_mtherr( "ks_stat", DOMAIN );
+		d[j] = dplus[j] = dminus[j] = -1.0;
+		free( w );
+		continue;
+		}
+	sortd( w, n );
+	dp = 0.0;
+	dm = 0.0;
+	for( i=0; i<n; i++ )
+		{
+		t = (double) (i+1) / n - w[i];
+		if( t > dp )
+			dp = t;
+		t = w[i] - (double) i / n;
+		if( t > dm )
+			dm = t;
+		}
+	free( w );
+	dplus[j] = dp;
+	dminus[j] = dm;
+	d[j] = dp > dm ? dp : dm;
+	}
+}
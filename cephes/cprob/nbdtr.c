@@ -118,10 +118,18 @@ Copyright 1984, 1987, 1995, 2000 by Stephen L. Moshier
 #ifdef ANSIPROT
 extern double torch_cephes_incbet ( double, double, double );
 extern double torch_cephes_incbi ( double, double, double );
+extern void torch_cephes_incbetv ( int, double *, int, double *, int,
+				   double *, double * );
+static void nbdtrbatch ( int, double *, int, double *, int,
+			 double *, int, int, double * );
 #else
 double torch_cephes_incbet(), torch_cephes_incbi();
+void torch_cephes_incbetv();
+static void nbdtrbatch();
 #endif
 
+#define CHUNK 256
+
 double torch_cephes_nbdtrc( k, n, p )
 int k, n;
 double p;
@@ -184,3 +192,84 @@ dn = n;
 w = torch_cephes_incbi( dn, dk, p );
 return( w );
 }
+
+
+
+/*							nbdtr_batch()
+ *
+ * nbdtr_batch( n, k, sk, nn, snn, p, sp, y );
+ * nbdtrc_batch( n, k, sk, nn, snn, p, sp, y );
+ *
+ * Set y[i] to nbdtr() or nbdtrc() of ( k[i*sk], nn[i*snn], p[i*sp] ),
+ * k and nn being truncated to integers.  A stride of 0 broadcasts
+ * the first value.  The incomplete beta integrals of each chunk are
+ * evaluated together by incbetv().
+ */
+
+static void nbdtrbatch( n, k, sk, nn, snn, p, sp, comp, y )
+int n, sk, snn, sp, comp;
+double *k, *nn, *p, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double av[CHUNK], bv[CHUNK], xv[CHUNK];
+	int bad[CHUNK];
+	double pj;
+	int j, nc, kj, nbad;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nbad = 0;
+	for( j=0; j<nc; j++ )
+		{
+		kj = (int) k[(i+j)*sk];
+		pj = p[(i+j)*sp];
+		bad[j] = (pj < 0.0) || (pj > 1.0) || (kj < 0);
+		if( bad[j] )
+			{
+			torch_cephes_mtherr( "nbdtr", DOMAIN );
+			/* placeholder argument, result replaced below */
+			av[j] = 1.0;
+			bv[j] = 1.0;
+			xv[j] = 0.0;
+			nbad += 1;
+			}
+		else if( comp )
+			{
+			av[j] = kj + 1;
+			bv[j] = (int) nn[(i+j)*snn];
+			xv[j] = 1.0 - pj;
+			}
+		else
+			{
+			av[j] = (int) nn[(i+j)*snn];
+			bv[j] = kj + 1;
+			xv[j] = pj;
+			}
+		}
+	torch_cephes_incbetv( nc, av, 1, bv, 1, xv, y + i );
+	if( nbad == 0 )
+		continue;
+	for( j=0; j<nc; j++ )
+		if( bad[j] )
+			y[i+j] = 0.0;
+	}
+}
+
+
+void torch_cephes_nbdtr_batch( n, k, sk, nn, snn, p, sp, y )
+int n, sk, snn, sp;
+double *k, *nn, *p, *y;
+{
+nbdtrbatch( n, k, sk, nn, snn, p, sp, 0, y );
+}
+
+
+void torch_cephes_nbdtrc_batch( n, k, sk, nn, snn, p, sp, y )
+int n, sk, snn, sp;
+double *k, *nn, *p, *y;
+{
+nbdtrbatch( n, k, sk, nn, snn, p, sp, 1, y );
+}
@@ -524,3 +524,43 @@ y = x * torch_cephes_polevl( z, T, 4 ) / torch_cephes_p1evl( z, U, 5 );
 return( y );
 
 }
+
+
+
+/*							erf_grad()
+ *
+ *	Error function and its derivative
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx;
+ * double x[], y[n], dy[n];
+ *
+ * erf_grad( n, x, sx, y, dy );
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to erf( x[i*sx] ) and dy[i] to its derivative
+ *
+ *                      2
+ *    d/dx erf(x) = 2 exp(-x ) / sqrt(pi),
+ *
+ * with exp(-x^2) from expx2(), in parallel.
+ */
+
+void torch_cephes_erf_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	y[i] = torch_cephes_erf( x[i*sx] );
+	/* 2/sqrt(pi) */
+	dy[i] = 1.12837916709551257390 * torch_cephes_expx2( x[i*sx], -1 );
+	}
+}
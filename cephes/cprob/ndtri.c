@@ -52,6 +52,7 @@ Copyright 1984, 1987, 1989, 2000 by Stephen L. Moshier
 */
 
 #include "mconf.h"
+#include "../torch_profile.h"
 extern double torch_cephes_MAXNUM;
 
 #ifdef UNK
@@ -379,11 +380,13 @@ int code;
 if( y0 <= 0.0 )
 	{
 	torch_cephes_mtherr( "ndtri", DOMAIN );
+	PROFILE( PROF_NDTRI, 3, 0 );
 	return( -torch_cephes_MAXNUM );
 	}
 if( y0 >= 1.0 )
 	{
 	torch_cephes_mtherr( "ndtri", DOMAIN );
+	PROFILE( PROF_NDTRI, 3, 0 );
 	return( torch_cephes_MAXNUM );
 	}
 code = 1;
@@ -396,6 +399,7 @@ if( y > (1.0 - 0.13533528323661269189) ) /* 0.135... = exp(-2) */
 
 if( y > 0.13533528323661269189 )
 	{
+	PROFILE( PROF_NDTRI, 0, 0 );
 	y = y - 0.5;
 	y2 = y * y;
 	x = y + y * (y2 * torch_cephes_polevl( y2, P0, 4)/
@@ -409,9 +413,15 @@ x0 = x - torch_cephes_log(x)/x;
 
 z = 1.0/x;
 if( x < 8.0 ) /* y > exp(-32) = 1.2664165549e-14 */
+	{
+	PROFILE( PROF_NDTRI, 1, 0 );
 	x1 = z * torch_cephes_polevl( z, P1, 8 )/torch_cephes_p1evl( z, Q1, 8 );
+	}
 else
+	{
+	PROFILE( PROF_NDTRI, 2, 0 );
 	x1 = z * torch_cephes_polevl( z, P2, 8 )/torch_cephes_p1evl( z, Q2, 8 );
+	}
 x = x0 - x1;
 if( code != 0 )
 	x = -x;
@@ -130,10 +130,20 @@ Copyright 1984, 1987, 1995, 2000 by Stephen L. Moshier
 extern double torch_cephes_igam ( double, double );
 extern double torch_cephes_igamc ( double, double );
 extern double torch_cephes_igami ( double, double );
+extern double torch_cephes_lgam ( double );
+extern void torch_cephes_igamv ( int, double *, int, double *, double *, int,
+				 double * );
+static void pdtrbatch ( char *, int, double *, int, double *, int, int,
+			double * );
 #else
 double torch_cephes_igam(), torch_cephes_igamc(), torch_cephes_igami();
+double torch_cephes_lgam();
+void torch_cephes_igamv();
+static void pdtrbatch();
 #endif
 
+#define CHUNK 256
+
 double torch_cephes_pdtrc( k, m )
 int k;
 double m;
@@ -182,3 +192,81 @@ v = k+1;
 v = torch_cephes_igami( v, y );
 return( v );
 }
+
+
+
+/*							pdtr_batch()
+ *
+ * pdtr_batch( n, k, sk, m, sm, y );
+ * pdtrc_batch( n, k, sk, m, sm, y );
+ *
+ * Set y[i] to pdtr() or pdtrc() of ( k[i*sk], m[i*sm] ), the
+ * number of events k being truncated to an integer.  A stride of 0
+ * broadcasts the first value.  With a shared k, lgam(k+1) is
+ * computed once for the batch.
+ */
+
+static void pdtrbatch( name, n, k, sk, m, sm, comp, y )
+char *name;
+int n, sk, sm, comp;
+double *k, *m, *y;
+{
+double lgm;
+int i, shared;
+
+shared = (sk == 0) && ((int) k[0] >= 0);
+if( shared )
+	lgm = torch_cephes_lgam( (double) ((int) k[0] + 1) );
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double vv[CHUNK], mv[CHUNK];
+	int j, nc, nbad, kj;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nbad = 0;
+	for( j=0; j<nc; j++ )
+		{
+		kj = (int) k[(i+j)*sk];
+		mv[j] = m[(i+j)*sm];
+		if( (kj < 0) || (mv[j] <= 0.0) )
+			{
+			/* placeholder argument, result replaced below */
+			mv[j] = 0.0;
+			vv[j] = 1.0;
+			nbad += 1;
+			}
+		else
+			vv[j] = kj + 1;
+		}
+	/* pdtr is the complemented integral */
+	torch_cephes_igamv( nc, vv, 1, shared ? &lgm : (double *)0,
+			    mv, !comp, y + i );
+	if( nbad == 0 )
+		continue;
+	for( j=0; j<nc; j++ )
+		{
+		if( ((int) k[(i+j)*sk] < 0) || (m[(i+j)*sm] <= 0.0) )
+			{
+			torch_cephes_mtherr( name, DOMAIN );
+			y[i+j] = 0.0;
+			}
+		}
+	}
+}
+
+
+void torch_cephes_pdtr_batch( n, k, sk, m, sm, y )
+int n, sk, sm;
+double *k, *m, *y;
+{
+pdtrbatch( "pdtr", n, k, sk, m, sm, 0, y );
+}
+
+
+void torch_cephes_pdtrc_batch( n, k, sk, m, sm, y )
+int n, sk, sm;
+double *k, *m, *y;
+{
+pdtrbatch( "pdtrc", n, k, sk, m, sm, 1, y );
+}
@@ -0,0 +1,402 @@
+/*							sample.c
+ *
+ *	Batched random variates by inversion
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sa, sb;
+ * double a[], b[], y[];
+ * unsigned long long seed, offset;
+ *
+ * sample_uniform( n, seed, offset, y );
+ * sample_normal( n, mu, smu, sigma, ssigma, seed, offset, y );
+ * sample_gamma( n, a, sa, b, sb, seed, offset, y );
+ * sample_beta( n, a, sa, b, sb, seed, offset, y );
+ * sample_chi2( n, df, sdf, seed, offset, y );
+ * sample_t( n, df, sdf, seed, offset, y );
+ * sample_f( n, a, sa, b, sb, seed, offset, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Fills y[0..n-1] with variates of the named distribution, obtained
+ * by applying the inverse distribution function (ndtri, igami,
+ * incbi) to uniform deviates on the open interval (0,1).
+ *
+ * The parameters follow the conventions of the corresponding
+ * distribution functions: gamma has rate a and shape b as in gdtr(),
+ * t has df degrees of freedom as in stdtr(), F has a and b degrees
+ * of freedom as in fdtr().  Degrees of freedom need not be integers.
+ *
+ * Each parameter array is read with its own stride: a stride of 1
+ * gives one parameter per output, a stride of 0 broadcasts a[0] to
+ * every output.  When all shape parameters are broadcast, the
+ * logarithmic gamma normalizers used by the inverse functions are
+ * computed once for the whole batch.
+ *
+ * The uniform deviates are a counter-based stream: deviate k of
+ * stream seed depends only on (seed, offset + k), so the output
+ * does not depend on how the loop is split among threads, and
+ * successive calls continue the stream by advancing offset by n.
+ *
+ * ERROR MESSAGES:
+ *
+ *   message         condition      value returned
+ * sample_xxx domain  a shape, scale or degree of
+ *                    freedom is <= 0          0.0
+ *
+ */
+
+#include "mconf.h"
+
+#ifdef ANSIPROT
+extern double torch_cephes_ndtri ( double );
+extern double torch_cephes_lgam ( double );
+extern double torch_cephes_sqrt ( double );
+extern double torch_cephes_fabs ( double );
+extern double torch_cephes_incbet ( double, double, double );
+extern double torch_cephes_igami_lgm ( double, double, double * );
+extern double torch_cephes_incbi_lgm ( double, double, double, double * );
+static unsigned long long mix ( unsigned long long );
+static double uniform ( unsigned long long, unsigned long long );
+static double stdtri_lgm ( double, double, double * );
+static double fdtri_lgm ( double, double, double, double, double * );
+#else
+double torch_cephes_ndtri(), torch_cephes_lgam(), torch_cephes_sqrt();
+double torch_cephes_fabs(), torch_cephes_incbet();
+double torch_cephes_igami_lgm(), torch_cephes_incbi_lgm();
+static unsigned long long mix();
+static double uniform();
+static double stdtri_lgm(), fdtri_lgm();
+#endif
+extern double torch_cephes_MAXNUM;
+
+/* 2^-53 */
+#define UNIFSCALE 1.1102230246251565404e-16
+
+/* The splitmix64 finalizer. */
+static unsigned long long mix( z )
+unsigned long long z;
+{
+z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+return( z ^ (z >> 31) );
+}
+
+/* Deviate number k of the stream whose key is mix(seed),
+ * uniform on (0,1).
+ */
+static double uniform( key, k )
+unsigned long long key, k;
+{
+unsigned long long z;
+
+z = mix( key + (k + 1) * 0x9e3779b97f4a7c15ULL );
+return( ((double) (z >> 11) + 0.5) * UNIFSCALE );
+}
+
+
+/* stdtri() for real degrees of freedom rk; *plgm, if given, is
+ * lgam(0.5 + 0.5 rk) - lgam(0.5) - lgam(0.5 rk).
+ */
+static double stdtri_lgm( rk, p, plgm )
+double rk, p;
+double *plgm;
+{
+double t, z;
+int rflg;
+
+if( p > 0.25 && p < 0.75 )
+	{
+	if( p == 0.5 )
+		return( 0.0 );
+	z = 1.0 - 2.0 * p;
+	z = torch_cephes_incbi_lgm( 0.5, 0.5*rk, torch_cephes_fabs(z), plgm );
+	t = torch_cephes_sqrt( rk*z/(1.0-z) );
+	if( p < 0.5 )
+		t = -t;
+	return( t );
+	}
+rflg = -1;
+if( p >= 0.5)
+	{
+	p = 1.0 - p;
+	rflg = 1;
+	}
+z = torch_cephes_incbi_lgm( 0.5*rk, 0.5, 2.0*p, plgm );
+
+if( torch_cephes_MAXNUM * z < rk )
+	return(rflg* torch_cephes_MAXNUM);
+t = torch_cephes_sqrt( rk/z - rk );
+return( rflg * t );
+}
+
+
+/* fdtri() for real degrees of freedom a, b.  w5 is
+ * incbet( 0.5 b, 0.5 a, 0.5 ), *plgm as for incbi_lgm().
+ */
+static double fdtri_lgm( a, b, y, w5, plgm )
+double a, b, y, w5;
+double *plgm;
+{
+double w;
+
+if( w5 > y || y < 0.001)
+	{
+	w = torch_cephes_incbi_lgm( 0.5*b, 0.5*a, y, plgm );
+	return( (b - b*w)/(a*w) );
+	}
+w = torch_cephes_incbi_lgm( 0.5*a, 0.5*b, 1.0-y, plgm );
+return( b*w/(a*(1.0-w)) );
+}
+
+
+
+void torch_cephes_sample_uniform( n, seed, offset, y )
+int n;
+unsigned long long seed, offset;
+double *y;
+{
+unsigned long long key;
+int i;
+
+key = mix( seed );
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	y[i] = uniform( key, offset + i );
+}
+
+
+
+void torch_cephes_sample_normal( n, mu, smu, sigma, ssigma, seed, offset, y )
+int n, smu, ssigma;
+double *mu, *sigma;
+unsigned long long seed, offset;
+double *y;
+{
+unsigned long long key;
+int i, bad;
+
+key = mix( seed );
+bad = 0;
+#pragma omp parallel for reduction(|:bad) copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double s;
+
+	s = sigma[i*ssigma];
+	if( s <= 0.0 )
+		{
+		bad = 1;
+		y[i] = 0.0;
+		continue;
+		}
+	y[i] = mu[i*smu] + s * torch_cephes_ndtri( uniform( key, offset + i ) );
+	}
+/* Report the domain errors once, outside the threads */
+if( bad )
+	torch_cephes_mtherr( "sample_normal", DOMAIN );
+}
+
+
+
+void torch_cephes_sample_gamma( n, a, sa, b, sb, seed, offset, y )
+int n, sa, sb;
+double *a, *b;
+unsigned long long seed, offset;
+double *y;
+{
+unsigned long long key;
+double lgm;
+int i, shared, bad;
+
+key = mix( seed );
+lgm = 0.0;
+shared = (sb == 0) && (b[0] > 0.0);
+if( shared )
+	lgm = torch_cephes_lgam( b[0] );
+bad = 0;
+#pragma omp parallel for reduction(|:bad) copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double ai, bi, u;
+
+	ai = a[i*sa];
+	bi = b[i*sb];
+	if( ai <= 0.0 || bi <= 0.0 )
+		{
+		bad = 1;
+		y[i] = 0.0;
+		continue;
+		}
+	u = uniform( key, offset + i );
+	y[i] = torch_cephes_igami_lgm( bi, u, shared ? &lgm : (double *)0 ) / ai;
+	}
+if( bad )
+	torch_cephes_mtherr( "sample_gamma", DOMAIN );
+}
+
+
+
+void torch_cephes_sample_beta( n, a, sa, b, sb, seed, offset, y )
+int n, sa, sb;
+double *a, *b;
+unsigned long long seed, offset;
+double *y;
+{
+unsigned long long key;
+double lgm;
+int i, shared, bad;
+
+key = mix( seed );
+lgm = 0.0;
+shared = (sa == 0) && (sb == 0) && (a[0] > 0.0) && (b[0] > 0.0);
+if( shared )
+	lgm = torch_cephes_lgam( a[0] + b[0] ) - torch_cephes_lgam( a[0] )
+		- torch_cephes_lgam( b[0] );
+bad = 0;
+#pragma omp parallel for reduction(|:bad) copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double ai, bi, u;
+
+	ai = a[i*sa];
+	bi = b[i*sb];
+	if( ai <= 0.0 || bi <= 0.0 )
+		{
+		bad = 1;
+		y[i] = 0.0;
+		continue;
+		}
+	u = uniform( key, offset + i );
+	y[i] = torch_cephes_incbi_lgm( ai, bi, u, shared ? &lgm : (double *)0 );
+	}
+if( bad )
+	torch_cephes_mtherr( "sample_beta", DOMAIN );
+}
+
+
+
+void torch_cephes_sample_chi2( n, df, sdf, seed, offset, y )
+int n, sdf;
+double *df;
+unsigned long long seed, offset;
+double *y;
+{
+unsigned long long key;
+double lgm;
+int i, shared, bad;
+
+key = mix( seed );
+lgm = 0.0;
+shared = (sdf == 0) && (df[0] > 0.0);
+if( shared )
+	lgm = torch_cephes_lgam( 0.5 * df[0] );
+bad = 0;
+#pragma omp parallel for reduction(|:bad) copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double d, u;
+
+	d = df[i*sdf];
+	if( d <= 0.0 )
+		{
+		bad = 1;
+		y[i] = 0.0;
+		continue;
+		}
+	u = uniform( key, offset + i );
+	y[i] = 2.0 * torch_cephes_igami_lgm( 0.5 * d, u, shared ? &lgm : (double *)0 );
+	}
+if( bad )
+	torch_cephes_mtherr( "sample_chi2", DOMAIN );
+}
+
+
+
+void torch_cephes_sample_t( n, df, sdf, seed, offset, y )
+int n, sdf;
+double *df;
+unsigned long long seed, offset;
+double *y;
+{
+unsigned long long key;
+double lgm;
+int i, shared, bad;
+
+key = mix( seed );
+lgm = 0.0;
+shared = (sdf == 0) && (df[0] > 0.0);
+if( shared )
+	lgm = torch_cephes_lgam( 0.5 + 0.5 * df[0] ) - torch_cephes_lgam( 0.5 )
+		- torch_cephes_lgam( 0.5 * df[0] );
+bad = 0;
+#pragma omp parallel for reduction(|:bad) copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double d;
+
+	d = df[i*sdf];
+	if( d <= 0.0 )
+		{
+		bad = 1;
+		y[i] = 0.0;
+		continue;
+		}
+	y[i] = stdtri_lgm( d, uniform( key, offset + i ),
+			   shared ? &lgm : (double *)0 );
+	}
+if( bad )
+	torch_cephes_mtherr( "sample_t", DOMAIN );
+}
+
+
+
+void torch_cephes_sample_f( n, a, sa, b, sb, seed, offset, y )
+int n, sa, sb;
+double *a, *b;
+unsigned long long seed, offset;
+double *y;
+{
+unsigned long long key;
+double lgm, w5;
+int i, shared, bad;
+
+key = mix( seed );
+lgm = 0.0;
+w5 = 0.0;
+shared = (sa == 0) && (sb == 0) && (a[0] > 0.0) && (b[0] > 0.0);
+if( shared )
+	{
+	lgm = torch_cephes_lgam( 0.5 * (a[0] + b[0]) )
+		- torch_cephes_lgam( 0.5 * a[0] ) - torch_cephes_lgam( 0.5 * b[0] );
+	w5 = torch_cephes_incbet( 0.5 * b[0], 0.5 * a[0], 0.5 );
+	}
+bad = 0;
+#pragma omp parallel for reduction(|:bad) copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double ai, bi, u;
+
+	ai = a[i*sa];
+	bi = b[i*sb];
+	if( ai <= 0.0 || bi <= 0.0 )
+		{
+		bad = 1;
+		y[i] = 0.0;
+		continue;
+		}
+	u = uniform( key, offset + i );
+	if( shared )
+		y[i] = fdtri_lgm( ai, bi, u, w5, &lgm );
+	else
+		y[i] = fdtri_lgm( ai, bi, u,
+				  torch_cephes_incbet( 0.5 * bi, 0.5 * ai, 0.5 ),
+				  (double *)0 );
+	}
+if( bad )
+	torch_cephes_mtherr( "sample_f", DOMAIN );
+}
@@ -93,11 +93,17 @@ extern double torch_cephes_atan ( double );
 extern double torch_cephes_incbet ( double, double, double );
 extern double torch_cephes_incbi ( double, double, double );
 extern double torch_cephes_fabs ( double );
+extern double torch_cephes_stdtr ( int, double );
+extern void torch_cephes_incbetv ( int, double *, int, double *, int,
+				   double *, double * );
 #else
 double torch_cephes_sqrt(), torch_cephes_atan(), torch_cephes_incbet(),
-   torch_cephes_incbi(), torch_cephes_fabs();
+   torch_cephes_incbi(), torch_cephes_fabs(), torch_cephes_stdtr();
+void torch_cephes_incbetv();
 #endif
 
+#define CHUNK 256
+
 double torch_cephes_stdtr( k, t )
 int k;
 double t;
@@ -224,3 +230,56 @@ if( torch_cephes_MAXNUM * z < rk )
 t = torch_cephes_sqrt( rk/z - rk );
 return( rflg * t );
 }
+
+
+
+/*							stdtr_batch()
+ *
+ * stdtr_batch( n, k, sk, t, st, y );
+ *
+ * Sets y[i] to stdtr( k[i*sk], t[i*st] ), k being truncated to an
+ * integer.  A stride of 0 broadcasts the first value.  The left
+ * tail t < -2, which stdtr() evaluates by the incomplete beta
+ * integral, is evaluated for each chunk together by incbetv().
+ */
+
+void torch_cephes_stdtr_batch( n, k, sk, t, st, y )
+int n, sk, st;
+double *k, *t, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double av[CHUNK], xv[CHUNK], sv[CHUNK];
+	int isp[CHUNK];
+	double rk, tj, half;
+	int j, nc, kj;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	for( j=0; j<nc; j++ )
+		{
+		kj = (int) k[(i+j)*sk];
+		tj = t[(i+j)*st];
+		isp[j] = (kj <= 0) || !(tj < -2.0);
+		if( isp[j] )
+			{
+			sv[j] = torch_cephes_stdtr( kj, tj );
+			/* placeholder argument, result replaced below */
+			av[j] = 1.0;
+			xv[j] = 0.0;
+			}
+		else
+			{
+			rk = kj;
+			av[j] = 0.5*rk;
+			xv[j] = rk / (rk + tj * tj);
+			}
+		}
+	half = 0.5;
+	torch_cephes_incbetv( nc, av, 1, &half, 0, xv, y + i );
+	for( j=0; j<nc; j++ )
+		y[i+j] = isp[j] ? sv[j] : 0.5 * y[i+j];
+	}
+}
@@ -0,0 +1,1100 @@
+/*							ellfdes.c
+ *
+ *	Design of Butterworth, Chebyshev and elliptic IIR filters
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * ellfspec spec;
+ * ellfdesign out;
+ * int ellf_design();
+ *
+ * status = ellf_design( &spec, &out );
+ *
+ * ellf_design_batch( n, spec, out, status );
+ *
+ * y = ellf_response( &out, f );
+ *
+ * double sos[6*(ELLFMAXORD+1)/2];
+ * ns = ellf_sos( &out, sos );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Computes the z plane poles, zeros, polynomial coefficients and
+ * gain of the digital filter specified by spec:
+ *
+ *   kind   1 Butterworth, 2 Chebyshev, 3 elliptic
+ *   type   1 low pass, 2 band pass, 3 high pass, 4 band stop
+ *   n      order of the analog prototype
+ *   dbr    pass band ripple, peak to peak decibels (kinds 2, 3)
+ *   fs     sampling frequency, Hz
+ *   f2     pass band edge, Hz
+ *   f1     other pass band edge of types 2 and 4, Hz
+ *   dbd    elliptic: stop band edge in Hz if > 0, else the stop
+ *          band attenuation as -decibels
+ *
+ * This is the computation of the interactive program ellf.c,
+ * with its state kept in a structure of the caller instead of
+ * file-scope variables, and no terminal input or output, so that
+ * it may run in several threads at once.  ellf.doc describes the
+ * method and the meaning of the results.
+ *
+ * The transfer function of the design is
+ *
+ *                  num[0] + num[1] z^-1 + ... + num[order] z^-order
+ *   H(z) = gain * -------------------------------------------------
+ *                  den[0] + den[1] z^-1 + ... + den[order] z^-order
+ *
+ * with the gain already multiplied into num[], den[0] = 1, and
+ * the roots of the polynomials in pole[] and zero[], complex
+ * roots followed by their conjugates.  For elliptic filters, f3
+ * and dbdown receive the stop band edge and attenuation.
+ *
+ * ellf_design_batch() designs the n filters spec[i] into out[i]
+ * in parallel, and sets status[i] to the value ellf_design()
+ * returns.  ellf_response() is the magnitude of the frequency
+ * response of a design at f Hz.
+ *
+ * ellf_sos() factors the design into ns = (order+1)/2 second
+ * order sections b0 b1 b2 a0 a1 a2, six coefficients of z^-j each,
+ * a0 = 1, whose product is H(z); sosfilt() applies them.  Each
+ * pair of poles takes the nearest pair of zeros, the poles
+ * nearest the unit circle choosing first, and the sections are
+ * stored by increasing pole radius with the gain in the first
+ * one.  Real roots left over in odd orders make a first order
+ * section, b2 = a2 = 0.
+ *
+ *
+ * RETURNS:
+ *
+ *  0  the design is in out
+ * -1  the specification is invalid, e.g. the stop band edge is
+ *     in the pass band or above fs/2, the stop band attenuation
+ *     does not exceed the ripple, or a band has zero width
+ * -2  the order exceeds ELLFMAXORD: order n, or 2n for band pass
+ *     and band stop filters
+ *
+ */
+
+/*
+Cephes Math Library Release 2.8:  June, 2000
+Copyright 1984, 1987, 1988, 2000 by Stephen L. Moshier
+*/
+
+#include "mconf.h"
+
+/* size of the work arrays, as ellf.c */
+#define ARRSIZ 50
+#define ELLFMAXORD 24
+
+typedef struct
+	{
+	int kind;	/* 1 Butterworth, 2 Chebyshev, 3 elliptic */
+	int type;	/* 1 low pass, 2 band pass, 3 high pass, 4 band stop */
+	int n;		/* order of the prototype */
+	double dbr;	/* pass band ripple, db */
+	double fs;	/* sampling frequency */
+	double f1;	/* other pass band edge, types 2 and 4 */
+	double f2;	/* pass band edge */
+	double dbd;	/* stop band edge if > 0, else -(db down) */
+	}ellfspec;
+
+typedef struct
+	{
+	int order;	/* of the z plane polynomials */
+	double gain;	/* constant gain factor */
+	double fs;	/* sampling frequency */
+	double f3;	/* stop band edge, elliptic filters */
+	double dbdown;	/* stop band attenuation, elliptic filters */
+	cmplx pole[ELLFMAXORD];
+	cmplx zero[ELLFMAXORD];
+	double den[ELLFMAXORD+1];	/* coefficients of z^-j */
+	double num[ELLFMAXORD+1];
+	}ellfdesign;
+
+/* The file-scope variables of ellf.c that outlive a function */
+typedef struct
+	{
+	int kind, type, n, np, nz, zord, jt;
+	double rn, fs, fnyq, f1, f2, f3;
+	double c, wc, wr, cbp, cgam, scale, eps, phi;
+	double k, m, Kk, u, dbdown, gain;
+	double aa[ARRSIZ];
+	double pp[ARRSIZ];
+	double zs[ARRSIZ];
+	cmplx z[ARRSIZ];
+	}ellfstate;
+
+#ifdef ANSIPROT
+extern double torch_cephes_exp ( double );
+extern double torch_cephes_log ( double );
+extern double torch_cephes_cos ( double );
+extern double torch_cephes_sin ( double );
+extern double torch_cephes_sqrt ( double );
+extern double torch_cephes_fabs ( double );
+extern double torch_cephes_asin ( double );
+extern double torch_cephes_atan ( double );
+extern double torch_cephes_pow ( double, double );
+extern double torch_cephes_cabs ( cmplx *z );
+extern void torch_cephes_cadd ( cmplx *a, cmplx *b, cmplx *c );
+extern void torch_cephes_cdiv ( cmplx *a, cmplx *b, cmplx *c );
+extern void torch_cephes_cmov ( void *a, void *b );
+extern void torch_cephes_cmul ( cmplx *a, cmplx *b, cmplx *c );
+extern void torch_cephes_csqrt ( cmplx *z, cmplx *w );
+extern void torch_cephes_csub ( cmplx *a, cmplx *b, cmplx *c );
+extern double torch_cephes_ellik ( double phi, double m );
+extern int torch_cephes_ellpj ( double, double, double *, double *, double *,
+                                double * );
+extern double torch_cephes_ellpk ( double x );
+int torch_cephes_ellf_design ( ellfspec *, ellfdesign * );
+void torch_cephes_ellf_design_batch ( int, ellfspec *, ellfdesign *, int * );
+double torch_cephes_ellf_response ( ellfdesign *, double );
+int torch_cephes_ellf_sos ( ellfdesign *, double * );
+static int quads ( cmplx *, int, double *, cmplx * );
+static double cay ( double );
+static void lampln ( ellfstate * );
+static void spln ( ellfstate * );
+static void zplna ( ellfstate * );
+static void zplnb ( ellfstate * );
+#else
+double torch_cephes_exp(), torch_cephes_log(), torch_cephes_cos(),
+    torch_cephes_sin(), torch_cephes_sqrt(), torch_cephes_fabs();
+double torch_cephes_ellpk(), torch_cephes_ellik(), torch_cephes_asin(),
+    torch_cephes_atan(), torch_cephes_pow(), torch_cephes_cabs();
+void torch_cephes_cadd(), torch_cephes_cdiv(), torch_cephes_cmov(),
+    torch_cephes_cmul(), torch_cephes_csqrt(), torch_cephes_csub();
+int torch_cephes_ellpj(), torch_cephes_ellf_design();
+void torch_cephes_ellf_design_batch();
+double torch_cephes_ellf_response();
+int torch_cephes_ellf_sos();
+static int quads();
+static double cay();
+static void lampln(), spln(), zplna(), zplnb();
+#endif
+extern double torch_cephes_PI, torch_cephes_MACHEP, torch_cephes_MAXNUM;
+extern cmplx torch_cephes_cone;
+
+#define PI torch_cephes_PI
+
+
+int torch_cephes_ellf_design( spec, out )
+ellfspec *spec;
+ellfdesign *out;
+{
+ellfstate st, *s;
+double dbfac, a, b, q, bw, ang, cang, sang;
+double m1, m1p, Kk1, Kpk1;
+int j;
+
+s = &st;
+s->kind = spec->kind;
+s->type = spec->type;
+s->n = spec->n;
+s->rn = s->n;
+s->fs = spec->fs;
+s->f1 = spec->f1;
+s->f2 = spec->f2;
+s->f3 = 0.0;
+s->dbdown = 0.0;
+s->wr = 0.0;
+s->cbp = 0.0;
+s->scale = 1.0;
+dbfac = 10.0/torch_cephes_log(10.0);
+
+if( (s->kind <= 0) || (s->kind > 3) || (s->type <= 0) || (s->type > 4)
+	|| (s->n <= 0) )
+	return(-1);
+if( (s->type & 1) == 0 )
+	j = 4 * s->n + 2;
+else
+	j = 2 * s->n + 2;
+if( j > ARRSIZ )
+	return(-2);
+
+if( s->kind > 1 ) /* not Butterworth */
+	{
+	if( !(spec->dbr > 0.0) )
+		return(-1);
+	if( s->kind == 2 )
+		{
+/* For Chebyshev filter, ripples go from 1.0 to 1/sqrt(1+eps^2) */
+		s->phi = torch_cephes_exp( 0.5*spec->dbr/dbfac );
+		if( (s->n & 1) == 0 )
+			s->scale = s->phi;
+		}
+	else
+		{ /* elliptic */
+		s->eps = torch_cephes_exp( spec->dbr/dbfac );
+		if( (s->n & 1) == 0 )
+			s->scale = torch_cephes_sqrt( s->eps );
+		s->eps = torch_cephes_sqrt( s->eps - 1.0 );
+		}
+	}
+
+if( !(s->fs > 0.0) )
+	return(-1);
+s->fnyq = 0.5 * s->fs;
+
+if( !(s->f2 > 0.0 && s->f2 < s->fnyq) )
+	return(-1);
+if( (s->type & 1) == 0 )
+	{
+	if( !(s->f1 > 0.0 && s->f1 < s->fnyq) )
+		return(-1);
+	}
+else
+	s->f1 = 0.0;
+
+if( s->f2 < s->f1 )
+	{
+	a = s->f2;
+	s->f2 = s->f1;
+	s->f1 = a;
+	}
+if( ((s->type & 1) == 0) && (s->f1 == s->f2) )
+	return(-1);	/* band of zero width */
+if( s->type == 3 )	/* high pass */
+	{
+	bw = s->f2;
+	a = s->fnyq;
+	}
+else
+	{
+	bw = s->f2 - s->f1;
+	a = s->f2;
+	}
+/* Frequency correspondence for bilinear transformation
+ *
+ *  Wanalog = tan( 2 pi Fdigital T / 2 )
+ *
+ * where T = 1/fs
+ */
+ang = bw * PI / s->fs;
+cang = torch_cephes_cos( ang );
+s->c = torch_cephes_sin(ang) / cang; /* Wanalog */
+if( s->kind != 3 )
+	s->wc = s->c;
+
+if( s->kind == 3 )
+	{ /* elliptic */
+	s->cgam = torch_cephes_cos( (a+s->f1) * PI / s->fs ) / cang;
+	if( spec->dbd > 0.0 )
+		{
+		s->f3 = spec->dbd;
+		if( !(s->f3 < s->fnyq) )
+			return(-1);
+		}
+	else
+		{ /* calculate band edge from db down */
+		/* the attenuation must exceed the pass band ripple */
+		if( !(-spec->dbd > spec->dbr) )
+			return(-1);
+		a = torch_cephes_exp( -spec->dbd/dbfac );
+		m1 = s->eps/torch_cephes_sqrt( a - 1.0 );
+		m1 *= m1;
+		m1p = 1.0 - m1;
+		Kk1 = torch_cephes_ellpk( m1p );
+		Kpk1 = torch_cephes_ellpk( m1 );
+		q = torch_cephes_exp( -PI * Kpk1 / (s->rn * Kk1) );
+		s->k = cay(q);
+		if( s->type >= 3 )
+			s->wr = s->k;
+		else
+			s->wr = 1.0/s->k;
+		if( s->type & 1 )
+			{
+			s->f3 = torch_cephes_atan( s->c * s->wr ) * s->fs / PI;
+			}
+		else
+			{
+			a = s->c * s->wr;
+			a *= a;
+			b = a * (1.0 - s->cgam * s->cgam) + a * a;
+			b = (s->cgam + torch_cephes_sqrt(b))/(1.0 + a);
+			s->f3 = (PI/2.0 - torch_cephes_asin(b)) * s->fs / (2.0*PI);
+			}
+		}
+	switch( s->type )
+		{
+		case 1:
+			if( s->f3 <= s->f2 )
+				return(-1);
+			break;
+
+		case 2:
+			if( (s->f3 > s->f2) || (s->f3 < s->f1) )
+				break;
+			return(-1);
+
+		case 3:
+			if( s->f3 >= s->f2 )
+				return(-1);
+			break;
+
+		case 4:
+			if( (s->f3 <= s->f1) || (s->f3 >= s->f2) )
+				return(-1);
+			break;
+		}
+	ang = s->f3 * PI / s->fs;
+	cang = torch_cephes_cos(ang);
+	sang = torch_cephes_sin(ang);
+
+	if( s->type & 1 )
+		{
+		s->wr = sang/(cang*s->c);
+		}
+	else
+		{
+		q = cang * cang  -  sang * sang;
+		sang = 2.0 * cang * sang;
+		cang = q;
+		s->wr = (s->cgam - cang)/(sang * s->c);
+		}
+
+	if( s->type >= 3 )
+		s->wr = 1.0/s->wr;
+	if( s->wr < 0.0 )
+		s->wr = -s->wr;
+	s->cbp = s->wr;
+	lampln( s );	/* find locations in lambda plane */
+	}
+
+/* Transformation from low-pass to band-pass critical frequencies
+ *
+ * Center frequency
+ *                     cos( 1/2 (Whigh+Wlow) T )
+ *  cos( Wcenter T ) = ----------------------
+ *                     cos( 1/2 (Whigh-Wlow) T )
+ *
+ *
+ * Band edges
+ *            cos( Wcenter T) - cos( Wdigital T )
+ *  Wanalog = -----------------------------------
+ *                        sin( Wdigital T )
+ */
+
+if( s->kind != 3 )
+	{ /* Butterworth or Chebyshev */
+	a = PI * (a+s->f1) / s->fs ;
+	s->cgam = torch_cephes_cos(a) / cang;
+	a = 2.0 * PI * s->f2 / s->fs;
+	s->cbp = (s->cgam - torch_cephes_cos(a))/torch_cephes_sin(a);
+	}
+
+spln( s );	/* find s plane poles and zeros */
+zplna( s );	/* convert s plane to z plane */
+zplnb( s );
+
+/* zplnc() */
+if( !(torch_cephes_fabs( s->gain ) <= torch_cephes_MAXNUM) )
+	return(-1);	/* NAN or infinite, from a degenerate specification */
+for( j=0; j<=s->zord; j++ )
+	s->pp[j] = s->gain * s->pp[j];
+
+out->order = s->zord;
+out->gain = s->gain;
+out->fs = s->fs;
+out->f3 = s->f3;
+out->dbdown = s->dbdown;
+for( j=0; j<s->zord; j++ )
+	{
+	out->pole[j] = s->z[j];
+	out->zero[j] = s->z[j + s->zord];
+	}
+for( j=0; j<=s->zord; j++ )
+	{
+	out->den[j] = s->aa[j];
+	out->num[j] = s->pp[j];
+	}
+return(0);
+}
+
+
+
+#define CHUNK 16
+
+void torch_cephes_ellf_design_batch( n, spec, out, status )
+int n;
+ellfspec *spec;
+ellfdesign *out;
+int *status;
+{
+int i;
+
+#pragma omp parallel for schedule(dynamic, CHUNK) copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	status[i] = torch_cephes_ellf_design( &spec[i], &out[i] );
+}
+
+
+
+/* Magnitude of the frequency response at f Hz, as response()
+ * of ellf.c
+ */
+double torch_cephes_ellf_response( d, f )
+ellfdesign *d;
+double f;
+{
+cmplx x, num, den, w;
+double u;
+int j;
+
+/* exp( j omega T ) */
+u = 2.0 * PI * f / d->fs;
+x.r = torch_cephes_cos(u);
+x.i = torch_cephes_sin(u);
+
+num.r = 1.0;
+num.i = 0.0;
+den.r = 1.0;
+den.i = 0.0;
+for( j=0; j<d->order; j++ )
+	{
+	torch_cephes_csub( &d->pole[j], &x, &w );
+	torch_cephes_cmul( &w, &den, &den );
+	torch_cephes_csub( &d->zero[j], &x, &w );
+	torch_cephes_cmul( &w, &num, &num );
+	}
+torch_cephes_cdiv( &den, &num, &w );
+w.r *= d->gain;
+w.i *= d->gain;
+return( torch_cephes_cabs( &w ) );
+}
+
+
+
+/* Quadratic factors 1 + q[2j] z^-1 + q[2j+1] z^-2 of the product
+ * of (1 - r[i] z^-1), with complex roots followed by their
+ * conjugates, and the roots of factor j in rt[2j], rt[2j+1].
+ * Returns the number of factors.
+ */
+static int quads( r, n, q, rt )
+cmplx *r;
+int n;
+double *q;
+cmplx *rt;
+{
+double a;
+int i, j, real;
+
+j = 0;
+real = 0;
+a = 0.0;
+for( i=0; i<n; i++ )
+	{
+	if( r[i].i != 0.0 )
+		{
+		q[2*j] = -2.0 * r[i].r;
+		q[2*j+1] = r[i].r * r[i].r + r[i].i * r[i].i;
+		rt[2*j] = r[i];
+		rt[2*j+1] = r[i];
+		rt[2*j+1].i = -r[i].i;
+		j += 1;
+		i += 1;		/* the conjugate */
+		}
+	else if( real )
+		{
+		q[2*j] = -(a + r[i].r);
+		q[2*j+1] = a * r[i].r;
+		rt[2*j].r = a;
+		rt[2*j].i = 0.0;
+		rt[2*j+1] = r[i];
+		j += 1;
+		real = 0;
+		}
+	else
+		{
+		a = r[i].r;
+		real = 1;
+		}
+	}
+if( real )
+	{
+	q[2*j] = -a;
+	q[2*j+1] = 0.0;
+	rt[2*j].r = a;
+	rt[2*j].i = 0.0;
+	rt[2*j+1] = rt[2*j];
+	j += 1;
+	}
+return( j );
+}
+
+
+
+int torch_cephes_ellf_sos( d, sos )
+ellfdesign *d;
+double *sos;
+{
+double pq[ELLFMAXORD+2], zq[ELLFMAXORD+2], rad[ELLFMAXORD/2+1];
+cmplx pr[ELLFMAXORD+2], zr[ELLFMAXORD+2];
+int idx[ELLFMAXORD/2+1], match[ELLFMAXORD/2+1], used[ELLFMAXORD/2+1];
+double a, b, dist, best;
+double *s;
+int i, j, k, p, ns, nz;
+
+ns = quads( d->pole, d->order, pq, pr );
+nz = quads( d->zero, d->order, zq, zr );
+
+/* pole sections by increasing radius */
+for( i=0; i<ns; i++ )
+	{
+	a = torch_cephes_cabs( &pr[2*i] );
+	b = torch_cephes_cabs( &pr[2*i+1] );
+	rad[i] = a > b ? a : b;
+	for( k=i; k>0 && rad[idx[k-1]] > rad[i]; k-- )
+		idx[k] = idx[k-1];
+	idx[k] = i;
+	used[i] = 0;
+	}
+
+/* the poles nearest the unit circle take the nearest zeros */
+for( k=ns-1; k>=0; k-- )
+	{
+	p = idx[k];
+	match[p] = -1;
+	best = 0.0;
+	for( j=0; j<nz; j++ )
+		{
+		if( used[j] )
+			continue;
+		dist = 0.0;
+		for( i=0; i<4; i++ )
+			{
+			a = pr[2*p+(i>>1)].r - zr[2*j+(i&1)].r;
+			b = pr[2*p+(i>>1)].i - zr[2*j+(i&1)].i;
+			if( i == 0 || a*a + b*b < dist )
+				dist = a*a + b*b;
+			}
+		if( match[p] < 0 || dist < best )
+			{
+			match[p] = j;
+			best = dist;
+			}
+		}
+	used[match[p]] = 1;
+	}
+
+for( k=0; k<ns; k++ )
+	{
+	p = idx[k];
+	j = match[p];
+	a = k == 0 ? d->gain : 1.0;
+	s = sos + 6*k;
+	s[0] = a;
+	s[1] = a * zq[2*j];
+	s[2] = a * zq[2*j+1];
+	s[3] = 1.0;
+	s[4] = pq[2*p];
+	s[5] = pq[2*p+1];
+	}
+return( ns );
+}
+
+
+
+static void lampln( s )
+ellfstate *s;
+{
+double a, b, q, m1, m1p, Kk1, Kpk, phi, sn, cn, dn;
+
+s->wc = 1.0;
+s->k = s->wc/s->wr;
+s->m = s->k * s->k;
+s->Kk = torch_cephes_ellpk( 1.0 - s->m );
+Kpk = torch_cephes_ellpk( s->m );
+q = torch_cephes_exp( -PI * s->rn * Kpk / s->Kk );	/* the nome of k1 */
+m1 = cay(q); /* see below */
+/* Note m1 = eps / sqrt( A*A - 1.0 ) */
+a = s->eps/m1;
+a =  a * a + 1;
+s->dbdown = 10.0 * torch_cephes_log(a) / torch_cephes_log(10.0);
+m1 *= m1;
+m1p = 1.0 - m1;
+Kk1 = torch_cephes_ellpk( m1p );
+/*   -1
+ * sn   j/eps\m  =  j ellik( atan(1/eps), m )
+ */
+b = 1.0/s->eps;
+phi = torch_cephes_atan( b );
+s->u = torch_cephes_ellik( phi, m1p );
+torch_cephes_ellpj( s->u, m1p, &sn, &cn, &dn, &phi );
+s->u = s->u * s->Kk / (s->rn * Kk1);	/* or, u = u * Kpk / Kpk1 */
+}
+
+
+
+
+/* calculate s plane poles and zeros, normalized to wc = 1 */
+static void spln( s )
+ellfstate *s;
+{
+double a, b, m, r, rho, phi, sn, cn, dn, sn1, cn1, dn1, phi1;
+double *zs;
+int i, j, n, lr, ir, ii, nt;
+
+zs = s->zs;
+n = s->n;
+for( i=0; i<ARRSIZ; i++ )
+	zs[i] = 0.0;
+s->np = (n+1)/2;
+s->nz = 0;
+ii = 0;
+if( s->kind == 1 )
+	{
+/* Butterworth poles equally spaced around the unit circle
+ */
+	if( n & 1 )
+		m = 0.0;
+	else
+		m = PI / (2.0*n);
+	for( i=0; i<s->np; i++ )
+		{	/* poles */
+		lr = i + i;
+		zs[lr] = -torch_cephes_cos(m);
+		zs[lr+1] = torch_cephes_sin(m);
+		m += PI / n;
+		}
+	}
+if( s->kind == 2 )
+	{
+	/* For Chebyshev, find radii of two Butterworth circles
+	 * See Gold & Rader, page 60
+	 */
+	phi = s->phi;
+	rho = (phi - 1.0)*(phi+1);  /* rho = eps^2 = {sqrt(1+eps^2)}^2 - 1 */
+	s->eps = torch_cephes_sqrt(rho);
+	/* sqrt( 1 + 1/eps^2 ) + 1/eps  = {sqrt(1 + eps^2)  +  1} / eps
+	 */
+	phi = (phi + 1.0) / s->eps;
+	phi = torch_cephes_pow( phi, 1.0/s->rn );  /* raise to the 1/n power */
+	b = 0.5 * (phi + 1.0/phi); /* y coordinates are on this circle */
+	a = 0.5 * (phi - 1.0/phi); /* x coordinates are on this circle */
+	if( n & 1 )
+		m = 0.0;
+	else
+		m = PI / (2.0*n);
+	for( i=0; i<s->np; i++ )
+		{	/* poles */
+		lr = i + i;
+		zs[lr] = -a * torch_cephes_cos(m);
+		zs[lr+1] = b * torch_cephes_sin(m);
+		m += PI / n;
+		}
+	}
+if( s->kind != 3 )
+	{
+	/* high pass or band reject
+	 */
+	if( s->type >= 3 )
+		{
+		/* map s => 1/s
+		 */
+		for( j=0; j<s->np; j++ )
+			{
+			ir = j + j;
+			ii = ir + 1;
+			b = zs[ir]*zs[ir] + zs[ii]*zs[ii];
+			zs[ir] = zs[ir] / b;
+			zs[ii] = zs[ii] / b;
+			}
+		/* The zeros at infinity map to the origin.
+		 */
+		s->nz = s->np;
+		if( s->type == 4 )
+			{
+			s->nz += n/2;
+			}
+		for( j=0; j<s->nz; j++ )
+			{
+			ir = ii + 1;
+			ii = ir + 1;
+			zs[ir] = 0.0;
+			zs[ii] = 0.0;
+			}
+		}
+	return;
+	}
+
+/* elliptic */
+s->nz = n/2;
+torch_cephes_ellpj( s->u, 1.0-s->m, &sn1, &cn1, &dn1, &phi1 );
+for( i=0; i<s->nz; i++ )
+	{	/* zeros */
+	a = n - 1 - i - i;
+	b = (s->Kk * a) / s->rn;
+	torch_cephes_ellpj( b, s->m, &sn, &cn, &dn, &phi );
+	lr = 2*s->np + 2*i;
+	zs[ lr ] = 0.0;
+	a = s->wc/(s->k*sn);	/* k = sqrt(m) */
+	zs[ lr + 1 ] = a;
+	}
+for( i=0; i<s->np; i++ )
+	{	/* poles */
+	a = n - 1 - i - i;
+	b = a * s->Kk / s->rn;
+	torch_cephes_ellpj( b, s->m, &sn, &cn, &dn, &phi );
+	r = s->k * sn * sn1;
+	b = cn1*cn1 + r*r;
+	a = -s->wc*cn*dn*sn1*cn1/b;
+	lr = i + i;
+	zs[lr] = a;
+	b = s->wc*sn*dn1/b;
+	zs[lr+1] = b;
+	}
+if( s->type >= 3 )
+	{
+	nt = s->np + s->nz;
+	for( j=0; j<nt; j++ )
+		{
+		ir = j + j;
+		ii = ir + 1;
+		b = zs[ir]*zs[ir] + zs[ii]*zs[ii];
+		zs[ir] = zs[ir] / b;
+		zs[ii] = zs[ii] / b;
+		}
+	while( s->np > s->nz )
+		{
+		ir = ii + 1;
+		ii = ir + 1;
+		s->nz += 1;
+		zs[ir] = 0.0;
+		zs[ii] = 0.0;
+		}
+	}
+}
+
+
+
+
+/*		cay()
+ *
+ * Find parameter corresponding to given nome by expansion
+ * in theta functions:
+ * AMS55 #16.38.5, 16.38.7
+ *
+ *       1/2
+ * ( 2K )                   4     9
+ * ( -- )     =  1 + 2q + 2q  + 2q  + ...  =  Theta (0,q)
+ * ( pi )                                          3
+ *
+ *
+ *       1/2
+ * ( 2K )     1/4       1/4        2    6    12    20
+ * ( -- )    m     =  2q    ( 1 + q  + q  + q   + q   + ...) = Theta (0,q)
+ * ( pi )                                                           2
+ *
+ * The nome q(m) = exp( - pi K(1-m)/K(m) ).
+ *
+ *                                1/2
+ * Given q, this program returns m   .
+ */
+static double cay(q)
+double q;
+{
+double a, b, p, r;
+double t1, t2;
+
+a = 1.0;
+b = 1.0;
+r = 1.0;
+p = q;
+
+do
+{
+r *= p;
+a += 2.0 * r;
+t1 = torch_cephes_fabs( r/a );
+
+r *= p;
+b += r;
+p *= q;
+t2 = torch_cephes_fabs( r/b );
+if( t2 > t1 )
+	t1 = t2;
+}
+while( t1 > torch_cephes_MACHEP );
+
+a = b/a;
+a = 4.0 * torch_cephes_sqrt(q) * a * a;	/* see above formulas, solved for m */
+return(a);
+}
+
+
+
+
+/*		zpln.c
+ * Program to convert s plane poles and zeros to the z plane.
+ */
+
+static void zplna( s )
+ellfstate *s;
+{
+cmplx r, cnum, cden, cwc, ca, cb, b4ac;
+cmplx *z;
+double C;
+int i, ir, ii, nc, jt, icnt;
+
+z = s->z;
+if( s->kind == 3 )
+	C = s->c;
+else
+	C = s->wc;
+
+for( i=0; i<ARRSIZ; i++ )
+	{
+	z[i].r = 0.0;
+	z[i].i = 0.0;
+	}
+
+nc = s->np;
+jt = -1;
+ii = -1;
+
+for( icnt=0; icnt<2; icnt++ )
+{
+	/* The maps from s plane to z plane */
+do
+	{
+	ir = ii + 1;
+	ii = ir + 1;
+	r.r = s->zs[ir];
+	r.i = s->zs[ii];
+
+	switch( s->type )
+		{
+		case 1:
+		case 3:
+/* Substitute  s - r  =  s/wc - r = (1/wc)(z-1)/(z+1) - r
+ *
+ *     1  1 - r wc (       1 + r wc )
+ * =  --- -------- ( z  -  -------- )
+ *    z+1    wc    (       1 - r wc )
+ *
+ * giving the root in the z plane.
+ */
+		cnum.r = 1 + C * r.r;
+		cnum.i = C * r.i;
+		cden.r = 1 - C * r.r;
+		cden.i = -C * r.i;
+		jt += 1;
+		torch_cephes_cdiv( &cden, &cnum, &z[jt] );
+		if( r.i != 0.0 )
+			{
+		/* fill in complex conjugate root */
+			jt += 1;
+			z[jt].r = z[jt-1 ].r;
+			z[jt].i = -z[jt-1 ].i;
+			}
+		break;
+
+		case 2:
+		case 4:
+/* Substitute  s - r  =>  s/wc - r
+ *
+ *     z^2 - 2 z cgam + 1
+ * =>  ------------------  -  r
+ *         (z^2 + 1) wc
+ *
+ *         1
+ * =  ------------  [ (1 - r wc) z^2  - 2 cgam z  +  1 + r wc ]
+ *    (z^2 + 1) wc
+ *
+ * and solve for the roots in the z plane.
+ */
+		if( s->kind == 2 )
+			cwc.r = s->cbp;
+		else
+			cwc.r = s->c;
+		cwc.i = 0.0;
+		torch_cephes_cmul( &r, &cwc, &cnum );     /* r wc */
+		torch_cephes_csub( &cnum, &torch_cephes_cone, &ca );   /* a = 1 - r wc */
+		torch_cephes_cmul( &cnum, &cnum, &b4ac ); /* 1 - (r wc)^2 */
+		torch_cephes_csub( &b4ac, &torch_cephes_cone, &b4ac );
+		b4ac.r *= 4.0;               /* 4ac */
+		b4ac.i *= 4.0;
+		cb.r = -2.0 * s->cgam;          /* b */
+		cb.i = 0.0;
+		torch_cephes_cmul( &cb, &cb, &cnum );     /* b^2 */
+		torch_cephes_csub( &b4ac, &cnum, &b4ac ); /* b^2 - 4 ac */
+		torch_cephes_csqrt( &b4ac, &b4ac );
+		cb.r = -cb.r;  /* -b */
+		cb.i = -cb.i;
+		ca.r *= 2.0; /* 2a */
+		ca.i *= 2.0;
+		torch_cephes_cadd( &b4ac, &cb, &cnum );   /* -b + sqrt( b^2 - 4ac) */
+		torch_cephes_cdiv( &ca, &cnum, &cnum );   /* ... /2a */
+		jt += 1;
+		torch_cephes_cmov( &cnum, &z[jt] );
+		if( cnum.i != 0.0 )
+			{
+			jt += 1;
+			z[jt].r = cnum.r;
+			z[jt].i = -cnum.i;
+			}
+		if( (r.i != 0.0) || (cnum.i == 0) )
+			{
+			torch_cephes_csub( &b4ac, &cb, &cnum );  /* -b - sqrt( b^2 - 4ac) */
+			torch_cephes_cdiv( &ca, &cnum, &cnum );  /* ... /2a */
+			jt += 1;
+			torch_cephes_cmov( &cnum, &z[jt] );
+			if( cnum.i != 0.0 )
+				{
+				jt += 1;
+				z[jt].r = cnum.r;
+				z[jt].i = -cnum.i;
+				}
+			}
+		} /* end switch */
+	}
+	while( --nc > 0 );
+
+if( icnt == 0 )
+	{
+	s->zord = jt+1;
+	if( s->nz <= 0 )
+		break;
+	}
+nc = s->nz;
+} /* end for() loop */
+s->jt = jt;
+}
+
+
+
+
+static void zplnb( s )
+ellfstate *s;
+{
+double y[ARRSIZ];
+double *aa, *pp, a, b, gam, ai, cng, pn, an;
+cmplx *z;
+int i, j, jj, jh, jl, mh, jt, zord, icnt;
+
+aa = s->aa;
+pp = s->pp;
+z = s->z;
+jt = s->jt;
+zord = s->zord;
+
+if( s->kind != 3 )
+	{ /* Butterworth or Chebyshev */
+/* generate the remaining zeros */
+	while( 2*zord - 1 > jt )
+		{
+		if( s->type != 3 )
+			{
+			jt += 1;
+			z[jt].r = -1.0; /* zero at Nyquist frequency */
+			z[jt].i = 0.0;
+			}
+		if( (s->type == 2) || (s->type == 3) )
+			{
+			jt += 1;
+			z[jt].r = 1.0; /* zero at 0 Hz */
+			z[jt].i = 0.0;
+			}
+		}
+	}
+else
+	{ /* elliptic */
+	while( 2*zord - 1 > jt )
+		{
+		jt += 1;
+		z[jt].r = -1.0; /* zero at Nyquist frequency */
+		z[jt].i = 0.0;
+		if( (s->type == 2) || (s->type == 4) )
+			{
+			jt += 1;
+			z[jt].r = 1.0; /* zero at 0 Hz */
+			z[jt].i = 0.0;
+			}
+		}
+	}
+
+/* Expand the poles and zeros into numerator and
+ * denominator polynomials
+ */
+for( icnt=0; icnt<2; icnt++ )
+	{
+	for( j=0; j<ARRSIZ; j++ )
+		{
+		pp[j] = 0.0;
+		y[j] = 0.0;
+		}
+	pp[0] = 1.0;
+	for( j=0; j<zord; j++ )
+		{
+		jj = j;
+		if( icnt )
+			jj += zord;
+		a = z[jj].r;
+		b = z[jj].i;
+		for( i=0; i<=j; i++ )
+			{
+			jh = j - i;
+			pp[jh+1] = pp[jh+1] - a * pp[jh] + b * y[jh];
+			y[jh+1] =  y[jh+1]  - b * pp[jh] - a * y[jh];
+			}
+		}
+	if( icnt == 0 )
+		{
+		for( j=0; j<=zord; j++ )
+			aa[j] = pp[j];
+		}
+	}
+/* Scale factors of the pole and zero polynomials */
+a = 1.0;
+pn = 1.0;
+an = 1.0;
+switch( s->type )
+	{
+	case 3:
+	a = -1.0;
+	/* FALLTHROUGH */
+
+	case 1:
+	case 4:
+
+	pn = 1.0;
+	an = 1.0;
+	for( j=1; j<=zord; j++ )
+		{
+		pn = a * pn + pp[j];
+		an = a * an + aa[j];
+		}
+	break;
+
+	case 2:
+	gam = PI/2.0 - torch_cephes_asin( s->cgam );  /* = acos( cgam ) */
+	mh = zord/2;
+	pn = pp[mh];
+	an = aa[mh];
+	ai = 0.0;
+	if( mh > ((zord/4)*2) )
+		{
+		ai = 1.0;
+		pn = 0.0;
+		an = 0.0;
+		}
+	for( j=1; j<=mh; j++ )
+		{
+		a = gam * j - ai * PI / 2.0;
+		cng = torch_cephes_cos(a);
+		jh = mh + j;
+		jl = mh - j;
+		pn = pn + cng * (pp[jh] + (1.0 - 2.0 * ai) * pp[jl]);
+		an = an + cng * (aa[jh] + (1.0 - 2.0 * ai) * aa[jl]);
+		}
+	}
+s->jt = jt;
+
+/* gain of zplnc() */
+s->gain = an/(pn*s->scale);
+if( (s->kind != 3) && (pn == 0) )
+	s->gain = 1.0;
+}
@@ -63,6 +63,10 @@ extern double torch_cephes_atan ( double );
 extern double torch_cephes_floor ( double );
 extern double torch_cephes_ellpe ( double );
 extern double torch_cephes_ellpk ( double );
+extern void torch_cephes_ellpe_batch ( int, double *, int, double * );
+extern void torch_cephes_ellpk_batch ( int, double *, int, double * );
+extern void torch_cephes_landen_batch ( int, double *, int, double *,
+	double *, double *, double * );
 double torch_cephes_ellie ( double, double );
 #else
 double torch_cephes_sqrt(), torch_cephes_fabs(), torch_cephes_log(),
@@ -70,7 +74,10 @@ double torch_cephes_sqrt(), torch_cephes_fabs(), torch_cephes_log(),
     torch_cephes_floor();
 double torch_cephes_ellpe(), torch_cephes_ellpk(),
     torch_cephes_ellie();
+void torch_cephes_ellpe_batch(), torch_cephes_ellpk_batch(),
+    torch_cephes_landen_batch();
 #endif
+extern double torch_cephes_MAXNUM;
 
 double torch_cephes_ellie( phi, m )
 double phi, m;
@@ -150,3 +157,154 @@ if( sign < 0 )
 temp += npio2 * E;
 return( temp );
 }
+
+
+
+/*							ellie_batch()
+ *
+ *	Incomplete elliptic integral of the second kind of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sp, sm;
+ * double phi[], m[], y[n];
+ *
+ * ellie_batch( n, phi, sp, m, sm, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to ellie( phi[i*sp], m[i*sm] ).  A stride of 0
+ * broadcasts the first value to the whole batch.
+ *
+ * The amplitudes of a chunk are reduced as by ellie(), then
+ * go through landen_batch() together, and E(m) and K(m) through
+ * ellpe_batch() and ellpk_batch().  When m is broadcast, the
+ * means of the iteration, E(m) and K(m) are computed once for
+ * the chunk.  The chunks are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as ellie().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As ellie().
+ *
+ */
+
+#define CHUNK 256
+
+void torch_cephes_ellie_batch( n, phi, sp, m, sm, y )
+int n, sp, sm;
+double *phi, *m, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double ph[CHUNK], t[CHUNK], f[CHUNK], s[CHUNK], mm[CHUNK];
+	double E[CHUNK], K[CHUNK], tr[CHUNK];
+	double pj, mj, a, b, e, tj, Em, Km, temp;
+	int pos[CHUNK], npio2[CHUNK], flag[CHUNK];
+	int j, k, nc, nl, np;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nl = 0;
+	Em = Km = 0.0;
+	if( sm == 0 && m[0] != 0.0 && m[0] != 1.0 )
+		{
+		Em = torch_cephes_ellpe( 1.0 - m[0] );
+		Km = torch_cephes_ellpk( 1.0 - m[0] );
+		}
+	for( j=0; j<nc; j++ )
+		{
+		pj = phi[(i+j)*sp];
+		mj = m[(i+j)*sm];
+		if( mj == 0.0 )
+			{
+			y[i+j] = pj;
+			continue;
+			}
+		a = 1.0 - mj;
+		if( a == 0.0 || !(torch_cephes_fabs(pj) <= torch_cephes_MAXNUM) )
+			{
+			y[i+j] = torch_cephes_ellie( pj, mj );
+			continue;
+			}
+		np = torch_cephes_floor( pj/torch_cephes_PIO2 );
+		if( np & 1 )
+			np += 1;
+		pj = pj - np * torch_cephes_PIO2;
+		flag[nl] = 0;
+		if( pj < 0.0 )
+			{
+			pj = -pj;
+			flag[nl] = 1;
+			}
+		tj = torch_cephes_tan( pj );
+		b = torch_cephes_sqrt(a);
+		if( torch_cephes_fabs(tj) > 10.0 )
+			{
+			/* Transform the amplitude, as ellie() */
+			e = 1.0/(b*tj);
+			if( torch_cephes_fabs(e) < 10.0 )
+				{
+				e = torch_cephes_atan(e);
+				tr[nl] = mj * torch_cephes_sin( pj ) * torch_cephes_sin( e );
+				tj = torch_cephes_tan( e );
+				if( !(e >= 0.0 && e < torch_cephes_PIO2)
+					|| torch_cephes_fabs(tj) > 10.0 )
+					{
+					y[i+j] = torch_cephes_ellie( phi[(i+j)*sp], mj );
+					continue;
+					}
+				pj = e;
+				flag[nl] |= 2;
+				}
+			}
+		pos[nl] = j;
+		npio2[nl] = np;
+		ph[nl] = pj;
+		t[nl] = tj;
+		mm[nl] = mj;
+		E[nl] = a;
+		nl += 1;
+		}
+
+	if( sm == 0 )
+		{
+		for( k=0; k<nl; k++ )
+			{
+			E[k] = Em;
+			K[k] = Km;
+			}
+		}
+	else
+		{
+		torch_cephes_ellpk_batch( nl, E, 1, K );
+		torch_cephes_ellpe_batch( nl, E, 1, E );
+		}
+	torch_cephes_landen_batch( nl, sm == 0 ? &m[0] : mm, sm == 0 ? 0 : 1,
+		ph, t, f, s );
+
+	for( k=0; k<nl; k++ )
+		{
+		temp = E[k] / K[k];
+		temp *= f[k];
+		temp += s[k];
+		if( flag[k] & 2 )
+			temp = E[k] + tr[k] - temp;
+		if( flag[k] & 1 )
+			temp = -temp;
+		temp += npio2[k] * E[k];
+		y[i+pos[k]] = temp;
+		}
+	}
+}
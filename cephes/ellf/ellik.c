@@ -58,16 +58,20 @@ Copyright 1984, 1987, 2000 by Stephen L. Moshier
 extern double torch_cephes_sqrt ( double );
 extern double torch_cephes_fabs ( double );
 extern double torch_cephes_log ( double );
+extern double torch_cephes_sin ( double );
 extern double torch_cephes_tan ( double );
 extern double torch_cephes_atan ( double );
 extern double torch_cephes_floor ( double );
 extern double torch_cephes_ellpk ( double );
 double torch_cephes_ellik ( double, double );
+void torch_cephes_landen_batch ( int, double *, int, double *, double *,
+	double *, double * );
 #else
 double torch_cephes_sqrt(), torch_cephes_fabs(), torch_cephes_log(),
-    torch_cephes_tan(), torch_cephes_atan(), torch_cephes_floor(),
-    torch_cephes_ellpk();
+    torch_cephes_sin(), torch_cephes_tan(), torch_cephes_atan(),
+    torch_cephes_floor(), torch_cephes_ellpk();
 double torch_cephes_ellik();
+void torch_cephes_landen_batch();
 #endif
 extern double torch_cephes_PI, torch_cephes_PIO2, torch_cephes_MACHEP,
     torch_cephes_MAXNUM;
@@ -150,3 +154,275 @@ if( sign < 0 )
 temp += npio2 * K;
 return( temp );
 }
+
+
+
+/*							landen_batch()
+ *
+ *	Descending Landen transformation of a vector of amplitudes
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sm;
+ * double m[], phi[n], t[n], f[n], e[n];
+ *
+ * landen_batch( n, m, sm, phi, t, f, e );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Runs the arithmetic-geometric mean iteration of ellik() and
+ * ellie() on the n <= 256 amplitudes 0 <= phi[i] < pi/2, of
+ * tangents t[i] and moduli m[i*sm], and sets f[i] to the
+ * integral of the first kind over sqrt(1 - m) K(m).  If e is
+ * not null, e[i] gets the sum of the c sin(phi) terms of the
+ * integral of the second kind.  phi[] and t[] are overwritten.
+ *
+ * The iteration count depends on m only.  With distinct moduli
+ * (sm = 1) each element runs until its own convergence and
+ * leaves the set of active elements then.  With a shared
+ * modulus (sm = 0) the means are computed once and the
+ * amplitudes of all the elements are advanced together.
+ * The arithmetic is that of ellik() and ellie().
+ *
+ */
+
+#define CHUNK 256
+#define NLANDEN 64
+
+void torch_cephes_landen_batch( n, m, sm, phi, t, f, e )
+int n, sm;
+double *m, *phi, *t, *f, *e;
+{
+double a[CHUNK], b[CHUNK], c[CHUNK];
+double tk[NLANDEN], ck[NLANDEN], temp, ak, bk;
+int d[CHUNK], mod[CHUNK], act[CHUNK];
+int j, k, q, nk, na, dk;
+
+for( j=0; j<n; j++ )
+	{
+	mod[j] = 0;
+	if( e )
+		e[j] = 0.0;
+	}
+
+if( sm == 0 )
+	{
+	/* The means, once */
+	ak = 1.0;
+	bk = torch_cephes_sqrt( 1.0 - m[0] );
+	temp = torch_cephes_sqrt( m[0] );
+	dk = 1;
+	nk = 0;
+	while( torch_cephes_fabs(temp/ak) > torch_cephes_MACHEP && nk < NLANDEN )
+		{
+		tk[nk] = bk/ak;
+		ck[nk] = ( ak - bk )/2.0;
+		temp = torch_cephes_sqrt( ak * bk );
+		ak = ( ak + bk )/2.0;
+		bk = temp;
+		temp = ck[nk];
+		dk += dk;
+		nk += 1;
+		}
+	if( nk < NLANDEN )
+		{
+		for( k=0; k<nk; k++ )
+			{
+			for( j=0; j<n; j++ )
+				{
+				phi[j] = phi[j] + torch_cephes_atan(t[j]*tk[k])
+					+ mod[j] * torch_cephes_PI;
+				mod[j] = (phi[j] + torch_cephes_PIO2)/torch_cephes_PI;
+				t[j] = t[j] * ( 1.0 + tk[k] )/( 1.0 - tk[k] * t[j] * t[j] );
+				}
+			if( e )
+				for( j=0; j<n; j++ )
+					e[j] += ck[k] * torch_cephes_sin(phi[j]);
+			}
+		for( j=0; j<n; j++ )
+			f[j] = (torch_cephes_atan(t[j]) + mod[j] * torch_cephes_PI)/(dk * ak);
+		return;
+		}
+	}
+
+/* Each element until its convergence */
+for( j=0; j<n; j++ )
+	{
+	a[j] = 1.0;
+	b[j] = torch_cephes_sqrt( 1.0 - m[j*sm] );
+	c[j] = torch_cephes_sqrt( m[j*sm] );
+	d[j] = 1;
+	act[j] = j;
+	}
+na = n;
+while( na > 0 )
+	{
+	k = 0;
+	for( q=0; q<na; q++ )
+		{
+		j = act[q];
+		if( torch_cephes_fabs(c[j]/a[j]) > torch_cephes_MACHEP )
+			act[k++] = j;
+		}
+	na = k;
+	for( q=0; q<na; q++ )
+		{
+		j = act[q];
+		temp = b[j]/a[j];
+		phi[j] = phi[j] + torch_cephes_atan(t[j]*temp) + mod[j] * torch_cephes_PI;
+		mod[j] = (phi[j] + torch_cephes_PIO2)/torch_cephes_PI;
+		t[j] = t[j] * ( 1.0 + temp )/( 1.0 - temp * t[j] * t[j] );
+		c[j] = ( a[j] - b[j] )/2.0;
+		temp = torch_cephes_sqrt( a[j] * b[j] );
+		a[j] = ( a[j] + b[j] )/2.0;
+		b[j] = temp;
+		d[j] += d[j];
+		if( e )
+			e[j] += c[j] * torch_cephes_sin(phi[j]);
+		}
+	}
+for( j=0; j<n; j++ )
+	f[j] = (torch_cephes_atan(t[j]) + mod[j] * torch_cephes_PI)/(d[j] * a[j]);
+}
+
+
+
+/*							ellik_batch()
+ *
+ *	Incomplete elliptic integral of the first kind of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sp, sm;
+ * double phi[], m[], y[n];
+ *
+ * ellik_batch( n, phi, sp, m, sm, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to ellik( phi[i*sp], m[i*sm] ).  A stride of 0
+ * broadcasts the first value to the whole batch.
+ *
+ * The amplitudes of a chunk are reduced as by ellik(), then
+ * go through landen_batch() together.  When m is broadcast, the
+ * means of the iteration and K(m) are computed once for the
+ * chunk.  The chunks are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as ellik().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As ellik().
+ *
+ */
+
+void torch_cephes_ellik_batch( n, phi, sp, m, sm, y )
+int n, sp, sm;
+double *phi, *m, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double ph[CHUNK], t[CHUNK], f[CHUNK], mm[CHUNK], K[CHUNK];
+	double pj, mj, a, b, e, tj, Km, temp;
+	int pos[CHUNK], npio2[CHUNK], flag[CHUNK];
+	int j, k, nc, nl, np;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nl = 0;
+	Km = -1.0;
+	for( j=0; j<nc; j++ )
+		{
+		pj = phi[(i+j)*sp];
+		mj = m[(i+j)*sm];
+		if( mj == 0.0 )
+			{
+			y[i+j] = pj;
+			continue;
+			}
+		a = 1.0 - mj;
+		if( a == 0.0 || !(torch_cephes_fabs(pj) <= torch_cephes_MAXNUM) )
+			{
+			y[i+j] = torch_cephes_ellik( pj, mj );
+			continue;
+			}
+		np = torch_cephes_floor( pj/torch_cephes_PIO2 );
+		if( np & 1 )
+			np += 1;
+		K[nl] = 0.0;
+		if( np )
+			{
+			if( sm == 0 && Km < 0.0 )
+				Km = torch_cephes_ellpk( a );
+			K[nl] = sm == 0 ? Km : torch_cephes_ellpk( a );
+			pj = pj - np * torch_cephes_PIO2;
+			}
+		flag[nl] = 0;
+		if( pj < 0.0 )
+			{
+			pj = -pj;
+			flag[nl] = 1;
+			}
+		b = torch_cephes_sqrt(a);
+		tj = torch_cephes_tan( pj );
+		if( torch_cephes_fabs(tj) > 10.0 )
+			{
+			/* Transform the amplitude, as ellik() */
+			e = 1.0/(b*tj);
+			if( torch_cephes_fabs(e) < 10.0 )
+				{
+				e = torch_cephes_atan(e);
+				tj = torch_cephes_tan( e );
+				if( !(e >= 0.0 && e < torch_cephes_PIO2)
+					|| torch_cephes_fabs(tj) > 10.0 )
+					{
+					y[i+j] = torch_cephes_ellik( phi[(i+j)*sp], mj );
+					continue;
+					}
+				if( np == 0 )
+					{
+					if( sm == 0 && Km < 0.0 )
+						Km = torch_cephes_ellpk( a );
+					K[nl] = sm == 0 ? Km : torch_cephes_ellpk( a );
+					}
+				pj = e;
+				flag[nl] |= 2;
+				}
+			}
+		pos[nl] = j;
+		npio2[nl] = np;
+		ph[nl] = pj;
+		t[nl] = tj;
+		mm[nl] = mj;
+		nl += 1;
+		}
+
+	torch_cephes_landen_batch( nl, sm == 0 ? &m[0] : mm, sm == 0 ? 0 : 1,
+		ph, t, f, (double *) 0 );
+
+	for( k=0; k<nl; k++ )
+		{
+		temp = f[k];
+		if( flag[k] & 2 )
+			temp = K[k] - temp;
+		if( flag[k] & 1 )
+			temp = -temp;
+		temp += npio2[k] * K[k];
+		y[i+pos[k]] = temp;
+		}
+	}
+}
@@ -176,8 +176,13 @@ static unsigned short Q[] = {
 #ifdef ANSIPROT
 extern double torch_cephes_polevl ( double, void *, int );
 extern double torch_cephes_log ( double );
+extern void torch_cephes_polevl_batch ( int, double *, double *, int,
+	double * );
+double torch_cephes_ellpe ( double );
 #else
 double torch_cephes_polevl(), torch_cephes_log();
+void torch_cephes_polevl_batch();
+double torch_cephes_ellpe();
 #endif
 
 double torch_cephes_ellpe(x)
@@ -194,3 +199,76 @@ if( (x <= 0.0) || (x > 1.0) )
 return( torch_cephes_polevl(x,P,10) - torch_cephes_log(x) *
         (x * torch_cephes_polevl(x,Q,9)) );
 }
+
+
+
+/*							ellpe_batch()
+ *
+ *	Complete elliptic integral of the second kind of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx;
+ * double m1[], y[n];
+ *
+ * ellpe_batch( n, m1, sx, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to ellpe( m1[i*sx] ).  A stride of 0 broadcasts the
+ * first value to the whole batch.
+ *
+ * The two polynomials are evaluated by polevl_batch() for all
+ * the elements of a chunk in 0 < m1 <= 1; the others go to
+ * ellpe().  The chunks are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as ellpe().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As ellpe().
+ *
+ */
+
+#define CHUNK 256
+
+void torch_cephes_ellpe_batch( n, x, sx, y )
+int n, sx;
+double *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double w[CHUNK], p[CHUNK], q[CHUNK], xj;
+	int pos[CHUNK];
+	int j, k, nc, nw;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nw = 0;
+	for( j=0; j<nc; j++ )
+		{
+		xj = x[(i+j)*sx];
+		if( xj > 0.0 && xj <= 1.0 )
+			{
+			pos[nw] = j;
+			w[nw++] = xj;
+			}
+		else
+			y[i+j] = torch_cephes_ellpe( xj );
+		}
+	torch_cephes_polevl_batch( nw, w, (double *) P, 10, p );
+	torch_cephes_polevl_batch( nw, w, (double *) Q, 9, q );
+	for( k=0; k<nw; k++ )
+		y[i+pos[k]] = p[k] - torch_cephes_log(w[k]) * (w[k] * q[k]);
+	}
+}
@@ -73,11 +73,16 @@ extern double torch_cephes_sinh ( double );
 extern double torch_cephes_cosh ( double );
 extern double torch_cephes_atan ( double );
 extern double torch_cephes_exp ( double );
+int torch_cephes_ellpj ( double, double, double *, double *, double *,
+	double * );
+static int agmscale ( double, double *, double *, double * );
 #else
 double torch_cephes_sqrt(), torch_cephes_fabs(), torch_cephes_sin(),
     torch_cephes_cos(), torch_cephes_asin(), torch_cephes_tanh();
 double torch_cephes_sinh(), torch_cephes_cosh(), torch_cephes_atan(),
     torch_cephes_exp();
+int torch_cephes_ellpj();
+static int agmscale();
 #endif
 extern double torch_cephes_PIO2, torch_cephes_MACHEP;
 
@@ -92,7 +97,7 @@ int i;
 
 /* Check for special cases */
 
-if( m < 0.0 || m > 1.0 )
+if( !(m >= 0.0 && m <= 1.0) )
 	{
 	torch_cephes_mtherr( "ellpj", DOMAIN );
 	*sn = 0.0;
@@ -172,3 +177,153 @@ t = torch_cephes_cos(phi);
 *ph = phi;
 return(0);
 }
+
+
+
+/*							ellpj_batch()
+ *
+ *	Jacobian elliptic functions of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, su, sm;
+ * double u[], m[], sn[n], cn[n], dn[n], ph[n];
+ *
+ * ellpj_batch( n, u, su, m, sm, sn, cn, dn, ph );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets sn[i], cn[i], dn[i] and ph[i] to the results of
+ * ellpj( u[i*su], m[i*sm], ... ).  A stride of 0 broadcasts
+ * the first value to the whole batch.
+ *
+ * The A. G. M. scale depends on m only: it is computed once for
+ * each run of equal moduli in a chunk, which is once per chunk
+ * when m is broadcast.  The elements of each run then go through
+ * the backward recurrence together.  The moduli within 1e-9 of
+ * 0 or 1, and those out of range, go to ellpj().  The chunks
+ * are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as ellpj().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As ellpj(); the overflow of the A. G. M. scale is reported
+ * once per run of equal moduli.
+ *
+ */
+
+#define CHUNK 256
+
+/* A. G. M. scale of ellpj(): sets a[0..i], c[0..i] and twon, and
+   returns i  */
+static int agmscale( m, a, c, twon )
+double m;
+double *a, *c, *twon;
+{
+double ai, b, t;
+int i;
+
+a[0] = 1.0;
+b = torch_cephes_sqrt(1.0 - m);
+c[0] = torch_cephes_sqrt(m);
+*twon = 1.0;
+i = 0;
+
+while( torch_cephes_fabs(c[i]/a[i]) > torch_cephes_MACHEP )
+	{
+	if( i > 7 )
+		{
+		torch_cephes_mtherr( "ellpj", OVERFLOW );
+		break;
+		}
+	ai = a[i];
+	++i;
+	c[i] = ( ai - b )/2.0;
+	t = torch_cephes_sqrt( ai * b );
+	a[i] = ( ai + b )/2.0;
+	b = t;
+	*twon *= 2.0;
+	}
+return(i);
+}
+
+
+void torch_cephes_ellpj_batch( n, u, su, m, sm, sn, cn, dn, ph )
+int n, su, sm;
+double *u, *m, *sn, *cn, *dn, *ph;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double a[CHUNK][9], c[CHUNK][9], twon[CHUNK];
+	double phi[CHUNK], b[CHUNK], mj, ml, t, ak, ck;
+	int steps[CHUNK], pos[CHUNK], start[CHUNK+1];
+	int j, k, l, p, nc, ng, np;
+
+	/* The elements of run k go to pos[start[k]], ...,
+	   pos[start[k+1]-1]  */
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	ng = 0;
+	np = 0;
+	ml = 0.0;
+	for( j=0; j<nc; j++ )
+		{
+		mj = m[(i+j)*sm];
+		if( !(mj >= 1.0e-9 && mj < 0.9999999999) )
+			{
+			torch_cephes_ellpj( u[(i+j)*su], mj, &sn[i+j], &cn[i+j],
+				&dn[i+j], &ph[i+j] );
+			continue;
+			}
+		if( ng == 0 || mj != ml )
+			{
+			steps[ng] = agmscale( mj, a[ng], c[ng], &twon[ng] );
+			start[ng] = np;
+			ml = mj;
+			ng += 1;
+			}
+		pos[np++] = j;
+		}
+	start[ng] = np;
+
+	/* backward recurrence */
+	for( k=0; k<ng; k++ )
+		{
+		l = steps[k];
+		for( p=start[k]; p<start[k+1]; p++ )
+			phi[p] = twon[k] * a[k][l] * u[(i+pos[p])*su];
+		for( ; l>0; l-- )
+			{
+			ck = c[k][l];
+			ak = a[k][l];
+			for( p=start[k]; p<start[k+1]; p++ )
+				{
+				t = ck * torch_cephes_sin(phi[p]) / ak;
+				b[p] = phi[p];
+				phi[p] = (torch_cephes_asin(t) + phi[p])/2.0;
+				}
+			}
+		}
+
+	for( p=0; p<start[ng]; p++ )
+		{
+		j = i + pos[p];
+		sn[j] = torch_cephes_sin(phi[p]);
+		t = torch_cephes_cos(phi[p]);
+		cn[j] = t;
+		dn[j] = t/torch_cephes_cos(phi[p]-b[p]);
+		ph[j] = phi[p];
+		}
+	}
+}
@@ -200,8 +200,13 @@ static double C1 = 1.3862943611198906188E0; /* log(4) */
 extern double torch_cephes_polevl ( double, void *, int );
 extern double torch_cephes_p1evl ( double, void *, int );
 extern double torch_cephes_log ( double );
+extern void torch_cephes_polevl_batch ( int, double *, double *, int,
+	double * );
+double torch_cephes_ellpk ( double );
 #else
 double torch_cephes_polevl(), torch_cephes_p1evl(), torch_cephes_log();
+void torch_cephes_polevl_batch();
+double torch_cephes_ellpk();
 #endif
 extern double torch_cephes_MACHEP, torch_cephes_MAXNUM;
 
@@ -233,3 +238,77 @@ else
 		}
 	}
 }
+
+
+
+/*							ellpk_batch()
+ *
+ *	Complete elliptic integral of the first kind of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx;
+ * double m1[], y[n];
+ *
+ * ellpk_batch( n, m1, sx, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to ellpk( m1[i*sx] ).  A stride of 0 broadcasts the
+ * first value to the whole batch.
+ *
+ * The two polynomials are evaluated by polevl_batch() for all
+ * the elements of a chunk in the interval of the approximation;
+ * the others go to ellpk().  The chunks are evaluated in
+ * parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as ellpk().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As ellpk().
+ *
+ */
+
+#define CHUNK 256
+
+void torch_cephes_ellpk_batch( n, x, sx, y )
+int n, sx;
+double *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double w[CHUNK], p[CHUNK], q[CHUNK], xj;
+	int pos[CHUNK];
+	int j, k, nc, nw;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	nw = 0;
+	for( j=0; j<nc; j++ )
+		{
+		xj = x[(i+j)*sx];
+		if( xj > torch_cephes_MACHEP && xj <= 1.0 )
+			{
+			pos[nw] = j;
+			w[nw++] = xj;
+			}
+		else
+			y[i+j] = torch_cephes_ellpk( xj );
+		}
+	torch_cephes_polevl_batch( nw, w, (double *) P, 10, p );
+	torch_cephes_polevl_batch( nw, w, (double *) Q, 10, q );
+	for( k=0; k<nw; k++ )
+		y[i+pos[k]] = p[k] - torch_cephes_log(w[k]) * q[k];
+	}
+}
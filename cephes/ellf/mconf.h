@@ -197,3 +197,11 @@ int torch_cephes_mtherr();
 
 /* Variable for error reporting.  See mtherr.c.  */
 extern int torch_cephes_merror;
+
+/* Function of the wrapped call in progress in this thread, see
+ * torch_stats.c.  Parallel regions start their threads with the
+ * value of the calling one by copyin(torch_cephes_stats_id).  */
+extern int torch_cephes_stats_id;
+#ifdef _OPENMP
+#pragma omp threadprivate(torch_cephes_stats_id)
+#endif
@@ -0,0 +1,127 @@
+/*							sosfilt.c
+ *
+ *	Streaming IIR filter of second order sections
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int ns, sc, nch, nt;
+ * double sos[6*ns], x[nt*nch], y[nt*nch], z[2*ns*nch];
+ * void sosfilt();
+ *
+ * sosfilt( ns, sos, sc, nch, nt, x, y, z );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Filters nt samples of each of nch channels through the
+ * cascade of ns second order sections
+ *
+ *           b0 + b1 z^-1 + b2 z^-2
+ *   H (z) = ----------------------
+ *    s      1  + a1 z^-1 + a2 z^-2
+ *
+ * of six coefficients b0 b1 b2 a0 a1 a2 each, a0 = 1, as
+ * ellf_sos() returns them; a0 itself is not read.  The signal
+ * is interleaved: sample t of channel c is x[t*nch + c], and
+ * the result goes to y in the same layout; y may be x.
+ *
+ * If sc is 0 all the channels share the sections sos[6*s + k].
+ * If sc is 1 each channel has its own: coefficient k of section
+ * s of channel c is sos[(6*s + k)*nch + c].
+ *
+ * The sections are in transposed direct form II, with two
+ * state variables per section and channel, z[2*s*nch + c] and
+ * z[(2*s+1)*nch + c].  They are updated in place, so that
+ * filtering a stream block after block gives the result of a
+ * single call on the whole stream.  Zero them to start a new
+ * stream.
+ *
+ * The inner loop runs across the channels of a sample, in
+ * vectors where the compiler can, and blocks of channels go to
+ * different threads.
+ *
+ */
+
+/*
+Cephes Math Library Release 2.8:  June, 2000
+Copyright 1984, 1987, 2000 by Stephen L. Moshier
+*/
+
+#include "mconf.h"
+
+#define CHUNK 256
+
+#ifdef ANSIPROT
+void torch_cephes_sosfilt ( int, double *, int, int, int, double *,
+	double *, double * );
+#else
+void torch_cephes_sosfilt();
+#endif
+
+void torch_cephes_sosfilt( ns, sos, sc, nch, nt, x, y, z )
+int ns, sc, nch, nt;
+double *sos, *x, *y, *z;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<nch; i+=CHUNK )
+	{
+	double v[CHUNK], w;
+	double b0, b1, b2, a1, a2;
+	double *xt, *yt, *z1, *z2, *c0, *c1, *c2, *c4, *c5;
+	int c, nc, s, t;
+
+	nc = nch - i < CHUNK ? nch - i : CHUNK;
+	for( t=0; t<nt; t++ )
+		{
+		xt = x + (long) t * nch + i;
+		yt = y + (long) t * nch + i;
+		for( c=0; c<nc; c++ )
+			v[c] = xt[c];
+		for( s=0; s<ns; s++ )
+			{
+			z1 = z + (long) 2 * s * nch + i;
+			z2 = z1 + nch;
+			if( sc == 0 )
+				{
+				b0 = sos[6*s];
+				b1 = sos[6*s+1];
+				b2 = sos[6*s+2];
+				a1 = sos[6*s+4];
+				a2 = sos[6*s+5];
+				for( c=0; c<nc; c++ )
+					{
+					w = b0 * v[c] + z1[c];
+					z1[c] = b1 * v[c] - a1 * w + z2[c];
+					z2[c] = b2 * v[c] - a2 * w;
+					v[c] = w;
+					}
+				}
+			else
+				{
+				c0 = sos + (long) 6 * s * nch + i;
+				c1 = c0 + nch;
+				c2 = c1 + nch;
+				c4 = c2 + 2 * nch;
+				c5 = c4 + nch;
+				/* sos, z and v never overlap, but there are more pointers
+				 * than the compiler checks for aliasing */
+#pragma omp simd private(w)
+				for( c=0; c<nc; c++ )
+					{
+					w = c0[c] * v[c] + z1[c];
+					z1[c] = c1[c] * v[c] - c4[c] * w + z2[c];
+					z2[c] = c2[c] * v[c] - c5[c] * w;
+					v[c] = w;
+					}
+				}
+			}
+		for( c=0; c<nc; c++ )
+			yt[c] = v[c];
+		}
+	}
+}
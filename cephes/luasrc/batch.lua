@@ -0,0 +1,152 @@
+-- Argument handling shared by the wrappers of the native batch kernels.
+--
+-- Batch kernels take, for each parameter, a pointer to contiguous doubles
+-- and a stride: 1 when the parameter has one value per element of the
+-- batch, 0 when a single value is broadcast to the whole batch. They
+-- write their results to contiguous double arrays.
+
+--[[! Prepare one parameter of a batch kernel
+
+@param param number, or tensor with either 1 or N elements
+@param N number of elements of the batch
+@param index position of the parameter, for error messages
+
+@return tensor holding the values (keep it referenced during the call)
+@return double * to its first element
+@return stride of the parameter, 0 if broadcast and 1 otherwise
+--]]
+function cephes._batchParam(param, N, index)
+    local tensor
+    if type(param) == 'number' or type(param) == 'cdata' then
+        tensor = torch.DoubleTensor{ tonumber(param) }
+    elseif torch.isTensor(param) then
+        local size = param:nElement()
+        if size ~= 1 and size ~= N then
+            error("Incoherent number of elements for parameter " .. index ..
+                  ": got " .. size .. ", expected 1 or " .. N)
+        end
+        tensor = param:double():contiguous()
+    else
+        error("Invalid type " .. type(param) .. " for parameter " .. index .. ".")
+    end
+    local stride = 1
+    if tensor:nElement() == 1 then
+        stride = 0
+    end
+    return tensor, torch.data(tensor), stride
+end
+
+--[[! Prepare the result storage of a batch kernel
+
+@param result optional tensor to store the result into, or nil
+@param N number of elements of the batch
+
+@return tensor to return to the caller
+@return contiguous DoubleTensor the kernel writes into; when it differs
+        from the first return value, copy it back with cephes._batchDone
+--]]
+function cephes._batchResult(result, N)
+    if result == nil then
+        result = torch.DoubleTensor(N)
+        return result, result
+    end
+    if not torch.isTensor(result) then
+        error("Invalid type " .. type(result) .. " for result")
+    end
+    if result:nElement() ~= N then
+        error("Result has " .. result:nElement() .. " elements, expected " .. N)
+    end
+    if torch.typename(result) == 'torch.DoubleTensor' and result:isContiguous() then
+        return result, result
+    end
+    return result, torch.DoubleTensor(N)
+end
+
+-- Copy the kernel output back into the caller's tensor if needed
+function cephes._batchDone(result, work)
+    if work ~= result then
+        result:copy(work)
+    end
+    return result
+end
+
+--[[! Number of elements of a batch
+
+@param ... parameters, numbers or tensors
+
+@return the number of elements of the largest tensor, or 1 if all the
+        parameters are numbers or single-element tensors
+--]]
+function cephes._batchSize(...)
+    local N = 1
+    for index = 1, select('#', ...) do
+        local param = select(index, ...)
+        if torch.isTensor(param) and param:nElement() ~= 1 then
+            N = param:nElement()
+        end
+    end
+    return N
+end
+
+--[[! Native batch kernels of the element-wise functions
+
+Maps the name of a function of cephes to the native kernel that
+evaluates it over a whole batch, with the argument convention above.
+The tensor path of the wrapper of a function uses its kernel when it
+has one, instead of calling the scalar function element by element.
+The kernels are looked up on first use, so that only the folders of
+cephes/ in use get declared.
+--]]
+local hasBatchKernel = {}
+
+for _, name in ipairs{ 'igam', 'igamc', 'gdtr', 'gdtrc',
+                       'chdtr', 'chdtrc', 'pdtr', 'pdtrc',
+                       'incbet', 'btdtr', 'bdtr', 'bdtrc', 'nbdtr', 'nbdtrc',
+                       'fdtr', 'fdtrc', 'stdtr', 'smirnov', 'kolmogorov',
+                       'zeta', 'polygamma', 'trigamma', 'lmvgam', 'mvgam',
+                       'polylog', 'spence', 'ei', 'expn',
+                       'ellpk', 'ellpe', 'ellik', 'ellie' } do
+    hasBatchKernel[name] = true
+end
+
+cephes._batchKernels = setmetatable({}, {__index = function(t, name)
+    if hasBatchKernel[name] then
+        local kernel = cephes.ffi[name .. '_batch']
+        rawset(t, name, kernel)
+        return kernel
+    end
+end})
+
+--[[! Evaluate a batch kernel on the checked arguments of a wrapper
+
+@param kernel native batch kernel
+@param result tensor to store the result into, N elements
+@param params parameter tensors, N elements each, as returned by
+       cephes._check1DParams; broadcast (zero stride) parameters are
+       passed to the kernel with stride 0
+
+@return result
+--]]
+function cephes._batchApply(kernel, result, params)
+    local N = result:nElement()
+    local args = {}
+    local keep = {}
+    for index, param in ipairs(params) do
+        local broadcast = param:dim() > 0
+        for dim = 1, param:dim() do
+            broadcast = broadcast and param:stride(dim) == 0
+        end
+        if broadcast then
+            param = param:storage()[param:storageOffset()]
+        end
+        local tensor, data, stride = cephes._batchParam(param, N, index)
+        keep[index] = tensor
+        args[2 * index - 1] = data
+        args[2 * index] = stride
+    end
+    local work
+    result, work = cephes._batchResult(result, N)
+    args[2 * #params + 1] = torch.data(work)
+    kernel(N, unpack(args, 1, 2 * #params + 1))
+    return cephes._batchDone(result, work)
+end
@@ -0,0 +1,38 @@
+-- All orders 0..N of the integer-order Bessel functions, in one pass
+-- (cephes.jn_seq and friends) against one call per order.
+-- Usage: th bench_besseq.lua [number of arguments] [N]
+require 'cephes'
+
+local X = tonumber(arg and arg[1]) or 10000
+local N = tonumber(arg and arg[2]) or 100
+
+local x = torch.linspace(0.1, 50, X)
+local result = torch.DoubleTensor(X, N + 1)
+local perOrder = torch.DoubleTensor(X)
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+print(string.format('%d arguments, orders 0..%d', X, N))
+print(string.format('%-4s %14s %14s %10s', 'fn', 'sequence (s)', 'per order (s)', 'speedup'))
+for _, name in ipairs{'jn', 'yn', 'kn'} do
+    local sequence = cephes[name .. '_seq']
+    local single = cephes[name]
+    local tSeq = bench(function() sequence(result, N, x) end)
+    local tOrder = bench(function()
+        for n = 0, N do
+            single(perOrder, n, x)
+        end
+    end)
+    print(string.format('%-4s %14.4f %14.4f %9.1fx', name, tSeq, tOrder, tOrder / tSeq))
+end
+local tSeq = bench(function() cephes.in_seq(result, N, x) end)
+local tOrder = bench(function()
+    for n = 0, N do
+        cephes.iv(perOrder, n, x)
+    end
+end)
+print(string.format('%-4s %14.4f %14.4f %9.1fx', 'in', tSeq, tOrder, tOrder / tSeq))
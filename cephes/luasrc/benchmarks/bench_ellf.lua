@@ -0,0 +1,55 @@
+-- Throughput of the incomplete elliptic integrals on tensors, in elements
+-- per second: the batch kernels of cephes.ellik and cephes.ellie against
+-- a loop of scalar calls, with one modulus per element and with a modulus
+-- shared by the batch, whose iteration is then computed once; and
+-- cephes.ellpj at a fixed modulus, whose A. G. M. scale is then computed
+-- once, against a loop of calls of the C function.
+-- Usage: th bench_ellf.lua [number of elements]
+require 'cephes'
+
+local N = tonumber(arg and arg[1]) or 100000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+local phi = torch.linspace(-5, 5, N)
+local m = torch.rand(N)
+local phidata, mdata = torch.data(phi), torch.data(m)
+local result = torch.DoubleTensor(N)
+
+print(string.format('%6s %8s %14s %14s', 'name', 'modulus', 'batch', 'scalar loop'))
+for _, name in ipairs{ 'ellik', 'ellie' } do
+    local kernel = cephes.ffi[name]
+    local batch = N / bench(function() cephes[name](result, phi, m) end)
+    local loop = N / bench(function()
+        local data = torch.data(result)
+        for i = 0, N - 1 do
+            data[i] = kernel(phidata[i], mdata[i])
+        end
+    end)
+    print(string.format('%6s %8s %14.0f %14.0f', name, 'varying', batch, loop))
+
+    batch = N / bench(function() cephes[name](result, phi, 0.7) end)
+    loop = N / bench(function()
+        local data = torch.data(result)
+        for i = 0, N - 1 do
+            data[i] = kernel(phidata[i], 0.7)
+        end
+    end)
+    print(string.format('%6s %8s %14.0f %14.0f', name, 'shared', batch, loop))
+end
+
+local sn, cn, dn, ph = torch.DoubleTensor(N), torch.DoubleTensor(N),
+                       torch.DoubleTensor(N), torch.DoubleTensor(N)
+local batch = N / bench(function() cephes.ellpj(phi, 0.7) end)
+local loop = N / bench(function()
+    local sndata, cndata = torch.data(sn), torch.data(cn)
+    local dndata, phdata = torch.data(dn), torch.data(ph)
+    for i = 0, N - 1 do
+        cephes.ffi.ellpj(phidata[i], 0.7, sndata + i, cndata + i, dndata + i, phdata + i)
+    end
+end)
+print(string.format('%6s %8s %14.0f %14.0f', 'ellpj', 'shared', batch, loop))
@@ -0,0 +1,47 @@
+-- Cost of a forward and backward pass: the fused kernels of cephes.grad
+-- against the value and the derivatives obtained from separate tensor
+-- calls, in elements per second.
+-- Usage: th bench_grad.lua [number of elements]
+require 'cephes'
+
+local N = tonumber(arg and arg[1]) or 100000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+local x = torch.linspace(0.05, 0.95, N)
+local z = torch.linspace(0.5, 30, N)
+local result = torch.DoubleTensor(N)
+local h = 1e-6
+
+-- Without a fused kernel, the parameter derivatives of igam and incbet
+-- need finite differences: one extra evaluation per parameter.
+local cases = {
+    { 'lgam', function() cephes.grad.lgam(z) end,
+      function() cephes.lgam(result, z); cephes.psi(result, z) end },
+    { 'psi', function() cephes.grad.psi(z) end,
+      function() cephes.psi(result, z); cephes.polygamma(result, 1, z) end },
+    { 'j1', function() cephes.grad.j1(z) end,
+      function() cephes.j1(result, z); cephes.j0(result, z) end },
+    { 'igam', function() cephes.grad.igam(2.5, z) end,
+      function()
+          cephes.igam(result, 2.5, z)
+          cephes.igam(result, 2.5 + h, z)
+      end },
+    { 'incbet', function() cephes.grad.incbet(2.5, 4, x) end,
+      function()
+          cephes.incbet(result, 2.5, 4, x)
+          cephes.incbet(result, 2.5 + h, 4, x)
+          cephes.incbet(result, 2.5, 4 + h, x)
+      end },
+}
+
+print(string.format('%-8s %14s %14s', 'function', 'fused', 'separate'))
+for _, case in ipairs(cases) do
+    local fused = N / bench(case[2])
+    local separate = N / bench(case[3])
+    print(string.format('%-8s %14.0f %14.0f', case[1], fused, separate))
+end
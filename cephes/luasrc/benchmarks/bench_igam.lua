@@ -0,0 +1,52 @@
+-- Throughput of the incomplete gamma family on tensors, in elements per
+-- second: shared shape parameter, one shape parameter per element, and
+-- the scalar function called element by element.
+-- Usage: th bench_igam.lua [number of elements]
+require 'cephes'
+
+local N = tonumber(arg and arg[1]) or 1000000
+
+local functions = {
+    { 'igam', 2.5 },
+    { 'igamc', 2.5 },
+    { 'gdtr', 2.5 },
+    { 'chdtr', 5 },
+    { 'pdtr', 4 },
+}
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+local x = torch.linspace(0.01, 20, N)
+local result = torch.DoubleTensor(N)
+print(string.format('%-8s %14s %14s %14s', 'function', 'constant a', 'varying a', 'scalar loop'))
+for _, f in ipairs(functions) do
+    local name, a = f[1], f[2]
+    local func = cephes[name]
+    local va = torch.linspace(a, a + 1, N)
+    local constant, varying
+    if name == 'gdtr' then
+        constant = N / bench(function() func(result, 1, a, x) end)
+        varying = N / bench(function() func(result, 1, va, x) end)
+    else
+        constant = N / bench(function() func(result, a, x) end)
+        varying = N / bench(function() func(result, va, x) end)
+    end
+
+    local scalar = cephes.ffi[name]
+    local xdata = torch.data(x)
+    local ydata = torch.data(result)
+    local loop = N / bench(function()
+        for i = 0, N - 1 do
+            if name == 'gdtr' then
+                ydata[i] = scalar(1, a, xdata[i])
+            else
+                ydata[i] = scalar(a, xdata[i])
+            end
+        end
+    end)
+    print(string.format('%-8s %14.0f %14.0f %14.0f', name, constant, varying, loop))
+end
@@ -0,0 +1,35 @@
+-- Throughput of the log multivariate gamma function on tensors, in
+-- elements per second, against the sum of p calls of lgam on the
+-- tensor it replaces. The degrees of freedom x are drawn in the domain
+-- x > (p-1)/2 of the Wishart distribution.
+-- Usage: th bench_lmvgam.lua [number of elements]
+require 'cephes'
+
+local N = tonumber(arg and arg[1]) or 100000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+local function lmvgamSum(x, p)
+    local result = torch.DoubleTensor(x:nElement()):fill(p * (p-1) / 4 * math.log(math.pi))
+    local term = torch.DoubleTensor(x:nElement())
+    for j = 1, p do
+        cephes.lgam(term, x:clone():add((1-j)/2))
+        result = result + term
+    end
+    return result
+end
+
+local result = torch.DoubleTensor(N)
+local grad = torch.DoubleTensor(N)
+print(string.format('%6s %14s %14s %14s', 'p', 'lmvgam', 'lmvgamgrad', 'lgam sum'))
+for _, p in ipairs{ 1, 8, 64, 512 } do
+    local x = torch.linspace(p / 2, p / 2 + 100, N)
+    local native = N / bench(function() cephes.lmvgam(result, x, p) end)
+    local withGrad = N / bench(function() result, grad = cephes.lmvgamgrad(x, p) end)
+    local sum = N / bench(function() lmvgamSum(x, p) end)
+    print(string.format('%6d %14.0f %14.0f %14.0f', p, native, withGrad, sum))
+end
@@ -0,0 +1,60 @@
+-- Training steps through a layer of special functions: cephes.nn modules,
+-- which evaluate the derivative with the value into buffers they reuse,
+-- against a module written on the element-wise wrappers, which allocates
+-- its output and gradInput and evaluates the derivative separately in
+-- the backward pass. Prints the steps per second over batches of B x D.
+-- Usage: th bench_nn.lua [B [D [steps]]]
+require 'cephes'
+require 'cephes.nn'
+
+local B = tonumber(arg and arg[1]) or 256
+local D = tonumber(arg and arg[2]) or 256
+local steps = tonumber(arg and arg[3]) or 20
+
+-- The module the nn integration replaces
+local Wrapped, parent = torch.class('cephes.nn.BenchWrapped', 'nn.Module', cephes.nn)
+
+function Wrapped:__init(f, df)
+    parent.__init(self)
+    self.f = f
+    self.df = df
+end
+
+function Wrapped:updateOutput(input)
+    self.output = self.f(input)
+    return self.output
+end
+
+function Wrapped:updateGradInput(input, gradOutput)
+    self.gradInput = self.df(input):cmul(gradOutput)
+    return self.gradInput
+end
+
+local function bench(module, input, gradOutput)
+    local timer = torch.Timer()
+    for _ = 1, steps do
+        module:forward(input)
+        module:backward(input, gradOutput)
+    end
+    return steps / timer:time().real
+end
+
+local input = torch.rand(B, D):add(0.1)
+local gradOutput = torch.rand(B, D)
+local layers = {
+    { 'LogGamma', cephes.nn.LogGamma(), cephes.nn.BenchWrapped(cephes.lgam, cephes.digamma) },
+    { 'BesselI0e', cephes.nn.BesselI0e(), cephes.nn.BenchWrapped(cephes.i0e,
+        function(x) return cephes.i1e(x) - cephes.i0e(x) end) },
+    { 'IncGamma', cephes.nn.IncGamma(2.5), cephes.nn.BenchWrapped(
+        function(x) return cephes.igam(2.5, x) end,
+        function(x)
+            return cephes.pow(x, 1.5):cmul(cephes.exp(-x)):div(cephes.gamma(2.5))
+        end) },
+}
+
+print(string.format('%-10s %14s %14s', 'layer', 'cephes.nn', 'wrappers'))
+for _, layer in ipairs(layers) do
+    print(string.format('%-10s %14.1f %14.1f', layer[1],
+                        bench(layer[2], input, gradOutput),
+                        bench(layer[3], input, gradOutput)))
+end
@@ -0,0 +1,44 @@
+-- Time of polmul and poldiv of polyn.c, in microseconds per call, on
+-- polynomials of random coefficients of increasing degree: the direct
+-- loops against the transforms of polfft.c, to place the crossovers that
+-- POLFFT sets: 256 coefficients for polmul, 4 times as many for poldiv.
+-- Usage: th bench_polmul.lua [repetitions]
+require 'cephes'
+local ffi = require 'ffi'
+
+local R = tonumber(arg and arg[1]) or 20
+
+local function bench(f)
+    local timer = torch.Timer()
+    for _ = 1, R do
+        f()
+    end
+    return timer:time().real / R * 1e6
+end
+
+local threshold = cephes.ffi.POLFFT
+print(string.format('%6s %12s %12s %12s %12s', 'degree', 'mul direct', 'mul fft',
+                    'div direct', 'div fft'))
+for _, n in ipairs{ 16, 32, 48, 64, 96, 128, 256, 512, 1024, 4096 } do
+    cephes.polini(2 * n)
+    local a = ffi.new('double[?]', 2 * n + 1)
+    local b = ffi.new('double[?]', 2 * n + 1)
+    local c = ffi.new('double[?]', 2 * n + 1)
+    for k = 0, n do
+        a[k] = torch.uniform(-1, 1) * 0.9 ^ k
+        b[k] = torch.uniform(-1, 1)
+    end
+    a[0] = 1
+
+    local times = {}
+    for _, t in ipairs{ 1e9, 1 } do
+        cephes.ffi.torch_cephes_POLFFT = t
+        table.insert(times, bench(function() cephes.ffi.polmul(a, n, b, n, c) end))
+    end
+    for _, t in ipairs{ 1e9, 1 } do
+        cephes.ffi.torch_cephes_POLFFT = t
+        table.insert(times, bench(function() cephes.ffi.poldiv(a, n, b, n, c) end))
+    end
+    print(string.format('%6d %12.1f %12.1f %12.1f %12.1f', n, unpack(times)))
+end
+cephes.ffi.torch_cephes_POLFFT = threshold
@@ -0,0 +1,30 @@
+-- Throughput of cephes.polroots, in polynomials per second, on batches
+-- of polynomials of random normal coefficients: the Aberth iteration of
+-- polrt_batch on the whole batch against a loop of calls of polrt.
+-- Usage: th bench_polroots.lua [number of polynomials]
+require 'cephes'
+local ffi = require 'ffi'
+
+local N = tonumber(arg and arg[1]) or 10000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+print(string.format('%6s %14s %14s', 'degree', 'batch', 'polrt loop'))
+for _, m in ipairs{ 4, 8, 16, 32 } do
+    local coef = torch.randn(N, m + 1)
+    local batch = N / bench(function() cephes.polroots(coef) end)
+
+    local cof = ffi.new('double[?]', m + 1)
+    local root = ffi.new('cmplx[?]', m)
+    local data = torch.data(coef)
+    local loop = N / bench(function()
+        for b = 0, N - 1 do
+            cephes.ffi.polrt(data + b * (m + 1), cof, m, root)
+        end
+    end)
+    print(string.format('%6d %14.0f %14.0f', m, batch, loop))
+end
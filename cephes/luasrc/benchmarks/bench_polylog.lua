@@ -0,0 +1,41 @@
+-- Throughput of the polylogarithms on tensors, in elements per second:
+-- the batch kernel of cephes.polylog against a loop of scalar calls, and
+-- cephes.polylogs, all the orders 1..n at once, against n calls of the
+-- batch kernel. The arguments cover [-1, 1), as in Fermi-Dirac integrals.
+-- Usage: th bench_polylog.lua [number of elements]
+require 'cephes'
+
+local N = tonumber(arg and arg[1]) or 100000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+local x = torch.linspace(-0.999, 0.999, N)
+local xdata = torch.data(x)
+local result = torch.DoubleTensor(N)
+
+print(string.format('%6s %14s %14s', 'order', 'batch', 'scalar loop'))
+for _, n in ipairs{ 2, 3, 5 } do
+    local batch = N / bench(function() cephes.polylog(result, n, x) end)
+    local loop = N / bench(function()
+        local data = torch.data(result)
+        for i = 0, N - 1 do
+            data[i] = cephes.ffi.polylog(n, xdata[i])
+        end
+    end)
+    print(string.format('%6d %14.0f %14.0f', n, batch, loop))
+end
+
+print(string.format('%6s %14s %14s', 'orders', 'polylogs', 'batch calls'))
+for _, n in ipairs{ 3, 6, 12 } do
+    local orders = N / bench(function() cephes.polylogs(n, x) end)
+    local calls = N / bench(function()
+        for k = 1, n do
+            cephes.polylog(result, k, x)
+        end
+    end)
+    print(string.format('%6d %14.0f %14.0f', n, orders, calls))
+end
@@ -0,0 +1,35 @@
+-- Throughput of cephes.polyval, in millions of points per second, on
+-- batches of polynomials of random coefficients with their own random
+-- points: poleva_batch on the whole batch against a loop of calls of
+-- poleva, one per point.
+-- Usage: th bench_polyval.lua [number of points per polynomial]
+require 'cephes'
+local ffi = require 'ffi'
+
+local N = tonumber(arg and arg[1]) or 100000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+print(string.format('%6s %6s %14s %14s', 'polys', 'degree', 'polyval', 'poleva loop'))
+for _, case in ipairs{ { 1, 4 }, { 1, 16 }, { 64, 4 }, { 64, 16 } } do
+    local B, m = case[1], case[2]
+    local coef = torch.randn(B, m + 1)
+    local x = torch.randn(B, N)
+    local batch = B * N / bench(function() cephes.polyval(coef, x) end) / 1e6
+
+    local cdata, xdata = torch.data(coef), torch.data(x)
+    local y = 0
+    local loop = B * N / bench(function()
+        for b = 0, B - 1 do
+            local p = cdata + b * (m + 1)
+            for j = 0, N - 1 do
+                y = y + cephes.ffi.poleva(p, m, xdata[b * N + j])
+            end
+        end
+    end) / 1e6
+    print(string.format('%6d %6d %14.1f %14.1f', B, m, batch, loop))
+end
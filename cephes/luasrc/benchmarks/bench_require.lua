@@ -0,0 +1,43 @@
+-- Time of a cold require 'cephes', in milliseconds, each run in a fresh
+-- interpreter: as loaded, with the folders of cephes/ declared and
+-- wrapped on first use, then followed by a call to one function, and
+-- with all the folders declared and wrapped, as require did before
+-- loading them lazily.
+-- Usage: th bench_require.lua [number of runs]
+local mode = arg and arg[1]
+
+if mode == 'lazy' or mode == 'one' or mode == 'all' then
+    local clock = os.clock
+    local start = clock()
+    require 'cephes'
+    if mode == 'one' then
+        cephes.ndtr(0.5)
+    elseif mode == 'all' then
+        for _, folder in ipairs{ 'bessel', 'cmath', 'cprob', 'misc', 'ellf', 'polyn' } do
+            cephes._declare(folder)
+            cephes._wrappersOf(folder)
+        end
+    end
+    io.write(string.format('%.3f\n', (clock() - start) * 1e3))
+    os.exit(0)
+end
+
+local R = tonumber(mode) or 20
+local interpreter = arg[-1] or 'th'
+local script = arg[0]
+
+local function median(times)
+    table.sort(times)
+    return times[math.floor((#times + 1) / 2)]
+end
+
+print(string.format('%-8s %12s', 'mode', 'ms'))
+for _, m in ipairs{ 'lazy', 'one', 'all' } do
+    local times = {}
+    for run = 1, R do
+        local child = io.popen(interpreter .. ' ' .. script .. ' ' .. m)
+        times[run] = tonumber(child:read('*l'))
+        child:close()
+    end
+    print(string.format('%-8s %12.2f', m, median(times)))
+end
@@ -0,0 +1,41 @@
+-- Throughput of the batch samplers, in samples per second.
+-- Usage: th bench_sample.lua [number of samples]
+require 'cephes'
+
+local N = tonumber(arg and arg[1]) or 1000000
+
+local samplers = {
+    { 'uniform', {} },
+    { 'normal', { 0, 1 } },
+    { 'gamma', { 1, 2.5 } },
+    { 'beta', { 2, 3 } },
+    { 'chi2', { 4 } },
+    { 't', { 5 } },
+    { 'f', { 3, 7 } },
+}
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+cephes.sample.seed(1)
+local result = torch.DoubleTensor(N)
+print(string.format('%-10s %16s %16s', 'sampler', 'shared params', 'tensor params'))
+for _, s in ipairs(samplers) do
+    local name, params = s[1], s[2]
+    local sampler = cephes.sample[name]
+    local args = { unpack(params) }
+    args[#args + 1] = result
+    local shared = N / bench(function() sampler(unpack(args)) end)
+
+    -- Same values, one per sample, to defeat the shared-parameter path
+    local tensorArgs = {}
+    for i, p in ipairs(params) do
+        tensorArgs[i] = torch.DoubleTensor(N):fill(p)
+    end
+    tensorArgs[#tensorArgs + 1] = result
+    local perSample = N / bench(function() sampler(unpack(tensorArgs)) end)
+    print(string.format('%-10s %16.0f %16.0f', name, shared, perSample))
+end
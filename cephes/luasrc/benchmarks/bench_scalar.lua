@@ -0,0 +1,51 @@
+-- Cost of one call on numbers, in nanoseconds: the C function called
+-- through cephes.ffi, against cephes.<name>, which resets and checks
+-- the error status around the same call.
+-- Usage: th bench_scalar.lua [number of calls]
+require 'cephes'
+
+local N = tonumber(arg and arg[1]) or 10000000
+
+local function loop1(f)
+    local s = 0
+    for i = 1, N do
+        s = s + f(0.5)
+    end
+    return s
+end
+
+local function loop2(f)
+    local s = 0
+    for i = 1, N do
+        s = s + f(2.5, 1.5)
+    end
+    return s
+end
+
+local function loop3(f)
+    local s = 0
+    for i = 1, N do
+        s = s + f(2, 3, 0.4)
+    end
+    return s
+end
+
+local functions = {
+    { 'ndtr', loop1 },
+    { 'igam', loop2 },
+    { 'incbet', loop3 },
+}
+
+local function bench(loop, f)
+    local timer = torch.Timer()
+    loop(f)
+    return timer:time().real / N * 1e9
+end
+
+print(string.format('%-8s %12s %12s %12s', 'function', 'raw ffi', 'cephes', 'overhead'))
+for _, f in ipairs(functions) do
+    local name, loop = f[1], f[2]
+    local direct = bench(loop, cephes.ffi[name])
+    local wrapped = bench(loop, cephes[name])
+    print(string.format('%-8s %12.1f %12.1f %12.1f', name, direct, wrapped, wrapped - direct))
+end
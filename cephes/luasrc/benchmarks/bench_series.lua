@@ -0,0 +1,38 @@
+-- Throughput of cephes.series, in series per second, on batches of random
+-- series truncated at degree d: series_batch on the whole batch against a
+-- loop of calls of polsin and polsqt of polmisc.c, one per series.
+-- Usage: th bench_series.lua [number of series]
+require 'cephes'
+local ffi = require 'ffi'
+
+local N = tonumber(arg and arg[1]) or 10000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+print(string.format('%6s %12s %12s %12s %12s', 'degree', 'sin', 'polsin loop',
+                    'sqrt', 'polsqt loop'))
+for _, d in ipairs{ 4, 8, 16 } do
+    local a = torch.randn(N, d + 1)
+    a:select(2, 1):fill(2)
+    local sin = N / bench(function() cephes.series.sin(a) end)
+    local sqrt = N / bench(function() cephes.series.sqrt(a) end)
+
+    cephes.polini(d)
+    local data = torch.data(a)
+    local y = ffi.new('double[?]', d + 1)
+    local polsin = N / bench(function()
+        for b = 0, N - 1 do
+            cephes.ffi.polsin(data + b * (d + 1), y, d)
+        end
+    end)
+    local polsqt = N / bench(function()
+        for b = 0, N - 1 do
+            cephes.ffi.polsqt(data + b * (d + 1), y, d)
+        end
+    end)
+    print(string.format('%6d %12.0f %12.0f %12.0f %12.0f', d, sin, polsin, sqrt, polsqt))
+end
@@ -0,0 +1,32 @@
+-- Throughput of cephes.simpsn on tensors, in millions of samples per
+-- second, on batches of B functions of N samples: simpsn_batch, total
+-- and cumulative, against a Lua loop of calls of simpsn, one per panel of
+-- 9 samples.
+-- Usage: th bench_simpsn.lua [number of functions]
+require 'cephes'
+
+local B = tonumber(arg and arg[1]) or 1000
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+print(string.format('%8s %12s %12s %12s', 'samples', 'batch', 'cumulative', 'simpsn loop'))
+for _, N in ipairs{ 9, 65, 1025, 8193 } do
+    local f = torch.rand(B, N)
+    local total = B * N / bench(function() cephes.simpsn(f, 0.1) end) / 1e6
+    local cumulative = B * N / bench(function() cephes.simpsn(f, 0.1, true) end) / 1e6
+
+    local data = torch.data(f)
+    local sum = 0
+    local loop = B * N / bench(function()
+        for b = 0, B - 1 do
+            for j = 0, N - 9, 8 do
+                sum = sum + cephes.ffi.simpsn(data + b * N + j, 0.1)
+            end
+        end
+    end) / 1e6
+    print(string.format('%8d %12.1f %12.1f %12.1f', N, total, cumulative, loop))
+end
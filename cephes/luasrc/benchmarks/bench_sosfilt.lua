@@ -0,0 +1,43 @@
+-- Throughput of cephes.SOSFilter, in samples per second over all the
+-- channels: an 8th order elliptic low pass filter run on a stream of
+-- blocks of time x channels, against the same filter run channel by
+-- channel, one single channel stream each.
+-- Usage: th bench_sosfilt.lua [number of samples per channel]
+require 'cephes'
+
+local T = tonumber(arg and arg[1]) or 65536
+local block = 1024
+
+local function bench(f)
+    local timer = torch.Timer()
+    f()
+    return timer:time().real
+end
+
+local design = cephes.ellf{ kind = 'elliptic', type = 'lowpass', n = 8, dbr = 0.5,
+                            fs = 10000, f2 = 2000, dbd = -60 }
+
+print(string.format('%8s %14s %14s', 'channels', 'interleaved', 'per channel'))
+for _, C in ipairs{ 1, 4, 16, 64, 256 } do
+    local input = torch.randn(block, C)
+    local column = torch.randn(block)
+    local filter = cephes.SOSFilter(design, C)
+    local interleaved = T * C / bench(function()
+        for t = 1, T, block do
+            filter:forward(input)
+        end
+    end)
+
+    local filters = {}
+    for c = 1, C do
+        filters[c] = cephes.SOSFilter(design)
+    end
+    local perChannel = T * C / bench(function()
+        for t = 1, T, block do
+            for c = 1, C do
+                filters[c]:forward(column)
+            end
+        end
+    end)
+    print(string.format('%8d %14.0f %14.0f', C, interleaved, perChannel))
+end
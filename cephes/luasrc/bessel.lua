@@ -1,2 +1,131 @@
+local ffi = require 'ffi'
+
 -- Common name for logarithmic derivative of gamma function
-cephes.digamma = cephes.psi
+function cephes.digamma(...)
+    return cephes.psi(...)
+end
+
+--[[ Bessel functions of all integer orders 0..nmax in one pass.
+
+    y = cephes.jn_seq([result,] nmax, x)
+
+computes J_0(x), ..., J_nmax(x) with a single recurrence, instead of
+calling cephes.jn once per order. Likewise yn_seq, in_seq and kn_seq for
+Y_n, I_n and K_n.
+
+Parameters:
+
+* `result` optional tensor of X * (nmax+1) elements to store the result into
+* `nmax` highest order
+* `x` number, or tensor of X arguments
+
+Returns:
+
+1. tensor of nmax+1 values if x is a number, else a X x (nmax+1) tensor
+   whose row i holds the orders of the i-th element of x
+]]
+local function create_sequence(name)
+    local cephesFunction
+
+    return function(...)
+        local result, nmax, x
+        if select('#', ...) == 3 then
+            result, nmax, x = ...
+        elseif select('#', ...) == 2 then
+            nmax, x = ...
+        else
+            error('Usage: cephes.' .. name .. '([result,] nmax, x)')
+        end
+        if type(nmax) ~= 'number' or nmax < 0 or nmax ~= math.floor(nmax) then
+            error('cephes.' .. name .. ': nmax should be a non-negative integer')
+        end
+
+        local X = 1
+        if torch.isTensor(x) then
+            X = x:nElement()
+        end
+        local xTensor, xData = cephes._batchParam(x, X, 2)
+        if result == nil then
+            if torch.isTensor(x) then
+                result = torch.DoubleTensor(X, nmax + 1)
+            else
+                result = torch.DoubleTensor(nmax + 1)
+            end
+        end
+        local work
+        result, work = cephes._batchResult(result, X * (nmax + 1))
+
+        cephesFunction = cephesFunction or cephes.ffi[name]
+        cephes._resetError()
+        cephesFunction(nmax, X, xData, torch.data(work))
+        cephes._reportError()
+        return cephes._batchDone(result, work)
+    end
+end
+
+cephes.jn_seq = create_sequence('jn_seq')
+cephes.yn_seq = create_sequence('yn_seq')
+cephes.in_seq = create_sequence('in_seq')
+cephes.kn_seq = create_sequence('kn_seq')
+
+--[[ Gauss hypergeometric function at many x for fixed a, b, c.
+
+    local plan = cephes.hyp2f1_plan(a, b, c)
+    y = plan:eval([result,] x)
+
+gives the same values as cephes.hyp2f1(a, b, c, x), but the tests and
+gamma function ratios that depend only on a, b, c are done once per
+plan, and the x values are evaluated grouped by the transformation
+they need.
+
+Parameters:
+
+* `a`, `b`, `c` parameters of the function
+* `result` optional tensor of as many elements as x to store the result into
+* `x` number or tensor
+
+Returns:
+
+1. a number if x is a number, otherwise a tensor of the size of x
+]]
+local Hyp2f1Plan = {}
+Hyp2f1Plan.__index = Hyp2f1Plan
+
+function cephes.hyp2f1_plan(a, b, c)
+    cephes._declare('bessel')
+    local plan = setmetatable({ a = a, b = b, c = c,
+                                _plan = ffi.new('hyp2f1plan') }, Hyp2f1Plan)
+    cephes.ffi.hyp2f1_plan(a, b, c, plan._plan)
+    return plan
+end
+
+function Hyp2f1Plan:eval(...)
+    local result, x
+    if select('#', ...) == 2 then
+        result, x = ...
+    else
+        x = ...
+    end
+
+    if not torch.isTensor(x) then
+        local xTensor, xData = cephes._batchParam(x, 1, 1)
+        local y = ffi.new('double[1]')
+        cephes._resetError()
+        cephes.ffi.hyp2f1_eval(self._plan, 1, xData, y)
+        cephes._reportError()
+        return y[0]
+    end
+
+    local N = x:nElement()
+    local xTensor, xData = cephes._batchParam(x, N, 1)
+    if result == nil then
+        result = torch.DoubleTensor():resize(x:size())
+    end
+    local work
+    result, work = cephes._batchResult(result, N)
+
+    cephes._resetError()
+    cephes.ffi.hyp2f1_eval(self._plan, N, xData, torch.data(work))
+    cephes._reportError()
+    return cephes._batchDone(result, work)
+end
@@ -0,0 +1,299 @@
+--[[ Design of Butterworth, Chebyshev and elliptic IIR filters.
+
+A filter is specified by a table, with the names of ellf/ellf.doc:
+
+    local design = cephes.ellf{ kind = 'elliptic', type = 'lowpass', n = 8,
+                                dbr = 0.5, fs = 10000, f2 = 2000, dbd = -60 }
+
+* `kind` 'butterworth', 'chebyshev' or 'elliptic', or 1, 2, 3
+* `type` 'lowpass', 'bandpass', 'highpass' or 'bandstop', or 1, 2, 3, 4
+* `n` order of the analog prototype
+* `dbr` pass band ripple in db, peak to peak, for Chebyshev and elliptic
+* `fs` sampling frequency in Hz
+* `f2` pass band edge in Hz, and `f1` the other one for band filters
+* `dbd` elliptic filters, required: stop band edge in Hz if positive,
+  otherwise the stop band attenuation as -db
+
+The design is a table of
+
+* `order` order of the z plane polynomials, n or 2n for band filters
+* `gain` constant gain factor
+* `num`, `den` coefficients of z^0 .. z^-order of the numerator, gain
+  included, and of the denominator of the transfer function, den[1] = 1
+* `poles`, `zeros` order x 2 tensors of the real and imaginary parts of
+  the roots of den and num, complex roots followed by their conjugates
+* `sos` ns x 6 tensor of the second order sections b0 b1 b2 a0 a1 a2
+  of the filter, ns = (order + 1) / 2, gain in the first one
+* `f3`, `dbdown` stop band edge and attenuation of elliptic filters
+
+Given a list of specifications, cephes.ellf designs all of them in
+parallel and returns the list of designs, with false in place of the
+invalid specifications and their error messages as second result.
+
+cephes.SOSFilter applies designs to signals, in blocks of any size:
+
+    local filter = cephes.SOSFilter(design, channels)
+    for block in blocks do      -- time x channels tensors
+        local y = filter:forward(block)
+    end
+]]
+
+local ffi = require 'ffi'
+
+local kinds = { butterworth = 1, chebyshev = 2, elliptic = 3 }
+local types = { lowpass = 1, bandpass = 2, highpass = 3, bandstop = 4 }
+
+local messages = {
+    [-1] = 'invalid specification',
+    [-2] = 'order too large, the maximum is 24 for low and high pass filters ' ..
+           'and 12 for band filters',
+}
+
+-- Fill the ellfspec cdata spec from the table t
+local function toSpec(t, spec)
+    if type(t) ~= 'table' then
+        error('cephes.ellf: expected a table of specification, got ' .. type(t))
+    end
+    spec.kind = kinds[t.kind] or tonumber(t.kind) or 0
+    spec.type = types[t.type] or tonumber(t.type) or 0
+    spec.n = t.n or 0
+    spec.dbr = t.dbr or 0
+    spec.fs = t.fs or 0
+    spec.f1 = t.f1 or 0
+    spec.f2 = t.f2 or 0
+    if spec.kind == 3 and t.dbd == nil then
+        error('cephes.ellf: elliptic filters need dbd, the stop band edge or attenuation')
+    end
+    spec.dbd = t.dbd or 0
+end
+
+-- Table of the ellfdesign cdata d, of a filter of the given kind
+local function fromDesign(d, kind)
+    local order = d.order
+    local design = {
+        order = order,
+        gain = d.gain,
+        fs = d.fs,
+        num = torch.DoubleTensor(order + 1),
+        den = torch.DoubleTensor(order + 1),
+        poles = torch.DoubleTensor(order, 2),
+        zeros = torch.DoubleTensor(order, 2),
+        _design = d,
+    }
+    if kind == 3 then
+        design.f3 = d.f3
+        design.dbdown = d.dbdown
+    end
+    local num, den = torch.data(design.num), torch.data(design.den)
+    for j = 0, order do
+        num[j] = d.num[j]
+        den[j] = d.den[j]
+    end
+    local poles, zeros = torch.data(design.poles), torch.data(design.zeros)
+    for j = 0, order - 1 do
+        poles[2 * j], poles[2 * j + 1] = d.pole[j].r, d.pole[j].i
+        zeros[2 * j], zeros[2 * j + 1] = d.zero[j].r, d.zero[j].i
+    end
+    design.sos = torch.DoubleTensor(math.floor((order + 1) / 2), 6)
+    cephes.ffi.ellf_sos(d, torch.data(design.sos))
+    return design
+end
+
+--[[! Design one filter, or a list of filters in parallel
+
+@param spec specification table, or list of them
+
+@return design table; for a list, the list of designs, false for the
+        invalid specifications, and the list of error messages
+--]]
+function cephes.ellf(spec)
+    cephes._declare('ellf')
+    if type(spec) == 'table' and spec[1] == nil then
+        local s = ffi.new('ellfspec')
+        local d = ffi.new('ellfdesign')
+        toSpec(spec, s)
+        local status = cephes.ffi.ellf_design(s, d)
+        if status ~= 0 then
+            error('cephes.ellf: ' .. messages[status])
+        end
+        return fromDesign(d, s.kind)
+    end
+
+    local n = #spec
+    local specs = ffi.new('ellfspec[?]', n)
+    local status = ffi.new('int[?]', n)
+    for i = 1, n do
+        toSpec(spec[i], specs[i - 1])
+    end
+    local out = ffi.new('ellfdesign[?]', n)
+    cephes.ffi.ellf_design_batch(n, specs, out, status)
+
+    local designs, errors = {}, {}
+    for i = 1, n do
+        if status[i - 1] == 0 then
+            local d = ffi.new('ellfdesign', out[i - 1])
+            designs[i] = fromDesign(d, specs[i - 1].kind)
+        else
+            designs[i] = false
+            errors[i] = messages[status[i - 1]]
+        end
+    end
+    return designs, errors
+end
+
+--[[! Magnitude of the frequency response of a design
+
+@param design table returned by cephes.ellf
+@param f frequency in Hz, number or tensor
+
+@return |H(exp(2 pi i f / fs))|, number or tensor of the size of f
+--]]
+function cephes.ellfResponse(design, f)
+    local d = design._design
+    if type(f) == 'number' then
+        return cephes.ffi.ellf_response(d, f)
+    end
+    local result = torch.DoubleTensor(f:size())
+    local x = f:double():contiguous()
+    local xdata, rdata = torch.data(x), torch.data(result)
+    for i = 0, x:nElement() - 1 do
+        rdata[i] = cephes.ffi.ellf_response(d, xdata[i])
+    end
+    return result
+end
+
+
+-- Contiguous DoubleTensor of the filter, resized to size
+local function buffer(filter, key, size)
+    local tensor = filter[key]
+    if tensor == nil then
+        tensor = torch.DoubleTensor()
+        filter[key] = tensor
+    end
+    return tensor:resize(size)
+end
+
+-- ns x 6 tensor of sections of a design table or a tensor, normalized
+-- to a0 = 1
+local function sectionsOf(sections)
+    if type(sections) == 'table' and not torch.isTensor(sections) then
+        sections = sections.sos
+    end
+    if not torch.isTensor(sections) or sections:dim() ~= 2 or sections:size(2) ~= 6 then
+        error('cephes.SOSFilter: expected a design or a ns x 6 tensor of sections')
+    end
+    local sos = sections:double():clone()
+    for s = 1, sos:size(1) do
+        local row = sos[s]
+        local a0 = row[4]
+        if a0 == 0 then
+            error('cephes.SOSFilter: section ' .. s .. ' has a0 = 0')
+        end
+        if a0 ~= 1 then
+            row:div(a0)
+        end
+    end
+    return sos
+end
+
+
+--[[ Streaming filter of second order sections, over the channels of a
+signal: cephes.SOSFilter(sections, channels)
+
+@param sections design table of cephes.ellf, ns x 6 tensor of sections
+       b0 b1 b2 a0 a1 a2, or a list of them, one per channel; the
+       channels with fewer sections pass through the missing ones
+@param channels number of channels, default 1 or the length of the list
+
+The state of the sections carries over from one call of forward to the
+next, so that filtering a stream block after block gives the result of
+filtering it at once. Blocks are time x channels tensors, or vectors for
+a single channel; the output buffer is kept, and a stream of blocks of
+the same size allocates nothing.
+--]]
+local SOSFilter = torch.class('cephes.SOSFilter', cephes)
+
+function SOSFilter:__init(sections, channels)
+    local list = not torch.isTensor(sections) and sections.sos == nil
+    channels = channels or (list and #sections or 1)
+    if list and #sections ~= channels then
+        error('cephes.SOSFilter: ' .. #sections .. ' filters for ' .. channels .. ' channels')
+    end
+    self.channels = channels
+
+    if not list then
+        self.sos = sectionsOf(sections)
+        self.perChannel = false
+    else
+        local all, ns = {}, 0
+        for c = 1, channels do
+            all[c] = sectionsOf(sections[c])
+            ns = math.max(ns, all[c]:size(1))
+        end
+        -- coefficient k of section s of channel c at sos[s][k][c]
+        self.sos = torch.DoubleTensor(ns, 6, channels):zero()
+        local data = torch.data(self.sos)
+        for c = 1, channels do
+            local sos = all[c]
+            local n = sos:size(1)
+            for s = 1, ns do
+                local base = (s - 1) * 6 * channels + c - 1
+                if s <= n then
+                    for k = 1, 6 do
+                        data[base + (k - 1) * channels] = sos[s][k]
+                    end
+                else
+                    data[base] = 1
+                    data[base + 3 * channels] = 1
+                end
+            end
+        end
+        self.perChannel = true
+    end
+    self.sections = self.sos:size(1)
+    self.state = torch.DoubleTensor(self.sections, 2, channels):zero()
+end
+
+--[[! Filter the next block of the stream
+
+@param input time x channels tensor, or a vector if there is one channel
+@param output optional tensor for the result
+
+@return output, or the buffer of the filter, of the size of input
+--]]
+function SOSFilter:forward(input, output)
+    local C = self.channels
+    local T = input:nElement() / C
+    if input:dim() == 1 and C ~= 1 or input:dim() == 2 and input:size(2) ~= C
+            or input:dim() > 2 then
+        error('cephes.SOSFilter: expected a time x ' .. C .. ' tensor')
+    end
+    local x = input
+    if torch.typename(x) ~= 'torch.DoubleTensor' or not x:isContiguous() then
+        x = buffer(self, '_input', input:size()):copy(input)
+    end
+    local y = output
+    if y == nil then
+        y = buffer(self, 'output', input:size())
+    else
+        y:resize(input:size())
+        if torch.typename(y) ~= 'torch.DoubleTensor' or not y:isContiguous() then
+            y = buffer(self, '_output', input:size())
+        end
+    end
+    if T > 0 then
+        cephes.ffi.sosfilt(self.sections, torch.data(self.sos),
+                           self.perChannel and 1 or 0, C, T,
+                           torch.data(x), torch.data(y), torch.data(self.state))
+    end
+    if output ~= nil and y ~= output then
+        output:copy(y)
+    end
+    return output or y
+end
+
+--[[! Zero the state, to start a new stream ]]
+function SOSFilter:reset()
+    self.state:zero()
+    return self
+end
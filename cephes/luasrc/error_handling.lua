@@ -57,6 +57,10 @@ local functions_list = {
     { name = 'igami', arguments = { { name = 'a', type = 'double' }, { name = 'y0', type = 'double' } }, returnType = 'double' },
     { name = 'incbet', arguments = { { name = 'aa', type = 'double' }, { name = 'bb', type = 'double' }, { name = 'xx', type = 'double' } }, returnType = 'double' },
     { name = 'incbi', arguments = { { name = 'aa', type = 'double' }, { name = 'bb', type = 'double' }, { name = 'yy0', type = 'double' } }, returnType = 'double' },
+    { name = 'kolmogi', arguments = { { name = 'p', type = 'double' } }, returnType = 'double' },
+    { name = 'kolmogorov', arguments = { { name = 'y', type = 'double' } }, returnType = 'double' },
+    { name = 'smirnov', arguments = { { name = 'n', type = 'int' }, { name = 'e', type = 'double' } }, returnType = 'double' },
+    { name = 'smirnovi', arguments = { { name = 'n', type = 'int' }, { name = 'e', type = 'double' } }, returnType = 'double' },
     { name = 'nbdtrc', arguments = { { name = 'k', type = 'int' }, { name = 'n', type = 'int' }, { name = 'p', type = 'double' } }, returnType = 'double' },
     { name = 'nbdtr', arguments = { { name = 'k', type = 'int' }, { name = 'n', type = 'int' }, { name = 'p', type = 'double' } }, returnType = 'double' },
     { name = 'nbdtri', arguments = { { name = 'k', type = 'int' }, { name = 'n', type = 'int' }, { name = 'p', type = 'double' } }, returnType = 'double' },
@@ -91,8 +95,13 @@ local functions_list = {
     { name = 'sici', arguments = { { name = 'x', type = 'double' }, { name = 'si', type = 'double *' }, { name = 'ci', type = 'double *' } }, returnType = 'int' },
     { name = 'simpsn', arguments = { { name = 'f[]', type = 'double' }, { name = 'delta', type = 'double' } }, returnType = 'double' },
     { name = 'spence', arguments = { { name = 'x', type = 'double' } }, returnType = 'double' },
+    { name = 'polylog', arguments = { { name = 'n', type = 'int' }, { name = 'x', type = 'double' } }, returnType = 'double' },
     { name = 'zeta', arguments = { { name = 'x', type = 'double' }, { name = 'q', type = 'double' } }, returnType = 'double' },
     { name = 'zetac', arguments = { { name = 'x', type = 'double' } }, returnType = 'double' },
+    { name = 'polygamma', arguments = { { name = 'm', type = 'int' }, { name = 'x', type = 'double' } }, returnType = 'double' },
+    { name = 'trigamma', arguments = { { name = 'x', type = 'double' } }, returnType = 'double' },
+    { name = 'lmvgam', arguments = { { name = 'x', type = 'double' }, { name = 'p', type = 'int' } }, returnType = 'double' },
+    { name = 'mvgam', arguments = { { name = 'x', type = 'double' }, { name = 'p', type = 'int' } }, returnType = 'double' },
     { name = 'cadd', arguments = { { name = 'a', type = 'cmplx *' }, { name = 'b', type = 'cmplx *' }, { name = 'c', type = 'cmplx *' } }, returnType = 'void' },
     { name = 'csub', arguments = { { name = 'a', type = 'cmplx *' }, { name = 'b', type = 'cmplx *' }, { name = 'c', type = 'cmplx *' } }, returnType = 'void' },
     { name = 'cmul', arguments = { { name = 'a', type = 'cmplx *' }, { name = 'b', type = 'cmplx *' }, { name = 'c', type = 'cmplx *' } }, returnType = 'void' },
@@ -214,12 +223,182 @@ local functions_list = {
     { name = 'yn', arguments = { { name = 'n', type = 'int' }, { name = 'x', type = 'double' } }, returnType = 'double' },
 }
 
--- Link to torch_merr.c error reporting
+-- Link to torch_merr.c error reporting, and torch_stats.c counters
 ffi.cdef[[
     int torch_cephes_merror;
     char torch_cephes_errtxt[100];
+    int torch_cephes_stats_enabled;
+    void torch_cephes_stats_begin(int id);
+    void torch_cephes_stats_end(int id, double elements);
+    int torch_cephes_stats_read(int n, double * out);
+    void torch_cephes_stats_reset();
+    int torch_cephes_profile_read(double * out);
 ]]
 
+local lib = cephes._ffi
+
+-- Reset error status before calling into the library
+function cephes._resetError()
+    lib.torch_cephes_merror = 0
+end
+
+-- Report the error raised since the last reset, if any, according
+-- to the current error level
+function cephes._reportError()
+    if reportError > 0 and lib.torch_cephes_merror ~= 0 then
+        local errString =  "Cephes error '" .. ffi.string(cephes.ffi.errtxt) .. "'"
+        if reportError == 1 then
+            error(errString)
+        else
+            print('CEPHES WARNING:', errString)
+        end
+    end
+end
+
+--[[ Call statistics.
+
+    cephes.setStats(true)
+    ...
+    local stats = cephes.stats()
+    print(stats.igam.calls, stats.igam.elements, stats.igam.ns)
+
+Once enabled, every call to a wrapped function counts, per function,
+the calls, the elements computed (1 for numbers) and the time spent
+in the library, in nanoseconds, and every error the library raises
+counts under its mtherr code: unknown, domain, sing, overflow,
+underflow, tloss and ploss. Errors raised outside of a wrapped call,
+as through cephes.ffi, count under 'unwrapped'. The counters are kept
+per thread in torch_stats.c, and cephes.stats sums them.
+
+Counting reads the clock twice per call, which is more than the
+scalar call itself costs: it is off by default.
+--]]
+local statsFields = 10
+local errorCodes = { 'unknown', 'domain', 'sing', 'overflow', 'underflow',
+                     'tloss', 'ploss' }
+
+-- Index of each function in the counters, from 1; 0 is for the errors
+-- of unwrapped calls
+local statsNames, statsIds = {}, {}
+for _, v in ipairs(functions_list) do
+    if not statsIds[v.name] then
+        table.insert(statsNames, v.name)
+        statsIds[v.name] = #statsNames
+    end
+end
+
+function cephes.setStats(enabled)
+    lib.torch_cephes_stats_enabled = enabled and 1 or 0
+end
+
+function cephes.getStats()
+    return lib.torch_cephes_stats_enabled ~= 0
+end
+
+--[[! Counters of the wrapped functions
+
+@param reset if true, clear the counters after reading them
+
+@return table of the functions called or raising errors since the last
+        reset, by name: { calls, elements, ns, errors = { by code } }
+@return number of threads that counted
+--]]
+function cephes.stats(reset)
+    local n = #statsNames + 1
+    local out = ffi.new('double[?]', n * statsFields)
+    local threads = lib.torch_cephes_stats_read(n, out)
+    if reset then
+        lib.torch_cephes_stats_reset()
+    end
+    local stats = {}
+    for id = 0, n - 1 do
+        local row = out + id * statsFields
+        local used = false
+        for field = 0, statsFields - 1 do
+            used = used or row[field] ~= 0
+        end
+        if used then
+            local errors = {}
+            for code, codeName in ipairs(errorCodes) do
+                errors[codeName] = row[2 + code]
+            end
+            stats[statsNames[id] or 'unwrapped'] = {
+                calls = row[0], elements = row[1], ns = row[2], errors = errors
+            }
+        end
+    end
+    return stats, threads
+end
+
+function cephes.resetStats()
+    lib.torch_cephes_stats_reset()
+end
+
+--[[ Code paths.
+
+    cephes.setStats(true)
+    ...
+    local prof = cephes.profile()
+    print(prof.igam.series.count, prof.igam.fraction.count)
+
+jv, hyp2f1, igam, incbet and ndtri each choose among several
+algorithms by argument region. When the library is built with
+cmake -DCEPHES_PROFILE=ON, they record, while the call statistics are
+enabled, each algorithm they run and its number of series or continued
+fraction iterations; a call may run more than one. The paths are
+those of torch_profile.h, and the iterations of each path are counted
+in buckets: buckets[1] for none, buckets[k + 2] for 2^k up to
+2^(k+1) - 1, and buckets[17] for 2^15 and more. cephes.resetStats
+clears them too.
+--]]
+local profileNames = { 'jv', 'hyp2f1', 'igam', 'incbet', 'ndtri' }
+local profilePaths = {
+    jv = { 'j0j1', 'series', 'hankel', 'recurrence', 'asymptotic',
+           'transition', 'error' },
+    hyp2f1 = { 'divergent', 'powa', 'powb', 'one', 'recurrence',
+               'negc', 'negative', 'near', 'psi', 'series',
+               'powerSeries', 'psiSeries' },
+    igam = { 'series', 'fraction', 'error' },
+    incbet = { 'series', 'fraction1', 'fraction2', 'exchanged', 'error' },
+    ndtri = { 'central', 'tail', 'farTail', 'error' },
+}
+local profilePathCount, profileBuckets = 16, 17
+
+--[[! Code path histograms of the instrumentation build
+
+@param reset if true, clear the call statistics and histograms after
+       reading them
+
+@return table of the paths taken since the last reset, by function and
+        path name: { count, buckets = { iterations histogram } }
+--]]
+function cephes.profile(reset)
+    local n = #profileNames * profilePathCount * profileBuckets
+    local out = ffi.new('double[?]', n)
+    if lib.torch_cephes_profile_read(out) == 0 then
+        error('cephes was built without CEPHES_PROFILE')
+    end
+    if reset then
+        lib.torch_cephes_stats_reset()
+    end
+    local profile = {}
+    for f, name in ipairs(profileNames) do
+        for p, pathName in ipairs(profilePaths[name]) do
+            local row = out + ((f - 1) * profilePathCount + p - 1) * profileBuckets
+            local count, buckets = 0, {}
+            for k = 0, profileBuckets - 1 do
+                buckets[k + 1] = row[k]
+                count = count + row[k]
+            end
+            if count > 0 then
+                profile[name] = profile[name] or {}
+                profile[name][pathName] = { count = count, buckets = buckets }
+            end
+        end
+    end
+    return profile
+end
+
 local function applyNotInPlace(input, output, func)
     if not input:isContiguous() or not output:isContiguous() then
         error("applyNotInPlace only supports contiguous tensors")
@@ -376,6 +555,8 @@ local function create_wrapper(name, parameters, returnType)
         print("Returns: " .. returnType)
     end
 
+    local id = statsIds[name]
+
     local function wrapper(...)
         local argCount = select("#", ...)
         for index = 1,argCount do
@@ -383,13 +564,19 @@ local function create_wrapper(name, parameters, returnType)
                 error("Bad cephes call - argument " .. index .. " is nil when calling function " .. name .. "!")
             end
         end
-        -- Reset error status
-        cephes.ffi.torch_cephes_merror = 0
+        cephes._resetError()
         local result, params = cephes._check1DParams(#parameters, tensorReturnType, ...)
 
+        local counting = lib.torch_cephes_stats_enabled ~= 0
+        if counting then
+            lib.torch_cephes_stats_begin(id)
+        end
         if result then
             local cephesFunction = cephes.ffi[name]
-            if #params == 1 then
+            local batchKernel = cephes._batchKernels[name]
+            if batchKernel then
+                cephes._batchApply(batchKernel, result, params)
+            elseif #params == 1 then
                 params[1] = params[1]:contiguous()
                 applyNotInPlace(params[1], result, cephesFunction)
             elseif #params == 2 then
@@ -402,22 +589,120 @@ local function create_wrapper(name, parameters, returnType)
         else
             result = cephes.ffi[name](unpack(params))
         end
-
-        if reportError > 0 and cephes.ffi.merror ~= 0 then
-            local errString =  "Cephes error '" .. ffi.string(cephes.ffi.errtxt) .. "'"
-            if reportError == 1 then
-                error(errString)
-            else
-                print('CEPHES WARNING:', errString)
-            end
+        if counting then
+            lib.torch_cephes_stats_end(id, torch.isTensor(result) and result:nElement() or 1)
         end
+
+        cephes._reportError()
         return result
     end
     return wrapper
 end
 
--- To allow easy listing from lua, add one entry in the lua
--- table for each function
+--[[ Scalar entry points.
+
+A call with numbers only does not need the argument checking of the
+generic wrapper, which allocates tables and looks the function up by
+name. For each number of arguments K, a function is compiled once that
+takes the arguments by name: when they are all numbers, it calls the C
+function directly, resolved on the first call; otherwise it passes them
+on to the generic wrapper, result tensor included.
+--]]
+local scalarFactories = {}
+
+local function scalarFactory(K)
+    if scalarFactories[K] then
+        return scalarFactories[K]
+    end
+    local args, checks = {}, {}
+    for i = 1, K do
+        args[i] = 'a' .. i
+        checks[i] = "type(a" .. i .. ") == 'number'"
+    end
+    local list = table.concat(args, ', ')
+    local extra = 'a' .. (K + 1)
+    local source = [[
+local lib, name, id, generic, report = ...
+local fn
+return function(LIST, EXTRA)
+    if EXTRA == nil and CHECKS then
+        if fn == nil then
+            fn = cephes.ffi[name]
+        end
+        lib.torch_cephes_merror = 0
+        local result
+        if lib.torch_cephes_stats_enabled ~= 0 then
+            lib.torch_cephes_stats_begin(id)
+            result = fn(LIST)
+            lib.torch_cephes_stats_end(id, 1)
+        else
+            result = fn(LIST)
+        end
+        if lib.torch_cephes_merror ~= 0 then
+            report()
+        end
+        return result
+    elseif EXTRA == nil then
+        return generic(LIST)
+    end
+    return generic(LIST, EXTRA)
+end
+]]
+    source = source:gsub('LIST', list):gsub('EXTRA', extra)
+                   :gsub('CHECKS', table.concat(checks, ' and '))
+    scalarFactories[K] = assert(loadstring(source, '=cephes scalar ' .. K))
+    return scalarFactories[K]
+end
+
+local function create_scalar(name, parameters, returnType)
+    local generic = create_wrapper(name, parameters, returnType)
+    if #parameters == 0 then
+        return generic
+    end
+    return scalarFactory(#parameters)(lib, name, statsIds[name], generic,
+                                      cephes._reportError)
+end
+
+--[[ Wrappers by folder.
+
+The wrappers of the functions of a folder of cephes/ are created
+together, the first time one of them is looked up. To allow easy
+listing from lua, they are then added to the lua table, except where a
+function of the same name was defined on top of the wrapper.
+--]]
+local entries = {}
 for _, v in ipairs(functions_list) do
-    rawset(cephes, v.name, create_wrapper(v.name, v.arguments, v.returnType))
+    entries[v.name] = v
+end
+local wrappers = {}
+
+-- Table of the wrappers of the functions of a folder
+function cephes._wrappersOf(folder)
+    if wrappers[folder] then
+        return wrappers[folder]
+    end
+    local functions = {}
+    local names = cephes._functionsOf(folder)
+    for _, v in ipairs(functions_list) do
+        if names[v.name] then
+            functions[v.name] = create_scalar(v.name, v.arguments, v.returnType)
+        end
+    end
+    for name, wrapper in pairs(functions) do
+        if rawget(cephes, name) == nil then
+            rawset(cephes, name, wrapper)
+        end
+    end
+    wrappers[folder] = functions
+    return functions
+end
+
+-- Wrapper of the function of the given name, or nil if there is none;
+-- unlike cephes[name], never a function defined on top of it
+function cephes._wrapped(name)
+    if entries[name] == nil then
+        return nil
+    end
+    local folder = cephes._folderOf('torch_cephes_' .. name)
+    return folder and cephes._wrappersOf(folder)[name]
 end
@@ -0,0 +1,85 @@
+--[[ Special functions together with their derivatives.
+
+Each function of cephes.grad takes the parameters of the function of the
+same name, numbers or tensors with either 1 element or one element per
+element of the batch, and returns the value followed by the partial
+derivatives, as numbers if all the parameters are numbers and as tensors
+otherwise:
+
+    local f, dfdx = cephes.grad.lgam(x)
+    local f, dfda, dfdx = cephes.grad.igam(a, x)
+    local f, dfda, dfdb, dfdx = cephes.grad.incbet(a, b, x)
+
+The native kernels evaluate the value and the derivatives in one pass,
+sharing lgam, psi and the expansions between them. The orders of jv
+and iv and the dimension of lmvgam get no derivative.
+]]
+
+cephes.grad = {}
+
+-- Wrap the native kernel name_grad of a function of K parameters
+-- returning G derivatives
+local function create_grad(name, K, G)
+    local kernel
+
+    return function(...)
+        local argCount = select('#', ...)
+        if argCount ~= K then
+            error('cephes.grad.' .. name .. ': need ' .. K .. ' parameters, got ' ..
+                  argCount .. ' arguments')
+        end
+        local N = cephes._batchSize(...)
+        local size
+        local args = {}
+        local keep = {}
+        for index = 1, K do
+            local param = select(index, ...)
+            if torch.isTensor(param) and param:nElement() == N then
+                size = size or param:size()
+            end
+            local tensor, data, stride = cephes._batchParam(param, N, index)
+            keep[index] = tensor
+            args[2 * index - 1] = data
+            args[2 * index] = stride
+        end
+
+        local outputs = {}
+        for index = 1, G + 1 do
+            outputs[index] = torch.DoubleTensor(N)
+            args[2 * K + index] = torch.data(outputs[index])
+        end
+        kernel = kernel or cephes.ffi[name .. '_grad']
+        cephes._resetError()
+        kernel(N, unpack(args, 1, 2 * K + G + 1))
+        cephes._reportError()
+
+        for index = 1, G + 1 do
+            if size then
+                outputs[index] = outputs[index]:resize(size)
+            else
+                outputs[index] = outputs[index][1]
+            end
+        end
+        return unpack(outputs, 1, G + 1)
+    end
+end
+
+-- f(x), df/dx
+for _, name in ipairs{ 'lgam', 'gamma', 'psi', 'erf',
+                       'j0', 'j1', 'y0', 'y1', 'i0', 'i1', 'i0e', 'i1e',
+                       'k0', 'k1', 'k0e', 'k1e' } do
+    cephes.grad[name] = create_grad(name, 1, 1)
+end
+cephes.grad.digamma = cephes.grad.psi
+-- f(v, x), df/dx
+cephes.grad.jv = create_grad('jv', 2, 1)
+cephes.grad.iv = create_grad('iv', 2, 1)
+-- f(x, p), df/dx
+cephes.grad.lmvgam = create_grad('lmvgam', 2, 1)
+-- f(a, b), df/da, df/db
+cephes.grad.beta = create_grad('beta', 2, 2)
+-- f(a, x), df/da, df/dx
+cephes.grad.igam = create_grad('igam', 2, 2)
+cephes.grad.igamc = create_grad('igamc', 2, 2)
+-- f(a, b, x), df/da, df/db, df/dx
+cephes.grad.incbet = create_grad('incbet', 3, 3)
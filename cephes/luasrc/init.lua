@@ -4,10 +4,86 @@ require 'torch'
 cephes = {}
 cephes._ffi = ffi.load(package.searchpath('libcephes', package.cpath))
 cephes.ffi = {}
+
+--[[ Declarations of the C functions, one string per folder of cephes/.
+
+Parsing all of them costs more than the rest of require 'cephes', so a
+folder is declared to the ffi only when one of its symbols is first
+looked up through cephes.ffi, or when cephes._declare is called for it.
+--]]
+local declarations = {}
+local folders = { 'bessel', 'cmath', 'cprob', 'misc', 'ellf', 'polyn' }
+local declared = {}
+
+-- Declare the functions and types of a folder, once
+function cephes._declare(folder)
+    if not declared[folder] then
+        declared[folder] = true
+        ffi.cdef(declarations[folder])
+    end
+end
+
+-- Folder of each C symbol looked up so far, false if it has none;
+-- filled with all the functions on the first lookup
+local folderOf
+
+-- Folder whose declarations hold the C symbol, or nil
+function cephes._folderOf(symbol)
+    if folderOf == nil then
+        folderOf = {}
+        for _, folder in ipairs(folders) do
+            for name in pairs(cephes._functionsOf(folder)) do
+                name = 'torch_cephes_' .. name
+                folderOf[name] = folderOf[name] or folder
+            end
+        end
+    end
+    local folder = folderOf[symbol]
+    if folder == nil then
+        -- variables and types are searched for in the declarations
+        folder = false
+        local pattern = '%f[%w_]' .. symbol .. '%f[^%w_]'
+        for _, name in ipairs(folders) do
+            if declarations[name]:find(pattern) then
+                folder = name
+                break
+            end
+        end
+        folderOf[symbol] = folder
+    end
+    return folder or nil
+end
+
+-- Names of the C functions declared by a folder, without their prefix
+function cephes._functionsOf(folder)
+    local names = {}
+    for name in declarations[folder]:gmatch('torch_cephes_([%w_]+)%s*%(') do
+        names[name] = true
+    end
+    return names
+end
+
+-- Look a symbol up in the library, declaring its folder first
+local function resolve(symbol)
+    local folder = cephes._folderOf(symbol)
+    if folder then
+        cephes._declare(folder)
+    end
+    return cephes._ffi[symbol]
+end
+
+-- Functions and arrays are cached once resolved, so that the prefixed
+-- name is built only on the first access; variables such as merror are
+-- read from the library each time
 setmetatable(cephes.ffi, {__index = function(t, key)
-                              return cephes._ffi['torch_cephes_' .. key]
+                              local value = resolve('torch_cephes_' .. key)
+                              if type(value) == 'cdata' then
+                                  rawset(t, key, value)
+                              end
+                              return value
                             end,
                           __newindex = function(t, key, value)
+                              resolve(key)
                               cephes._ffi[key] = value
                          end})
 
@@ -21,12 +97,51 @@ typedef struct
 ]]
 
 -- imports for folder bessel
-ffi.cdef[[
+declarations.bessel = [[
    // cephes/bessel/airy.c
    int torch_cephes_airy(double x, double * ai, double * aip,
                          double * bi, double * bip);
+   // cephes/bessel/besgrad.c
+   void torch_cephes_j0_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_j1_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_y0_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_y1_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_i0_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_i1_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_i0e_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_i1e_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_k0_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_k1_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_k0e_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_k1e_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_jv_grad(int n, double * v, int sv, double * x, int sx,
+                             double * y, double * dy);
+   void torch_cephes_iv_grad(int n, double * v, int sv, double * x, int sx,
+                             double * y, double * dy);
+   // cephes/bessel/besseq.c
+   void torch_cephes_jn_seq(int nmax, int n, double * x, double * y);
+   void torch_cephes_yn_seq(int nmax, int n, double * x, double * y);
+   void torch_cephes_in_seq(int nmax, int n, double * x, double * y);
+   void torch_cephes_kn_seq(int nmax, int n, double * x, double * y);
    // cephes/bessel/hyp2f1.c
    double torch_cephes_hyp2f1(double a, double b, double c, double x);
+   typedef struct
+   {
+      double a, b, c;
+      double d, id;
+      int flag;
+      int cneg;
+      int have;
+      double gone;
+      double gq, gr, gc;
+      double e, d1, d2;
+      int aid;
+      double psi1, psie, psia, psib, ge1, ge2, gy, gy1;
+   } hyp2f1plan;
+   void torch_cephes_hyp2f1_plan(double a, double b, double c,
+                                 hyp2f1plan * plan);
+   void torch_cephes_hyp2f1_eval(hyp2f1plan * plan, int n, double * x,
+                                 double * y);
    // cephes/bessel/hyperg.c
    double torch_cephes_hyperg(double a, double b, double x);
    double torch_cephes_hyp2f0(double a, double b, double x,
@@ -70,7 +185,7 @@ ffi.cdef[[
 ]]
 
 -- imports for folder cmath
-ffi.cdef[[
+declarations.cmath = [[
    // cephes/cmath/acosh.c
    double torch_cephes_acosh(double x);
    // cephes/cmath/asin.c
@@ -87,6 +202,8 @@ ffi.cdef[[
    double torch_cephes_cbrt(double x);
    // cephes/cmath/chbevl.c
    double torch_cephes_chbevl(double x, double array[], int n);
+   void torch_cephes_chbevl_batch(int m, double x[], double array[], int n,
+                                  double y[]);
    // cephes/cmath/clog.c
    void torch_cephes_clog(cmplx * z, cmplx * w);
    void torch_cephes_cexp(cmplx * z, cmplx * w);
@@ -135,6 +252,10 @@ ffi.cdef[[
    // cephes/cmath/polevl.c
    double torch_cephes_polevl(double x, double coef[], int N);
    double torch_cephes_p1evl(double x, double coef[], int N);
+   void torch_cephes_polevl_batch(int n, double x[], double coef[], int N,
+                                  double y[]);
+   void torch_cephes_p1evl_batch(int n, double x[], double coef[], int N,
+                                 double y[]);
    // cephes/cmath/pow.c
    double torch_cephes_pow(double x, double y);
    // cephes/cmath/powi.c
@@ -166,26 +287,48 @@ ffi.cdef[[
    double torch_cephes_log1p(double x);
    double torch_cephes_expm1(double x);
    double torch_cephes_cosm1(double x);
+   // cephes/cmath/clog.c
+   void torch_cephes_csinh(cmplx *z, cmplx *w);
+   void torch_cephes_casinh(cmplx *z, cmplx *w);
+   void torch_cephes_ccosh(cmplx *z, cmplx *w);
+   void torch_cephes_cacosh(cmplx *z, cmplx *w);
+   void torch_cephes_ctanh(cmplx *z, cmplx *w);
+   void torch_cephes_catanh(cmplx *z, cmplx *w);
+   void torch_cephes_cpow(cmplx *a, cmplx *z, cmplx *w);
 ]]
 
 -- imports for folder cprob
-ffi.cdef[[
+declarations.cprob = [[
    // cephes/cprob/bdtr.c
    double torch_cephes_bdtrc(int k, int n, double p);
    double torch_cephes_bdtr(int k, int n, double p);
    double torch_cephes_bdtri(int k, int n, double y);
+   void torch_cephes_bdtr_batch(int n, double * k, int sk, double * nn,
+                                int snn, double * p, int sp, double * y);
+   void torch_cephes_bdtrc_batch(int n, double * k, int sk, double * nn,
+                                 int snn, double * p, int sp, double * y);
    // cephes/cprob/btdtr.c
    double torch_cephes_btdtr(double a, double b, double x);
+   void torch_cephes_btdtr_batch(int n, double * a, int sa, double * b, int sb,
+                                 double * x, int sx, double * y);
    // cephes/cprob/chdtr.c
    double torch_cephes_chdtrc(double df, double x);
    double torch_cephes_chdtr(double df, double x);
    double torch_cephes_chdtri(double df, double y);
+   void torch_cephes_chdtr_batch(int n, double * df, int sdf,
+                                 double * x, int sx, double * y);
+   void torch_cephes_chdtrc_batch(int n, double * df, int sdf,
+                                  double * x, int sx, double * y);
    // cephes/cprob/expx2.c
    double torch_cephes_expx2(double x, int sign);
    // cephes/cprob/fdtr.c
    double torch_cephes_fdtrc(int ia, int ib, double x);
    double torch_cephes_fdtr(int ia, int ib, double x);
    double torch_cephes_fdtri(int ia, int ib, double y);
+   void torch_cephes_fdtr_batch(int n, double * ia, int sia, double * ib,
+                                int sib, double * x, int sx, double * y);
+   void torch_cephes_fdtrc_batch(int n, double * ia, int sia, double * ib,
+                                 int sib, double * x, int sx, double * y);
    // cephes/cprob/gamma.c
    double torch_cephes_gamma(double x);
    int torch_cephes_sgngam;
@@ -193,36 +336,104 @@ ffi.cdef[[
    // cephes/cprob/gdtr.c
    double torch_cephes_gdtr(double a, double b, double x);
    double torch_cephes_gdtrc(double a, double b, double x);
+   void torch_cephes_gdtr_batch(int n, double * a, int sa, double * b, int sb,
+                                double * x, int sx, double * y);
+   void torch_cephes_gdtrc_batch(int n, double * a, int sa, double * b, int sb,
+                                 double * x, int sx, double * y);
    // cephes/cprob/igam.c
    double torch_cephes_igamc(double a, double x);
    double torch_cephes_igam(double a, double x);
+   void torch_cephes_igamv(int n, double * a, int sa, double * lgm,
+                           double * x, int comp, double * y);
+   void torch_cephes_igam_batch(int n, double * a, int sa,
+                                double * x, int sx, double * y);
+   void torch_cephes_igamc_batch(int n, double * a, int sa,
+                                 double * x, int sx, double * y);
+   void torch_cephes_igam_grad(int n, double * a, int sa, double * x, int sx,
+                               double * y, double * da, double * dx);
+   void torch_cephes_igamc_grad(int n, double * a, int sa, double * x, int sx,
+                                double * y, double * da, double * dx);
    // cephes/cprob/igami.c
    double torch_cephes_igami(double a, double y0);
+   double torch_cephes_igami_lgm(double a, double y0, double * plgm);
    // cephes/cprob/incbet.c
    double torch_cephes_incbet(double aa, double bb, double xx);
+   void torch_cephes_incbetv(int n, double * a, int sa, double * b, int sb,
+                             double * x, double * y);
+   void torch_cephes_incbet_batch(int n, double * a, int sa, double * b, int sb,
+                                  double * x, int sx, double * y);
+   void torch_cephes_incbet_grad(int n, double * a, int sa, double * b, int sb,
+                                 double * x, int sx, double * y,
+                                 double * da, double * db, double * dx);
    // cephes/cprob/incbi.c
    double torch_cephes_incbi(double aa, double bb, double yy0);
+   double torch_cephes_incbi_lgm(double aa, double bb, double yy0,
+                                 double * plgm);
+   // cephes/cprob/kstest.c
+   void torch_cephes_ks_stat(int n, int m, double * u, double * d,
+                             double * dplus, double * dminus);
    // cephes/cprob/nbdtr.c
    double torch_cephes_nbdtrc(int k, int n, double p);
    double torch_cephes_nbdtr(int k, int n, double p);
    double torch_cephes_nbdtri(int k, int n, double p);
+   void torch_cephes_nbdtr_batch(int n, double * k, int sk, double * nn,
+                                 int snn, double * p, int sp, double * y);
+   void torch_cephes_nbdtrc_batch(int n, double * k, int sk, double * nn,
+                                  int snn, double * p, int sp, double * y);
    // cephes/cprob/ndtr.c
    double torch_cephes_ndtr(double a);
    double torch_cephes_erfc(double a);
    double torch_cephes_erf(double x);
+   void torch_cephes_erf_grad(int n, double * x, int sx, double * y, double * dy);
    // cephes/cprob/ndtri.c
    double torch_cephes_ndtri(double y0);
    // cephes/cprob/pdtr.c
    double torch_cephes_pdtrc(int k, double m);
    double torch_cephes_pdtr(int k, double m);
    double torch_cephes_pdtri(int k, double y);
+   void torch_cephes_pdtr_batch(int n, double * k, int sk,
+                                double * m, int sm, double * y);
+   void torch_cephes_pdtrc_batch(int n, double * k, int sk,
+                                 double * m, int sm, double * y);
+   // cephes/cprob/sample.c
+   void torch_cephes_sample_uniform(int n, unsigned long long seed,
+                                    unsigned long long offset, double * y);
+   void torch_cephes_sample_normal(int n, double * mu, int smu,
+                                   double * sigma, int ssigma,
+                                   unsigned long long seed,
+                                   unsigned long long offset, double * y);
+   void torch_cephes_sample_gamma(int n, double * a, int sa,
+                                  double * b, int sb, unsigned long long seed,
+                                  unsigned long long offset, double * y);
+   void torch_cephes_sample_beta(int n, double * a, int sa,
+                                 double * b, int sb, unsigned long long seed,
+                                 unsigned long long offset, double * y);
+   void torch_cephes_sample_chi2(int n, double * df, int sdf,
+                                 unsigned long long seed,
+                                 unsigned long long offset, double * y);
+   void torch_cephes_sample_t(int n, double * df, int sdf,
+                              unsigned long long seed,
+                              unsigned long long offset, double * y);
+   void torch_cephes_sample_f(int n, double * a, int sa,
+                              double * b, int sb, unsigned long long seed,
+                              unsigned long long offset, double * y);
    // cephes/cprob/stdtr.c
    double torch_cephes_stdtr(int k, double t);
    double torch_cephes_stdtri(int k, double p);
+   void torch_cephes_stdtr_batch(int n, double * k, int sk,
+                                 double * t, int st, double * y);
+   // cephes/cprob/kolmogorov.c
+   double torch_cephes_kolmogi(double p);
+   double torch_cephes_kolmogorov(double y);
+   double torch_cephes_smirnov(int n, double e);
+   double torch_cephes_smirnovi(int n, double e);
+   void torch_cephes_smirnov_batch(int m, double * n, int sn,
+                                   double * e, int se, double * y);
+   void torch_cephes_kolmogorov_batch(int m, double * y, int sy, double * p);
 ]]
 
 -- imports for folder misc
-ffi.cdef[[
+declarations.misc = [[
    // cephes/misc/beta.c
    double torch_cephes_beta(double a, double b);
    double torch_cephes_lbeta(double a, double b);
@@ -230,12 +441,31 @@ ffi.cdef[[
    double torch_cephes_dawsn(double xx);
    // cephes/misc/ei.c
    double torch_cephes_ei(double x);
+   void torch_cephes_ei_batch(int n, double * x, int sx, double * y);
    // cephes/misc/expn.c
    double torch_cephes_expn(int n, double x);
+   void torch_cephes_expn_batch(int n, double * k, int sk, double * x, int sx,
+                                double * y);
+   void torch_cephes_expn_orders(int n, int m, double * x, int sx, double * y);
    // cephes/misc/fac.c
    double torch_cephes_fac(int i);
    // cephes/misc/fresnl.c
    int torch_cephes_fresnl(double xxa, double * ssa, double * cca);
+   // cephes/misc/gamgrad.c
+   void torch_cephes_lgam_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_gamma_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_psi_grad(int n, double * x, int sx, double * y, double * dy);
+   void torch_cephes_beta_grad(int n, double * a, int sa, double * b, int sb,
+                               double * y, double * da, double * db);
+   // cephes/misc/mvgam.c
+   double torch_cephes_lmvgam(double x, int p);
+   double torch_cephes_mvgam(double x, int p);
+   void torch_cephes_lmvgam_batch(int n, double * x, int sx, double * p, int sp,
+                                  double * y);
+   void torch_cephes_mvgam_batch(int n, double * x, int sx, double * p, int sp,
+                                 double * y);
+   void torch_cephes_lmvgam_grad(int n, double * x, int sx, double * p, int sp,
+                                 double * y, double * dy);
    // cephes/misc/psi.c
    double torch_cephes_psi(double x);
    // cephes/misc/revers.c
@@ -244,39 +474,108 @@ ffi.cdef[[
    double torch_cephes_rgamma(double x);
    // cephes/misc/shichi.c
    int torch_cephes_shichi(double x, double * si, double * ci);
+   void torch_cephes_shichi_batch(int n, double * x, int sx,
+                                  double * shi, double * chi);
    // cephes/misc/sici.c
    int torch_cephes_sici(double x, double * si, double * ci);
+   void torch_cephes_sici_batch(int n, double * x, int sx,
+                                double * si, double * ci);
    // cephes/misc/simpsn.c
    double torch_cephes_simpsn(double f[], double delta);
+   void torch_cephes_simpsn_batch(int n, int m, double * f, double * delta,
+                                  int sd, int cum, double * y);
+   void torch_cephes_gauleg(int k, double a, double b, double * x, double * w);
    // cephes/misc/spence.c
    double torch_cephes_spence(double x);
+   void torch_cephes_spence_batch(int n, double * x, int sx, double * y);
    // cephes/misc/zeta.c
    double torch_cephes_zeta(double x, double q);
+   double torch_cephes_polygamma(int m, double x);
+   double torch_cephes_trigamma(double x);
+   void torch_cephes_zeta_batch(int n, double * x, int sx, double * q, int sq,
+                                double * y);
+   void torch_cephes_polygamma_batch(int n, double * m, int sm,
+                                     double * x, int sx, double * y);
+   void torch_cephes_trigamma_batch(int n, double * x, int sx, double * y);
    // cephes/misc/zetac.c
    double torch_cephes_zetac(double x);
+   // cephes/misc/polylog.c
+   double torch_cephes_polylog(int n, double x);
+   void torch_cephes_polylog_batch(int n, double * k, int sk,
+                                   double * x, int sx, double * y);
+   void torch_cephes_polylog_orders(int n, int m, double * x, int sx,
+                                    double * y);
 ]]
 
 -- imports for folder ellf
-ffi.cdef[[
+declarations.ellf = [[
    // cephes/ellf/ellie.c
    double torch_cephes_ellie(double phi, double m);
+   void torch_cephes_ellie_batch(int n, double * phi, int sp, double * m, int sm,
+                                 double * y);
+   // cephes/ellf/ellfdes.c
+   typedef struct
+   {
+      int kind;
+      int type;
+      int n;
+      double dbr;
+      double fs;
+      double f1;
+      double f2;
+      double dbd;
+   } ellfspec;
+   typedef struct
+   {
+      int order;
+      double gain;
+      double fs;
+      double f3;
+      double dbdown;
+      cmplx pole[24];
+      cmplx zero[24];
+      double den[25];
+      double num[25];
+   } ellfdesign;
+   int torch_cephes_ellf_design(ellfspec * spec, ellfdesign * out);
+   void torch_cephes_ellf_design_batch(int n, ellfspec * spec, ellfdesign * out,
+                                       int * status);
+   double torch_cephes_ellf_response(ellfdesign * design, double f);
+   int torch_cephes_ellf_sos(ellfdesign * design, double * sos);
    // cephes/ellf/ellik.c
    double torch_cephes_ellik(double phi, double m);
+   void torch_cephes_ellik_batch(int n, double * phi, int sp, double * m, int sm,
+                                 double * y);
    // cephes/ellf/ellpe.c
    double torch_cephes_ellpe(double x);
+   void torch_cephes_ellpe_batch(int n, double * x, int sx, double * y);
    // cephes/ellf/ellpj.c
    int torch_cephes_ellpj(double u, double m, double * sn, double * cn,
                           double * dn, double * ph);
+   void torch_cephes_ellpj_batch(int n, double * u, int su, double * m, int sm,
+                                 double * sn, double * cn, double * dn,
+                                 double * ph);
    // cephes/ellf/ellpk.c
    double torch_cephes_ellpk(double x);
+   void torch_cephes_ellpk_batch(int n, double * x, int sx, double * y);
+   // cephes/ellf/sosfilt.c
+   void torch_cephes_sosfilt(int ns, double * sos, int sc, int nch, int nt,
+                             double * x, double * y, double * z);
 ]]
 
 -- imports for folder polyn
-ffi.cdef[[
+declarations.polyn = [[
    // cephes/polyn/euclid.c
    double torch_cephes_euclid(double * num, double * den);
    // cephes/polyn/polrt.c
    int torch_cephes_polrt(double xcof[], double cof[], int m, cmplx root[]);
+   void torch_cephes_polrt_batch(int n, int m, double * xcof, cmplx * root,
+                                 int * status);
+   // cephes/polyn/polfft.c
+   int torch_cephes_POLFFT;
+   void torch_cephes_polfmul(double a[], int na, double b[], int nb,
+                             double c[], int nc);
+   void torch_cephes_polfrcp(double a[], int na, double c[], int nc);
    // cephes/polyn/polyn.c
    void torch_cephes_polini(int maxdeg);
    void torch_cephes_polprt(double a[], int na, int d);
@@ -288,48 +587,56 @@ ffi.cdef[[
    int torch_cephes_poldiv(double a[], int na, double b[], int nb, double c[]);
    void torch_cephes_polsbt(double a[], int na, double b[], int nb, double c[]);
    double torch_cephes_poleva(double a[], int na, double x);
+   void torch_cephes_poleva_batch(int m, double * a, int na, int sa, int n,
+                                  double * x, int sx, double * y);
+   // cephes/polyn/series.c
+   void torch_cephes_series_batch(int op, int n, int d, double * a, int sa,
+                                  double * b, int sb, double * c, int * status);
    // cephes/polyn/polyr.c: disabled to avoid naming clash with regular polynomials
    // cephes/polyn/revers.c
    void torch_cephes_revers(double y[], double x[], int n);
-]]
-
--- For those few exceptions that escaped our automatic parser
-ffi.cdef[[
-    // Escaped due to return type on a line per itself
-    // cephes/cmath/clog.c
-    void torch_cephes_csinh(cmplx *z, cmplx *w);
-    void torch_cephes_casinh(cmplx *z, cmplx *w);
-    void torch_cephes_ccosh(cmplx *z, cmplx *w);
-    void torch_cephes_cacosh(cmplx *z, cmplx *w);
-    void torch_cephes_ctanh(cmplx *z, cmplx *w);
-    void torch_cephes_catanh(cmplx *z, cmplx *w);
-    void torch_cephes_cpow(cmplx *a, cmplx *z, cmplx *w);
-    // cephes/cprob/kolmogorov.c
-    double torch_cephes_kolmogi(double p);
-    double torch_cephes_kolmogorov(double y);
-    double torch_cephes_smirnov(int n, double e);
-    double torch_cephes_smirnovi(int n, double e);
-    // cephes/polyn/polmisc.c
-    void torch_cephes_polatn(double num[], double den[], double ans[], int nn);
-    void torch_cephes_polsqt(double pol[], double ans[], int nn);
-    void torch_cephes_polsin(double x[], double y[], int nn);
-    void torch_cephes_polcos(double x[], double y[], int nn);
-    // cephes/misc/polylog.c
-    double torch_cephes_polylog(int n, double x);
+   // cephes/polyn/polmisc.c
+   void torch_cephes_polatn(double num[], double den[], double ans[], int nn);
+   void torch_cephes_polsqt(double pol[], double ans[], int nn);
+   void torch_cephes_polsin(double x[], double y[], int nn);
+   void torch_cephes_polcos(double x[], double y[], int nn);
 ]]
 
 -- Error handling with soft wrapping of all functions
 torch.include('cephes', 'error_handling.lua')
+torch.include('cephes', 'batch.lua')
+torch.include('cephes', 'grad.lua')
 torch.include('cephes', 'limits.lua')
 torch.include('cephes', 'cmath.lua')
 torch.include('cephes', 'bessel.lua')
 torch.include('cephes', 'misc.lua')
+torch.include('cephes', 'sample.lua')
+torch.include('cephes', 'kstest.lua')
+torch.include('cephes', 'ellf.lua')
+torch.include('cephes', 'polyn.lua')
+
+--[[ Undefined indexing.
 
--- Use metatable to pass all undefined indexing to cephes.ffi
+The wrappers of a folder are created on first use of one of them, see
+cephes._wrapped, and cephes.<folder> is the table of these wrappers,
+for the folders whose name is not taken by a function (all but ellf).
+Anything else is passed to cephes.ffi.
+--]]
+local isFolder = {}
+for _, folder in ipairs(folders) do
+    isFolder[folder] = true
+end
 local mt = {}
 setmetatable(cephes, mt)
 mt.__index = function(table, key)
-    return rawget(cephes, key) or cephes.ffi[key]
+    local value = cephes._wrapped(key)
+    if value ~= nil then
+        return value
+    end
+    if isFolder[key] then
+        return cephes._wrappersOf(key)
+    end
+    return cephes.ffi[key]
 end
 
 return cephes
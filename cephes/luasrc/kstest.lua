@@ -0,0 +1,95 @@
+--[[ Kolmogorov-Smirnov goodness of fit tests, one per column of a matrix.
+
+The samples are given already mapped through the distribution function
+under test, so that they are uniform on [0, 1] under the null hypothesis:
+
+    -- does each of the 1000 columns of x look standard normal?
+    local D, p = cephes.kstest(cephes.ndtr(x):resize(x:size()))
+    local drifted = p:lt(1e-3)
+
+The statistics of the columns are computed in parallel by the native
+ks_stat, and their p-values by the batch kernels of smirnov and
+kolmogorov, with the combinatorial terms of smirnov shared by all the
+columns.
+]]
+
+local ffi = require 'ffi'
+
+--[[! Kolmogorov-Smirnov test of each column of a matrix
+
+@param u vector of n samples, or n x m matrix of m columns of n samples,
+       with values in [0, 1]
+@param alternative 'two-sided' (default) for D = sup |S(x) - P(x)|,
+       'greater' for D+ = sup (S(x) - P(x)), 'less' for D- = sup (P(x) - S(x))
+@param method p-value of the two-sided test: 'bound' (default) for
+       min(1, 2 smirnov(n, D)), the sum of the one-sided p-values, an
+       upper bound of the exact p-value that is close to it in the tail
+       and equal to it for D >= 0.5; 'asymptotic' for kolmogorov(sqrt(n) D),
+       the large n limit. One-sided tests use smirnov(n, D+) or
+       smirnov(n, D-), exact.
+
+@return statistic, number for a vector u or vector of m values
+@return p-value, same form
+--]]
+function cephes.kstest(u, alternative, method)
+    alternative = alternative or 'two-sided'
+    method = method or 'bound'
+    if not torch.isTensor(u) or (u:dim() ~= 1 and u:dim() ~= 2) then
+        error('cephes.kstest: expected a vector or a matrix of samples')
+    end
+    if alternative ~= 'two-sided' and alternative ~= 'greater' and alternative ~= 'less' then
+        error("cephes.kstest: unknown alternative '" .. tostring(alternative) .. "'")
+    end
+    if method ~= 'bound' and method ~= 'asymptotic' then
+        error("cephes.kstest: unknown method '" .. tostring(method) .. "'")
+    end
+
+    local vector = u:dim() == 1
+    local n = u:size(1)
+    local m = vector and 1 or u:size(2)
+    local samples = u:double():contiguous()
+    local d = torch.DoubleTensor(m)
+    local dplus = torch.DoubleTensor(m)
+    local dminus = torch.DoubleTensor(m)
+
+    cephes._resetError()
+    cephes.ffi.ks_stat(n, m, torch.data(samples), torch.data(d),
+                       torch.data(dplus), torch.data(dminus))
+    cephes._reportError()
+
+    local statistic = d
+    if alternative == 'greater' then
+        statistic = dplus
+    elseif alternative == 'less' then
+        statistic = dminus
+    end
+
+    local p = torch.DoubleTensor(m)
+    local pdata = torch.data(p)
+    if alternative == 'two-sided' and method == 'asymptotic' then
+        local y = statistic:clone():mul(math.sqrt(n))
+        cephes.ffi.kolmogorov_batch(m, torch.data(y), 1, pdata)
+    else
+        local count = ffi.new('double[1]', n)
+        cephes.ffi.smirnov_batch(m, count, 0, torch.data(statistic), 1, pdata)
+        if alternative == 'two-sided' then
+            for i = 0, m - 1 do
+                pdata[i] = math.min(1, 2 * pdata[i])
+            end
+        end
+    end
+    local sdata = torch.data(statistic)
+    for i = 0, m - 1 do
+        -- invalid columns
+        if sdata[i] < 0 or sdata[i] ~= sdata[i] then
+            pdata[i] = 0/0
+        else
+            pdata[i] = math.min(1, math.max(0, pdata[i]))
+        end
+    end
+
+    if vector then
+        return statistic[1], p[1]
+    end
+    return statistic, p
+end
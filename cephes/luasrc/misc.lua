@@ -1,53 +1,245 @@
 
--- Formula taken from scipy:
--- https://github.com/scipy/scipy/blob/c79a9fee6b03cd196af203bad1063958cc3fe3a8/scipy/special/basic.py
-function cephes.polygamma(m, x)
-    if m == 0 then
-        return cephes.psi(x)
-    end
-    return math.pow(-1, m + 1) * cephes.gamma(m + 1) * cephes.zeta(m + 1, x)
-end
+-- cephes.polygamma(m, x) and cephes.trigamma(x) are native, see misc/zeta.c
 
--- Formula taken from:
+-- Derivative of beta(x, y) in x, beta(x, y) * (digamma(x) - digamma(x + y)):
 -- http://en.wikipedia.org/w/index.php?title=Beta_function&oldid=570848869#Derivatives
 function cephes.betagrad(x, y)
-    return cephes.beta(x, y) * (cephes.digamma(x) - cephes.digamma(x + y))
+    local _, dx = cephes.grad.beta(x, y)
+    return dx
 end
 
---[[ Log Multivariate Gamma Function.
+--[[ Log Multivariate Gamma Function and its derivative.
     The multivariate Gamma function generalizes the gamma function:
     $\Gamma_p(x) = \pi^{p(p-1)/4} \prod_{j=1}^p \Gamma[x + (1-j)/2]
 
+cephes.lmvgam(x, p) and cephes.mvgam(x, p) are native, see misc/mvgam.c.
+This evaluates log($\Gamma_p(x)$) and its derivative in x, the sum of
+the digammas $\psi[x + (1-j)/2]$, in the same pass.
+
 Parameters:
 
-* `x` value passed to multivariate gamma function
-* `p` degree of multivariate gamma function. If 1, reduces to log gamma
+* `x` value passed to multivariate gamma function, number or tensor
+* `p` degree of multivariate gamma function, number or tensor. If 1,
+  reduces to log gamma
 
 Returns:
- 
-1. log($\Gamma_p(x)$)
+
+1. log($\Gamma_p(x)$), number if x and p are numbers, tensor otherwise
+2. d/dx log($\Gamma_p(x)$), same form
 ]]
-function cephes.lmvgam(x,p)
-  local result = p * (p-1) / 4 * math.log(math.pi)
-  for j = 1, p do
-    result = result + cephes.lgam(x + (1-j)/2)
-  end
-  return result
+cephes.lmvgamgrad = cephes.grad.lmvgam
+
+-- Values of the orders 1 to n of the function name at x, from the native
+-- kernel name_orders(N, n, x, sx, y)
+local function orders(name, n, x)
+    if type(n) ~= 'number' or n < 1 then
+        error('cephes.' .. name .. 's: the order must be a number >= 1')
+    end
+    n = math.floor(n)
+    local input = x
+    if type(x) == 'number' then
+        input = torch.DoubleTensor{ x }
+    elseif not torch.isTensor(x) then
+        error('cephes.' .. name .. 's: invalid type ' .. type(x) .. ' for x')
+    end
+    input = input:double():contiguous()
+    local N = input:nElement()
+    local result = torch.DoubleTensor(N, n)
+
+    cephes._resetError()
+    cephes.ffi[name .. '_orders'](N, n, torch.data(input), 1, torch.data(result))
+    cephes._reportError()
+
+    if type(x) == 'number' then
+        return result[1]
+    end
+    local size = torch.LongStorage(x:dim() + 1)
+    for dim = 1, x:dim() do
+        size[dim] = x:size(dim)
+    end
+    size[x:dim() + 1] = n
+    return result:resize(size)
 end
 
---[[ Multivariate Gamma Function.
-    The multivariate Gamma function generalizes the gamma function:
-    $\Gamma_p(x) = \pi^{p(p-1)/4} \prod_{j=1}^p \Gamma[x + (1-j)/2]
+--[[ Polylogarithms of the orders 1 to n.
+
+cephes.polylog(n, x) evaluates a single order. This evaluates
+Li_1(x), ..., Li_n(x) in one pass, sharing the powers of x or of log(x)
+between the orders, see polylog_orders in misc/polylog.c.
+
+Parameters:
+
+* `n` highest order, number >= 1
+* `x` argument, number or tensor, x <= 1
+
+Returns:
+
+1. vector of the n values Li_1(x), ..., Li_n(x) if x is a number,
+   tensor of the size of x with an extra last dimension of size n otherwise
+]]
+function cephes.polylogs(n, x)
+    return orders('polylog', n, x)
+end
+
+--[[ Exponential integrals of the orders 1 to n.
+
+cephes.expn(n, x) evaluates a single order. This evaluates
+E_1(x), ..., E_n(x) from one evaluation of expn and the recurrence
+between the orders, see expn_orders in misc/expn.c.
 
 Parameters:
 
-* `x` value passed to multivariate gamma function
-* `p` degree of multivariate gamma function. If 1, reduces to log gamma
+* `n` highest order, number >= 1
+* `x` argument, number or tensor, x > 0
 
 Returns:
- 
-1. $\Gamma_p(x)$
+
+1. vector of the n values E_1(x), ..., E_n(x) if x is a number,
+   tensor of the size of x with an extra last dimension of size n otherwise
 ]]
-function cephes.mvgam(...)
-  return cephes.exp(cephes.lmvgam(...))
-end
\ No newline at end of file
+function cephes.expns(n, x)
+    return orders('expn', n, x)
+end
+
+-- Functions of several results, which the C function stores through
+-- pointers: called without the pointers, with numbers or tensors as
+-- arguments, they return the results, as numbers if all the arguments
+-- are numbers and as tensors of the size of the largest argument
+-- otherwise, from the native name_batch
+local function multipleResults(name, nargs, nresults)
+    local scalar
+    cephes[name] = function(...)
+        for index = nargs + 1, nargs + nresults do
+            if select(index, ...) ~= nil then
+                scalar = scalar or cephes._wrapped(name)
+                return scalar(...)
+            end
+        end
+        local N = cephes._batchSize(...)
+        local size
+        local args, keep = {}, {}
+        for index = 1, nargs do
+            local param = select(index, ...)
+            if torch.isTensor(param) and param:nElement() == N then
+                size = size or param:size()
+            end
+            local tensor, data, stride = cephes._batchParam(param, N, index)
+            keep[index] = tensor
+            args[2 * index - 1] = data
+            args[2 * index] = stride
+        end
+        local outputs = {}
+        for index = 1, nresults do
+            outputs[index] = torch.DoubleTensor(N)
+            args[2 * nargs + index] = torch.data(outputs[index])
+        end
+
+        cephes._resetError()
+        cephes.ffi[name .. '_batch'](N, unpack(args, 1, 2 * nargs + nresults))
+        cephes._reportError()
+
+        for index = 1, nresults do
+            if size then
+                outputs[index] = outputs[index]:resize(size)
+            else
+                outputs[index] = outputs[index][1]
+            end
+        end
+        return unpack(outputs, 1, nresults)
+    end
+end
+
+--[[ Hyperbolic sine and cosine integrals.
+
+cephes.shichi(x, shi, chi) stores Shi(x) and Chi(x) through the pointers
+shi and chi, as the C function does. cephes.shichi(x) returns them:
+
+    local shi, chi = cephes.shichi(torch.linspace(0.1, 10, 100))
+]]
+multipleResults('shichi', 1, 2)
+
+--[[ Sine and cosine integrals.
+
+cephes.sici(x, si, ci) stores Si(x) and Ci(x) through the pointers si
+and ci, as the C function does. cephes.sici(x) returns them, as numbers
+for a number x and as tensors of the size of x otherwise.
+]]
+multipleResults('sici', 1, 2)
+
+--[[ Jacobian elliptic functions.
+
+cephes.ellpj(u, m, sn, cn, dn, ph) stores sn(u|m), cn(u|m), dn(u|m) and
+the amplitude through the pointers, as the C function does.
+cephes.ellpj(u, m) returns the four of them, as numbers if u and m are
+numbers and as tensors otherwise. u and m are numbers or tensors with
+either 1 element or one element per element of the batch; the
+arithmetic-geometric mean of a modulus is computed once for all the u
+that share it:
+
+    local sn, cn, dn, ph = cephes.ellpj(torch.linspace(0, 10, 1000), 0.7)
+]]
+multipleResults('ellpj', 2, 4)
+
+--[[ Integration of tabulated functions, and Gauss-Legendre rules.
+
+cephes.simpsn(f, delta) with a pointer f integrates one panel of 9 samples,
+as the C function does. With a tensor f, it integrates each row of f by
+composite Cotes rules over all its samples, see simpsn_batch in
+misc/simpsn.c:
+
+    local area = cephes.simpsn(samples, delta)        -- B x N samples
+    local running = cephes.simpsn(samples, delta, true)
+
+Parameters:
+
+* `f` vector of N samples, or B x N tensor of B functions
+* `delta` spacing of the samples, number or tensor of B spacings
+* `cumulative` if true, the integrals from the first sample to each one
+
+Returns the integral, a number for a vector and a tensor of B values
+otherwise, or the cumulative integrals, of the size of f.
+
+cephes.gauleg(k, a, b) returns the k nodes and weights of the Gauss-
+Legendre rule on [a, b], default [-1, 1]: for the B x k values of B
+functions at the nodes, torch.mv(values, w) are the integrals.
+]]
+-- wrapper of the C function, resolved on the first call with a pointer
+local simpsn
+function cephes.simpsn(f, delta, cumulative)
+    if not torch.isTensor(f) then
+        simpsn = simpsn or cephes._wrapped('simpsn')
+        return simpsn(f, delta)
+    end
+    if f:dim() ~= 1 and f:dim() ~= 2 then
+        error('cephes.simpsn: expected a vector or a matrix of samples')
+    end
+    local samples = f:double():contiguous()
+    local B = f:dim() == 1 and 1 or f:size(1)
+    local N = f:size(f:dim())
+    local spacing
+    if type(delta) == 'number' then
+        spacing = torch.DoubleTensor{ delta }
+    elseif torch.isTensor(delta) and (delta:nElement() == 1 or delta:nElement() == B) then
+        spacing = delta:double():contiguous()
+    else
+        error('cephes.simpsn: expected a number or ' .. B .. ' spacings')
+    end
+    local result = cumulative and torch.DoubleTensor(f:size()) or torch.DoubleTensor(B)
+    cephes.ffi.simpsn_batch(B, N, torch.data(samples), torch.data(spacing),
+                            spacing:nElement() == 1 and 0 or 1, cumulative and 1 or 0,
+                            torch.data(result))
+    if f:dim() == 1 and not cumulative then
+        return result[1]
+    end
+    return result
+end
+
+function cephes.gauleg(k, a, b)
+    if type(k) ~= 'number' or k < 1 then
+        error('cephes.gauleg: the number of nodes must be a number >= 1')
+    end
+    k = math.floor(k)
+    local x, w = torch.DoubleTensor(k), torch.DoubleTensor(k)
+    cephes.ffi.gauleg(k, a or -1, b or 1, torch.data(x), torch.data(w))
+    return x, w
+end
@@ -0,0 +1,195 @@
+--[[ nn modules of the special functions, on the fused kernels of cephes.grad.
+
+    require 'cephes.nn'
+
+    local model = nn.Sequential()
+        :add(nn.Linear(10, 10))
+        :add(nn.SoftPlus())
+        :add(cephes.nn.LogGamma())
+
+The forward pass of a module evaluates the function together with its
+derivative, which the backward pass multiplies into gradOutput. Outputs,
+gradients and derivatives live in buffers that the module keeps and
+resizes across iterations, so that a training loop over batches of the
+same size allocates nothing. The functions are evaluated in double
+precision; modules of another type convert through buffers of their own.
+
+This file is not loaded by require 'cephes', which does not depend on nn.
+]]
+
+require 'cephes'
+require 'nn'
+local ffi = require 'ffi'
+
+cephes.nn = rawget(cephes, 'nn') or {}
+
+-- Contiguous DoubleTensor of the module, resized to size
+local function buffer(module, key, size)
+    local tensor = module[key]
+    if torch.typename(tensor) ~= 'torch.DoubleTensor' then
+        tensor = torch.DoubleTensor()
+        module[key] = tensor
+    end
+    return tensor:resize(size)
+end
+
+-- tensor itself if it is a contiguous DoubleTensor, else a copy into the
+-- buffer key of the module
+local function asDouble(module, key, tensor)
+    if torch.typename(tensor) == 'torch.DoubleTensor' and tensor:isContiguous() then
+        return tensor
+    end
+    return buffer(module, key, tensor:size()):copy(tensor)
+end
+
+-- Buffer for the result of a kernel that ends up in target: target itself
+-- when the kernel can write into it
+local function resultFor(module, key, target, size)
+    if torch.typename(target) == 'torch.DoubleTensor' then
+        target:resize(size)
+        if target:isContiguous() then
+            return target
+        end
+    end
+    return buffer(module, key, size)
+end
+
+-- target = gradOutput .* derivative, through a buffer if needed
+local function chain(module, key, target, gradOutput, derivative)
+    local grad = asDouble(module, '_gradOutput', gradOutput)
+    local work = resultFor(module, key, target, derivative:size())
+    work:cmul(grad, derivative)
+    if work ~= target then
+        target:resize(derivative:size()):copy(work)
+    end
+    return target
+end
+
+
+--[[ Element-wise function f with derivative, from the kernel name_grad ]]
+local Elementwise, parent = torch.class('cephes.nn.Elementwise', 'nn.Module', cephes.nn)
+
+function Elementwise:__init(name)
+    parent.__init(self)
+    self.name = name
+end
+
+function Elementwise:updateOutput(input)
+    local x = asDouble(self, '_input', input)
+    local y = resultFor(self, '_output', self.output, input:size())
+    local dy = buffer(self, '_derivative', input:size())
+    cephes._resetError()
+    cephes.ffi[self.name .. '_grad'](x:nElement(), torch.data(x), 1,
+                                     torch.data(y), torch.data(dy))
+    cephes._reportError()
+    if y ~= self.output then
+        self.output:resize(input:size()):copy(y)
+    end
+    return self.output
+end
+
+function Elementwise:updateGradInput(input, gradOutput)
+    return chain(self, '_gradInput', self.gradInput, gradOutput, self._derivative)
+end
+
+function Elementwise:clearState()
+    return nn.utils.clear(self, '_input', '_output', '_derivative',
+                          '_gradOutput', '_gradInput', 'output', 'gradInput')
+end
+
+-- log |gamma(x)|, derivative digamma(x)
+local LogGamma = torch.class('cephes.nn.LogGamma', 'cephes.nn.Elementwise', cephes.nn)
+function LogGamma:__init() Elementwise.__init(self, 'lgam') end
+
+-- digamma(x), derivative trigamma(x)
+local Digamma = torch.class('cephes.nn.Digamma', 'cephes.nn.Elementwise', cephes.nn)
+function Digamma:__init() Elementwise.__init(self, 'psi') end
+
+-- erf(x)
+local Erf = torch.class('cephes.nn.Erf', 'cephes.nn.Elementwise', cephes.nn)
+function Erf:__init() Elementwise.__init(self, 'erf') end
+
+-- Exponentially scaled modified Bessel functions exp(-|x|) I0(x), exp(-|x|) I1(x)
+local BesselI0e = torch.class('cephes.nn.BesselI0e', 'cephes.nn.Elementwise', cephes.nn)
+function BesselI0e:__init() Elementwise.__init(self, 'i0e') end
+local BesselI1e = torch.class('cephes.nn.BesselI1e', 'cephes.nn.Elementwise', cephes.nn)
+function BesselI1e:__init() Elementwise.__init(self, 'i1e') end
+
+
+--[[ Regularized incomplete gamma integral igam(a, x), or igamc(a, x)
+
+@param a shape parameter, a number; if nil, the input is the table {a, x}
+       of a tensor of shapes, or a number, and a tensor of arguments
+@param upper true for igamc(a, x), the upper integral
+--]]
+local IncGamma, parent = torch.class('cephes.nn.IncGamma', 'nn.Module', cephes.nn)
+
+function IncGamma:__init(a, upper)
+    parent.__init(self)
+    self.a = a
+    self.name = upper and 'igamc' or 'igam'
+    if a == nil then
+        self.gradInput = {}
+    end
+end
+
+function IncGamma:updateOutput(input)
+    local a, x = self.a, input
+    if a == nil then
+        a, x = input[1], input[2]
+    end
+    local N = x:nElement()
+    x = asDouble(self, '_input', x)
+    local adata, sa
+    if torch.isTensor(a) then
+        if a:nElement() ~= N and a:nElement() ~= 1 then
+            error('cephes.nn.IncGamma: a has ' .. a:nElement() .. ' elements, expected 1 or ' .. N)
+        end
+        local at = asDouble(self, '_a', a)
+        adata, sa = torch.data(at), a:nElement() == 1 and 0 or 1
+    else
+        adata, sa = ffi.new('double[1]', a), 0
+    end
+
+    local y = resultFor(self, '_output', self.output, x:size())
+    local da = buffer(self, '_derivativeA', x:size())
+    local dx = buffer(self, '_derivative', x:size())
+    cephes._resetError()
+    cephes.ffi[self.name .. '_grad'](N, adata, sa, torch.data(x), 1,
+                                     torch.data(y), torch.data(da), torch.data(dx))
+    cephes._reportError()
+    if y ~= self.output then
+        self.output:resize(x:size()):copy(y)
+    end
+    return self.output
+end
+
+function IncGamma:updateGradInput(input, gradOutput)
+    if self.a ~= nil then
+        return chain(self, '_gradInput', self.gradInput, gradOutput, self._derivative)
+    end
+
+    local a = input[1]
+    self.gradInput[2] = self.gradInput[2] or input[2].new()
+    chain(self, '_gradInput', self.gradInput[2], gradOutput, self._derivative)
+    if torch.isTensor(a) then
+        self.gradInput[1] = self.gradInput[1] or a.new()
+        local ga = chain(self, '_gradA', buffer(self, '_gradA', self._derivativeA:size()),
+                         gradOutput, self._derivativeA)
+        if a:nElement() == 1 then
+            -- a shared by all the elements
+            self.gradInput[1]:resizeAs(a):fill(ga:sum())
+        else
+            self.gradInput[1]:resizeAs(a):copy(ga)
+        end
+    else
+        self.gradInput[1] = nil
+    end
+    return self.gradInput
+end
+
+function IncGamma:clearState()
+    return nn.utils.clear(self, '_input', '_a', '_output', '_derivative',
+                          '_derivativeA', '_gradOutput', '_gradInput', '_gradA',
+                          'output')
+end
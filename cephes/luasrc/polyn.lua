@@ -0,0 +1,174 @@
+--[[ Batches of polynomials, one per row of a matrix of coefficients.
+
+Coefficients are in ascending order, as in polyn/polyn.c: row b of an
+n x (m+1) matrix holds the coefficients of x^0 .. x^m of polynomial b.
+
+    -- eigenvalues of many small matrices, from their characteristic
+    -- polynomials
+    local roots, status = cephes.polroots(coef)
+    local real = roots:select(3, 1)
+
+    -- each polynomial at its own n points
+    local y = cephes.polyval(coef, x)   -- x and y n x npoints
+
+The functions of cephes.series take and return power series truncated at
+degree d, vectors of d+1 coefficients or n x (d+1) matrices of n series,
+and operate on batches in parallel: add, mul, div, compose, exp, log,
+sqrt, sin, cos and atan. The Taylor coefficients of f at many points t,
+up to degree d, are those of f(t + x):
+
+    local s = torch.zeros(n, d + 1)
+    s:select(2, 1):copy(t)
+    s:select(2, 2):fill(1)
+    local taylor = cephes.series.exp(cephes.series.sin(s))
+]]
+
+local ffi = require 'ffi'
+
+local messages = {
+    [3] = 'no convergence in 500 iterations',
+    [4] = 'leading coefficient is zero',
+}
+
+-- Contiguous DoubleTensor of the coefficients of a vector or a matrix
+local function coefficients(name, coef)
+    if not torch.isTensor(coef) or (coef:dim() ~= 1 and coef:dim() ~= 2) then
+        error('cephes.' .. name .. ': expected a vector or a matrix of coefficients')
+    end
+    return coef:double():contiguous()
+end
+
+--[[! Roots of each polynomial of a batch
+
+The roots of all the polynomials are refined at once by polrt_batch,
+an Aberth-Ehrlich iteration in parallel over the polynomials.
+
+@param coef vector of the m+1 coefficients of one polynomial of degree m,
+       or n x (m+1) matrix of n polynomials, 1 <= m <= 36
+
+@return m x 2 tensor of the real and imaginary parts of the roots, or
+        n x m x 2 for a matrix; the roots of real polynomials come in
+        conjugate pairs, up to rounding, in no particular order
+@return status: 0 if all the roots converged, 3 if some did not or a
+        coefficient is not finite, the roots then NaN, 4 if
+        the leading coefficient is 0; a number for a vector, an
+        IntTensor of n codes for a matrix
+@return error message for a vector with a status other than 0
+--]]
+function cephes.polroots(coef)
+    local c = coefficients('polroots', coef)
+    local n = c:dim() == 1 and 1 or c:size(1)
+    local m = c:size(c:dim()) - 1
+    if m < 1 or m > 36 then
+        error('cephes.polroots: degree ' .. m .. ', expected 1 to 36')
+    end
+    local roots = c:dim() == 1 and torch.DoubleTensor(m, 2) or torch.DoubleTensor(n, m, 2)
+    local status = torch.IntTensor(n)
+    cephes.ffi.polrt_batch(n, m, torch.data(c), ffi.cast('cmplx *', torch.data(roots)),
+                           torch.data(status))
+    if c:dim() == 1 then
+        return roots, status[1], messages[status[1]]
+    end
+    return roots, status
+end
+
+--[[! Values of one polynomial, or of each polynomial of a batch
+
+The polynomials are evaluated by poleva_batch, with Horner's rule run on
+blocks of points at once, in parallel over the blocks.
+
+@param coef vector of the m+1 coefficients of one polynomial, or
+       n x (m+1) matrix of n polynomials
+@param x tensor of points: for one polynomial, of any size; for a
+       matrix, n x npoints to give each polynomial its own points, or a
+       vector of npoints for all of them
+
+@return tensor of the size of x for one polynomial, n x npoints for a
+        matrix
+--]]
+function cephes.polyval(coef, x)
+    local c = coefficients('polyval', coef)
+    local m = c:size(c:dim()) - 1
+    if not torch.isTensor(x) then
+        error('cephes.polyval: expected a tensor of points')
+    end
+    local points = x:double():contiguous()
+    local n, npoints, sx, result
+    if c:dim() == 1 then
+        n, npoints, sx = 1, points:nElement(), 0
+        result = torch.DoubleTensor(points:size())
+    else
+        n = c:size(1)
+        if points:dim() == 1 then
+            npoints, sx = points:size(1), 0
+        elseif points:dim() == 2 and points:size(1) == n then
+            npoints = points:size(2)
+            sx = npoints
+        else
+            error('cephes.polyval: expected ' .. n .. ' x npoints points, or a vector')
+        end
+        result = torch.DoubleTensor(n, npoints)
+    end
+    if m < 0 or npoints == 0 then
+        return result:zero()
+    end
+    cephes.ffi.poleva_batch(n, torch.data(c), m, m + 1, npoints, torch.data(points), sx,
+                            torch.data(result))
+    return result
+end
+
+
+-- Operation codes of series_batch, and the messages of status 1
+local seriesOps = {
+    add = { 0, 2 }, mul = { 1, 2 }, div = { 2, 2, 'constant term of the divisor is zero' },
+    compose = { 3, 2 }, exp = { 4, 1 }, log = { 5, 1, 'constant term is not positive' },
+    sqrt = { 6, 1, 'constant term is not positive' }, sin = { 7, 1 }, cos = { 8, 1 },
+    atan = { 9, 1 },
+}
+
+--[[ Arithmetic of truncated power series, in batches
+
+cephes.series.add(a, b), mul(a, b), div(a, b) for a / b, compose(a, b)
+for a(b(x)), exp(a), log(a), sqrt(a), sin(a), cos(a) and atan(a).
+
+@param a, b vectors of the d+1 coefficients of x^0 .. x^d of one series,
+       or n x (d+1) matrices of n series; a vector goes with every row
+       of a matrix
+
+@return the series of the result, truncated at degree d: a vector if the
+        arguments are vectors, otherwise an n x (d+1) matrix
+@return status: 0, or 1 if the constant term of a for log and sqrt, or
+        of b for div, is outside the domain, the coefficients of the
+        result being NaN; a number for vectors, an IntTensor of n codes
+        for matrices
+@return error message for vectors with a status other than 0
+--]]
+cephes.series = {}
+
+for name, op in pairs(seriesOps) do
+    cephes.series[name] = function(a, b)
+        local fullName = 'series.' .. name
+        local ca = coefficients(fullName, a)
+        local cb = op[2] == 2 and coefficients(fullName, b) or ca
+        local d = ca:size(ca:dim()) - 1
+        if cb:size(cb:dim()) ~= d + 1 then
+            error('cephes.' .. fullName .. ': series of different degrees')
+        end
+        local na = ca:dim() == 1 and 1 or ca:size(1)
+        local nb = cb:dim() == 1 and 1 or cb:size(1)
+        if ca:dim() == 2 and cb:dim() == 2 and na ~= nb then
+            error('cephes.' .. fullName .. ': ' .. na .. ' and ' .. nb .. ' series')
+        end
+        local n = math.max(na, nb)
+        local vector = ca:dim() == 1 and cb:dim() == 1
+        local result = vector and torch.DoubleTensor(d + 1) or torch.DoubleTensor(n, d + 1)
+        local status = torch.IntTensor(n)
+        cephes.ffi.series_batch(op[1], n, d, torch.data(ca), ca:dim() == 1 and 0 or d + 1,
+                                torch.data(cb), cb:dim() == 1 and 0 or d + 1,
+                                torch.data(result), torch.data(status))
+        if vector then
+            return result, status[1], status[1] ~= 0 and op[3] or nil
+        end
+        return result, status
+    end
+end
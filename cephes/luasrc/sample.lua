@@ -0,0 +1,91 @@
+--[[ Random variates from the cprob distributions.
+
+Each sampler takes the distribution parameters followed by either the
+number of variates to draw or a tensor to fill, and returns a tensor.
+Parameters are numbers or tensors; tensors must have one element per
+variate. The variates are obtained by inversion of the distribution
+function on a native uniform stream, in parallel.
+
+    cephes.sample.seed(42)
+    local x = cephes.sample.gamma(1, 2.5, 1000)     -- rate 1, shape 2.5
+    cephes.sample.normal(0, torch.linspace(1, 2, 10), torch.Tensor(10))
+]]
+
+cephes.sample = {}
+
+local seed = os.time()
+local offset = 0
+
+--[[ Set the seed of the uniform stream, and restart it.
+Two runs with the same seed and the same sequence of calls draw the same
+variates, whatever the number of threads.
+]]
+function cephes.sample.seed(s)
+    seed = s
+    offset = 0
+end
+
+-- Returns the current seed of the uniform stream
+function cephes.sample.getSeed()
+    return seed
+end
+
+-- Wrap the native sampler name, which takes K parameters
+local function create_sampler(name, K)
+    local cephesFunction
+
+    return function(...)
+        local argCount = select('#', ...)
+        if argCount ~= K + 1 then
+            error('cephes.sample.' .. name .. ': need ' .. K ..
+                  ' parameters and the number of samples or a result tensor, got ' ..
+                  argCount .. ' arguments')
+        end
+        local last = select(K + 1, ...)
+        local N, result
+        if torch.isTensor(last) then
+            result = last
+            N = last:nElement()
+        elseif type(last) == 'number' and last >= 0 and last == math.floor(last) then
+            N = last
+        else
+            error('cephes.sample.' .. name .. ': invalid number of samples ' .. tostring(last))
+        end
+
+        local args = {}
+        local keep = {}
+        for index = 1, K do
+            local tensor, data, stride = cephes._batchParam(select(index, ...), N, index)
+            keep[index] = tensor
+            args[2 * index - 1] = data
+            args[2 * index] = stride
+        end
+        local work
+        result, work = cephes._batchResult(result, N)
+
+        cephesFunction = cephesFunction or cephes.ffi['sample_' .. name]
+        cephes._resetError()
+        args[2 * K + 1] = seed
+        args[2 * K + 2] = offset
+        args[2 * K + 3] = torch.data(work)
+        cephesFunction(N, unpack(args, 1, 2 * K + 3))
+        offset = offset + N
+        cephes._reportError()
+        return cephes._batchDone(result, work)
+    end
+end
+
+-- Uniform on (0, 1)
+cephes.sample.uniform = create_sampler('uniform', 0)
+-- Normal with mean mu and standard deviation sigma
+cephes.sample.normal = create_sampler('normal', 2)
+-- Gamma with rate a and shape b, as in cephes.gdtr(a, b, x)
+cephes.sample.gamma = create_sampler('gamma', 2)
+-- Beta with shapes a and b, as in cephes.btdtr(a, b, x)
+cephes.sample.beta = create_sampler('beta', 2)
+-- Chi-square with df degrees of freedom, as in cephes.chdtr(df, x)
+cephes.sample.chi2 = create_sampler('chi2', 1)
+-- Student's t with df degrees of freedom, as in cephes.stdtr(df, t)
+cephes.sample.t = create_sampler('t', 1)
+-- F with a and b degrees of freedom, as in cephes.fdtr(a, b, x)
+cephes.sample.f = create_sampler('f', 2)
@@ -19,5 +19,92 @@ function errTest.testError()
     cephes.setErrorLevel(previousLevel)
 end
 
+function errTest.testScalarPath()
+    -- Numbers take the scalar path, tensors the generic wrapper: both
+    -- agree, and report errors the same way
+    local x = torch.Tensor{0.5, 3}
+    local y = cephes.chdtr(3, x)
+    tester:assertalmosteq(cephes.chdtr(3, 0.5), y[1], 1e-15, 'scalar and tensor calls differ')
+    tester:asserteq(cephes.chdtr(3, 3), cephes.ffi.chdtr(3, 3),
+                    'scalar call differs from the C function')
+    local result = torch.Tensor(2)
+    cephes.chdtr(result, 3, x)
+    tester:assertTensorEq(result, y, 0, 'result tensor not filled')
+    tester:assertError(function() cephes.chdtr(3, nil) end)
+
+    local previousLevel = cephes.getErrorLevel()
+    cephes.setErrorLevel('error')
+    tester:assertError(function() cephes.chdtr(-1, 1) end)
+    -- The error of a failed call does not carry over to the next one
+    tester:assert(cephes.chdtr(3, .5))
+    cephes.setErrorLevel(previousLevel)
+end
+
+function errTest.testFolders()
+    -- The wrappers of a folder are created together on first use
+    tester:asserteq(cephes.bessel.j0(1), cephes.j0(1), 'bessel.j0 differs from j0')
+    tester:asserteq(cephes.cprob.ndtr(0.5), cephes.ndtr(0.5), 'cprob.ndtr differs from ndtr')
+    tester:assert(rawget(cephes, 'ndtri') ~= nil, 'cprob wrappers not added to cephes')
+    tester:assert(cephes.cprob.ellpk == nil, 'ellpk is not in cprob')
+    -- Functions defined on top of a wrapper are kept
+    tester:assert(cephes._wrapped('ellpj') ~= cephes.ellpj, 'ellpj replaced by its wrapper')
+    tester:asserteq(cephes.digamma(2), cephes.psi(2), 'digamma differs from psi')
+end
+
+function errTest.testStats()
+    cephes.resetStats()
+    cephes.setStats(true)
+    local previousLevel = cephes.getErrorLevel()
+    cephes.setErrorLevel('off')
+    cephes.ndtr(0.5)
+    cephes.ndtr(torch.linspace(-1, 1, 10))
+    cephes.chdtr(-1, 1)
+    cephes.chdtr(torch.Tensor(10000):fill(-1), 1)
+    cephes.igam(2.5, torch.linspace(0.1, 10, 100))
+    cephes.ffi.chdtr(-1, 1)
+    cephes.setErrorLevel(previousLevel)
+    cephes.setStats(false)
+    cephes.ndtr(0.5)
+
+    local stats, threads = cephes.stats(true)
+    tester:assert(threads >= 1, 'no thread counted')
+    tester:asserteq(stats.ndtr.calls, 2, 'calls of ndtr')
+    tester:asserteq(stats.ndtr.elements, 11, 'elements of ndtr')
+    tester:assert(stats.ndtr.ns > 0, 'time of ndtr')
+    tester:asserteq(stats.ndtr.errors.domain, 0, 'errors of ndtr')
+    tester:asserteq(stats.chdtr.calls, 2, 'calls of chdtr')
+    -- the errors of the threads of the batch kernel too
+    tester:asserteq(stats.chdtr.errors.domain, 10001, 'domain errors of chdtr')
+    tester:asserteq(stats.igam.elements, 100, 'elements of igam')
+    tester:asserteq(stats.unwrapped.errors.domain, 1, 'unwrapped errors')
+    tester:assert(stats.ndtri == nil, 'ndtri not called')
+    tester:assert(next((cephes.stats())) == nil, 'counters not reset')
+end
+
+function errTest.testProfile()
+    cephes.resetStats()
+    local ok = pcall(cephes.profile)
+    if not ok then
+        -- library built without CEPHES_PROFILE
+        return
+    end
+    cephes.setStats(true)
+    cephes.igam(2.5, torch.Tensor{0.5, 1, 2})
+    cephes.igamc(2.5, 10)
+    cephes.ndtri(torch.Tensor{0.5, 1e-5, 1e-20})
+    cephes.setStats(false)
+    cephes.igam(2.5, 10)
+
+    local prof = cephes.profile(true)
+    tester:asserteq(prof.igam.series.count, 3, 'series paths of igam')
+    tester:asserteq(prof.igam.fraction.count, 1, 'fraction paths of igam')
+    tester:asserteq(prof.igam.series.buckets[1], 0, 'series without terms')
+    tester:asserteq(prof.ndtri.central.count, 1, 'central paths of ndtri')
+    tester:asserteq(prof.ndtri.tail.count, 1, 'tail paths of ndtri')
+    tester:asserteq(prof.ndtri.farTail.count, 1, 'far tail paths of ndtri')
+    tester:assert(prof.jv == nil, 'jv not called')
+    tester:assert(next(cephes.profile()) == nil, 'histograms not reset')
+end
+
 tester:add(errTest)
 return tester:run()
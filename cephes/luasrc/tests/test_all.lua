@@ -9,8 +9,11 @@ tester:add('test_bessel.lua')
 tester:add('test_cmath.lua')
 tester:add('test_cprob.lua')
 tester:add('test_ellf.lua')
+tester:add('test_grad.lua')
 tester:add('test_limits.lua')
 tester:add('test_misc.lua')
+tester:add('test_nn.lua')
 tester:add('test_polyn.lua')
+tester:add('test_sample.lua')
 tester:add('test_vectorized.lua')
 return tester:run()
@@ -27,6 +27,37 @@ function callTests.test_hyp2f1()
     tester:assert(cephes.hyp2f1(a, b, c, x))
 end
 
+-- A plan must agree with hyp2f1 on every branch
+function callTests.test_hyp2f1_plan()
+    local x = torch.linspace(-0.99, 0.99, 45)
+    local params = {
+        {0.5, 0.5, 1.5},   -- defining series, x < -0.5, x > 0.9
+        {1, 1, 2},         -- c - a - b integer: psi expansion near 1
+        {0.3, 1.2, 0.7},   -- c - a - b < 0: recurrence on c
+        {2, -3, 0.5},      -- polynomial
+        {1.5, 2, 1.5},     -- c = a
+        {-1.5, 2, 0.5},    -- c - b negative integer
+    }
+    for _, p in ipairs(params) do
+        local a, b, c = unpack(p)
+        local plan = cephes.hyp2f1_plan(a, b, c)
+        local y = plan:eval(x)
+        tester:asserteq(y:nElement(), x:nElement(), 'one value per x')
+        for i = 1, x:nElement() do
+            local expected = cephes.hyp2f1(a, b, c, x[i])
+            tester:assertalmosteq(y[i], expected, 1e-13 * math.max(1, math.abs(expected)),
+                                  'hyp2f1 plan (' .. a .. ', ' .. b .. ', ' .. c .. ', ' .. x[i] .. ')')
+        end
+        tester:assertalmosteq(plan:eval(0.25), cephes.hyp2f1(a, b, c, 0.25), 1e-13,
+                              'hyp2f1 plan on a number')
+    end
+
+    local plan = cephes.hyp2f1_plan(1, 1, 3)
+    tester:assertalmosteq(plan:eval(1), cephes.hyp2f1(1, 1, 3, 1), 1e-15, 'hyp2f1 plan at x = 1')
+    local result = torch.zeros(x:nElement())
+    tester:asserteq(plan:eval(result, x), result, 'should fill the given result')
+end
+
 -- Test simple calls for hyperg
 -- Signature: double hyperg(double a, double b, double x)
 function callTests.test_hyperg()
@@ -214,5 +245,80 @@ function callTests.test_yn()
     tester:assert(cephes.yn(n, x))
 end
 
+-- Sequences of orders must agree with the per-order functions
+function callTests.test_jn_seq()
+    local nmax = 20
+    local x = torch.Tensor{-3.5, 0.01, 0.5, 1, 2.5, 7.3, 15, 25}
+    local y = cephes.jn_seq(nmax, x)
+    tester:asserteq(y:dim(), 2, 'should get a matrix')
+    tester:asserteq(y:size(1), x:nElement(), 'one row per argument')
+    tester:asserteq(y:size(2), nmax + 1, 'one column per order')
+    for i = 1, x:nElement() do
+        for n = 0, nmax do
+            tester:assertalmosteq(y[i][n + 1], cephes.jn(n, x[i]), 1e-14,
+                                  'jn_seq(' .. n .. ', ' .. x[i] .. ')')
+        end
+    end
+
+    local row = cephes.jn_seq(nmax, 2.5)
+    tester:asserteq(row:dim(), 1, 'should get a vector for a number')
+    tester:asserteq(row:size(1), nmax + 1, 'one element per order')
+    tester:assertalmosteq(row[4], cephes.jn(3, 2.5), 1e-15, 'jn_seq on a number')
+end
+
+function callTests.test_in_seq()
+    local nmax = 20
+    local x = torch.Tensor{-3.5, 0.01, 0.5, 1, 2.5, 7.3, 15}
+    local y = cephes.in_seq(nmax, x)
+    for i = 1, x:nElement() do
+        for n = 0, nmax do
+            local expected = cephes.iv(n, x[i])
+            tester:assertalmosteq(y[i][n + 1] / expected, 1, 1e-12,
+                                  'in_seq(' .. n .. ', ' .. x[i] .. ')')
+        end
+    end
+
+    -- beyond the overflow of i0, without a recurrence of |x| steps
+    y = cephes.in_seq(nmax, torch.Tensor{math.huge, 0 / 0, 1e10, -1e10})
+    for n = 0, nmax do
+        tester:asserteq(y[1][n + 1], math.huge, 'in_seq(' .. n .. ', inf)')
+        tester:assert(y[2][n + 1] ~= y[2][n + 1], 'in_seq(' .. n .. ', nan)')
+        tester:asserteq(y[3][n + 1], math.huge, 'in_seq(' .. n .. ', 1e10)')
+        tester:asserteq(y[4][n + 1], n % 2 == 0 and math.huge or -math.huge,
+                        'in_seq(' .. n .. ', -1e10)')
+    end
+end
+
+function callTests.test_yn_seq()
+    local nmax = 20
+    local x = torch.Tensor{0.5, 1, 2.5, 7.3, 15, 25}
+    local y = cephes.yn_seq(nmax, x)
+    for i = 1, x:nElement() do
+        for n = 0, nmax do
+            local expected = cephes.yn(n, x[i])
+            tester:assertalmosteq(y[i][n + 1], expected, 1e-12 * math.max(1, math.abs(expected)),
+                                  'yn_seq(' .. n .. ', ' .. x[i] .. ')')
+        end
+    end
+end
+
+function callTests.test_kn_seq()
+    local nmax = 20
+    local x = torch.Tensor{0.01, 0.5, 1, 2.5, 7.3, 15, 25}
+    local y = cephes.kn_seq(nmax, x)
+    for i = 1, x:nElement() do
+        for n = 0, nmax do
+            -- kn is only good to about 1e-8
+            tester:assertalmosteq(y[i][n + 1] / cephes.kn(n, x[i]), 1, 1e-7,
+                                  'kn_seq(' .. n .. ', ' .. x[i] .. ')')
+        end
+    end
+
+    local result = torch.zeros(x:nElement() * (nmax + 1))
+    tester:asserteq(cephes.kn_seq(result, nmax, x), result, 'should fill the given result')
+    tester:assertError(function() cephes.kn_seq(torch.zeros(3), nmax, x) end,
+                       'should error when the result has the wrong size')
+end
+
 tester:add(callTests)
 return tester:run()
@@ -294,5 +294,58 @@ function callTests.test_stdtri()
     tester:assert(cephes.stdtri(k, p))
 end
 
+-- Batched smirnov and kolmogorov against the scalar functions
+function callTests.test_smirnov_batch()
+    local e = torch.linspace(0.01, 0.3, 30)
+    for _, n in ipairs{ 10, 200, 1500 } do
+        local p = cephes.smirnov(n, e)
+        for i = 1, e:size(1) do
+            tester:asserteq(p[i], cephes.ffi.smirnov(n, e[i]), 'smirnov(' .. n .. ', ' .. e[i] .. ')')
+        end
+    end
+    local y = torch.linspace(0.1, 2, 20)
+    local p = cephes.kolmogorov(y)
+    for i = 1, y:size(1) do
+        tester:asserteq(p[i], cephes.ffi.kolmogorov(y[i]), 'kolmogorov(' .. y[i] .. ')')
+    end
+end
+
+-- KS statistics of evenly spaced samples, and of a shifted sample
+function callTests.test_kstest()
+    local n = 20
+    local u = torch.Tensor(n, 3)
+    for i = 1, n do
+        u[i][1] = (i - 0.5) / n          -- D = 1/(2n)
+        u[i][2] = (n - i + 1) / n        -- unsorted, D = 1/n
+        u[i][3] = 0.5 * (i - 0.5) / n    -- all below 1/2, D = 1/2 + 1/(4n)
+    end
+    local D, p = cephes.kstest(u)
+    tester:assertalmosteq(D[1], 0.5 / n, 1e-15)
+    tester:assertalmosteq(D[2], 1 / n, 1e-15)
+    tester:assertalmosteq(D[3], 0.5 + 0.25 / n, 1e-15)
+    tester:asserteq(p[1], 1)
+    -- for D >= 1/2 the two-sided p-value is twice the one-sided one
+    tester:assertalmosteq(p[3], 2 * cephes.smirnov(n, D[3]), 1e-15)
+    tester:assert(p[3] < 1e-3, 'shifted sample should be rejected')
+
+    local Dplus, pplus = cephes.kstest(u, 'greater')
+    tester:assertalmosteq(Dplus[3], 0.5 + 0.25 / n, 1e-15)
+    tester:assertalmosteq(pplus[3], cephes.smirnov(n, Dplus[3]), 1e-15)
+    local Dminus = cephes.kstest(u, 'less')
+    tester:assertalmosteq(Dminus[3], 0.25 / n, 1e-15)
+
+    local Dasym, pasym = cephes.kstest(u, 'two-sided', 'asymptotic')
+    tester:assertalmosteq(pasym[3], cephes.kolmogorov(math.sqrt(n) * D[3]), 1e-15)
+    local _, pbound = cephes.kstest(u, 'two-sided', 'bound')
+    tester:assertTensorEq(pbound, p, 0, "'bound' is the default method")
+    tester:assertError(function() cephes.kstest(u, 'two-sided', 'exact') end)
+
+    -- vector input returns numbers
+    local d1, p1 = cephes.kstest(u:select(2, 3):clone())
+    tester:asserteq(type(d1), 'number')
+    tester:assertalmosteq(d1, D[3], 1e-15)
+    tester:assertalmosteq(p1, p[3], 1e-15)
+end
+
 tester:add(callTests)
 return tester:run()
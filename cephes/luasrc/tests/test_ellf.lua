@@ -48,5 +48,228 @@ function callTests.test_ellpk()
     tester:assert(cephes.ellpk(x))
 end
 
+-- The batch kernels give the values of the scalar functions, with per
+-- element moduli and with a shared modulus
+function callTests.test_ellf_batch()
+    local n = 400
+    local phi = torch.linspace(-9, 9, n)
+    local m = torch.linspace(0, 1, n)
+    local function check(name, ...)
+        local args = { ... }
+        local result = cephes[name](unpack(args))
+        for i = 1, n do
+            local scalarArgs = {}
+            for index, arg in ipairs(args) do
+                scalarArgs[index] = torch.isTensor(arg) and arg[i] or arg
+            end
+            tester:asserteq(result[i], cephes[name](unpack(scalarArgs)),
+                            name .. ' at element ' .. i)
+        end
+    end
+
+    check('ellpk', m)
+    check('ellpe', m)
+    for _, name in ipairs{ 'ellik', 'ellie' } do
+        check(name, phi, m)
+        check(name, phi, 0.8)
+        check(name, phi, 1 - 1e-12)
+        check(name, 1.2, m)
+    end
+end
+
+function callTests.test_ellpj_batch()
+    local u = torch.linspace(-12, 12, 300):resize(3, 100)
+    local sn = ffi.new("double[1]")
+    local cn = ffi.new("double[1]")
+    local dn = ffi.new("double[1]")
+    local ph = ffi.new("double[1]")
+    local function check(results, m)
+        for index = 1, 4 do
+            tester:asserteq(results[index]:dim(), 2, 'result ' .. index .. ' shape')
+        end
+        for i = 1, 3 do
+            for j = 1, 100 do
+                local mij = torch.isTensor(m) and m[i][j] or m
+                cephes.ellpj(u[i][j], mij, sn, cn, dn, ph)
+                local expected = { sn[0], cn[0], dn[0], ph[0] }
+                for index = 1, 4 do
+                    tester:asserteq(results[index][i][j], expected[index],
+                                    'ellpj(' .. u[i][j] .. ', ' .. mij .. ') result ' .. index)
+                end
+            end
+        end
+    end
+
+    check({ cephes.ellpj(u, 0.7) }, 0.7)
+    check({ cephes.ellpj(u, 1e-10) }, 1e-10)
+    -- runs of equal moduli, and moduli near 1
+    local m = torch.Tensor(3, 100)
+    for i = 1, 3 do
+        for j = 1, 100 do
+            m[i][j] = math.floor((j - 1) / 10 + 10 * (i - 1)) / 29
+        end
+    end
+    check({ cephes.ellpj(u, m) }, m)
+
+    local s, c, d, p = cephes.ellpj(1.5, 0.3)
+    cephes.ellpj(1.5, 0.3, sn, cn, dn, ph)
+    tester:asserteq(s, sn[0])
+    tester:asserteq(c, cn[0])
+    tester:asserteq(d, dn[0])
+    tester:asserteq(p, ph[0])
+end
+
+-- The first design of ellf/ellf.ans
+local ansSpec = { kind = 'elliptic', type = 'lowpass', n = 8, dbr = 0.5,
+                  fs = 10000, f2 = 2000, dbd = 2200 }
+local ansDen = { 1.000000000E+000, -3.391052594E+000, 7.134281988E+000,
+                 -9.896096826E+000, 1.003199389E+001, -7.367386257E+000,
+                 3.870315688E+000, -1.331104152E+000, 2.403871958E-001 }
+local ansNum = { 1.084065518E-002, 1.549626463E-002, 3.865495125E-002,
+                 4.450145413E-002, 5.605504248E-002, 4.450145413E-002,
+                 3.865495125E-002, 1.549626463E-002, 1.084065518E-002 }
+
+function callTests.test_ellf_design()
+    local design = cephes.ellf(ansSpec)
+    tester:asserteq(design.order, 8)
+    tester:assertalmosteq(design.gain, 1.0840655180824E-002, 1e-14)
+    tester:assertalmosteq(design.dbdown, 6.202677896E+001, 1e-8)
+    for j = 1, 9 do
+        tester:assertalmosteq(design.den[j], ansDen[j], 1e-8, 'den ' .. j)
+        tester:assertalmosteq(design.num[j], ansNum[j], 1e-11, 'num ' .. j)
+    end
+    tester:assertalmosteq(design.poles[1][1], 3.0050282041410E-001, 1e-13)
+    tester:assertalmosteq(design.poles[1][2], 9.3475816516366E-001, 1e-13)
+    tester:assertalmosteq(design.poles[2][2], -9.3475816516366E-001, 1e-13)
+    -- 0.5 db ripple in the pass band, 62 db down in the stop band
+    tester:assertalmosteq(20 * math.log10(cephes.ellfResponse(design, 0)), -0.5, 1e-6)
+    local response = cephes.ellfResponse(design, torch.linspace(2250, 5000, 12))
+    tester:assert(response:max() < 10^(-62 / 20), 'stop band')
+
+    -- Butterworth: unit gain at the center of the pass band
+    for _, shape in ipairs{ { 'lowpass', 0 }, { 'highpass', 500 },
+                            { 'bandpass', 150 }, { 'bandstop', 0 } } do
+        design = cephes.ellf{ kind = 'butterworth', type = shape[1], n = 4,
+                              fs = 1000, f1 = 100, f2 = 200 }
+        tester:assertalmosteq(cephes.ellfResponse(design, shape[2]), 1, 1e-6, shape[1])
+    end
+
+    tester:assertError(function() cephes.ellf{ kind = 'elliptic', type = 'lowpass', n = 8,
+                                               dbr = 0.5, fs = 10000, f2 = 2000, dbd = 1900 } end,
+                       'stop band edge in the pass band')
+    tester:assertError(function() cephes.ellf{ kind = 'butterworth', type = 'lowpass',
+                                               n = 30, fs = 1000, f2 = 100 } end,
+                       'order too large')
+
+    -- degenerate specifications are rejected rather than designed as NaN
+    local degenerate = {
+        { dbd = 0 }, { dbd = -0.1 }, { dbd = 6000 }, {},
+        { kind = 'butterworth', type = 'bandpass', f1 = 2000 },
+        { kind = 'chebyshev', type = 'bandstop', f1 = 2000 },
+    }
+    for i, change in ipairs(degenerate) do
+        local spec = { kind = 'elliptic', type = 'lowpass', n = 8, dbr = 0.5,
+                       fs = 10000, f2 = 2000 }
+        for k, v in pairs(change) do
+            spec[k] = v
+        end
+        tester:assertError(function() cephes.ellf(spec) end, 'degenerate spec ' .. i)
+    end
+end
+
+function callTests.test_ellf_design_batch()
+    local specs = {}
+    for i = 1, 40 do
+        specs[i] = { kind = 1 + i % 3, type = 1 + i % 4, n = 2 + i % 5, dbr = 0.5,
+                     fs = 1000, f1 = 100, f2 = 150 + i, dbd = -40 }
+    end
+    specs[41] = { kind = 'chebyshev', type = 'lowpass', n = 4, dbr = 0, fs = 1000, f2 = 100 }
+    local designs, errors = cephes.ellf(specs)
+    for i = 1, 40 do
+        local design = cephes.ellf(specs[i])
+        tester:asserteq(designs[i].gain, design.gain, 'gain of design ' .. i)
+        tester:assertTensorEq(designs[i].num, design.num, 0, 'num of design ' .. i)
+        tester:assertTensorEq(designs[i].poles, design.poles, 0, 'poles of design ' .. i)
+    end
+    tester:asserteq(designs[41], false)
+    tester:asserteq(errors[41], 'invalid specification')
+end
+
+-- Direct form of the difference equation of num and den, on a vector
+local function difference(design, x)
+    local order, num, den = design.order, design.num, design.den
+    local y = torch.DoubleTensor(x:size(1)):zero()
+    for t = 1, x:size(1) do
+        local v = 0
+        for j = 0, math.min(order, t - 1) do
+            v = v + num[j + 1] * x[t - j]
+            if j > 0 then
+                v = v - den[j + 1] * y[t - j]
+            end
+        end
+        y[t] = v
+    end
+    return y
+end
+
+function callTests.test_sosfilt()
+    local designs = {
+        cephes.ellf(ansSpec),
+        cephes.ellf{ kind = 'chebyshev', type = 'bandpass', n = 3, dbr = 1,
+                     fs = 1000, f1 = 100, f2 = 200 },
+        cephes.ellf{ kind = 'butterworth', type = 'highpass', n = 5, fs = 1000, f2 = 300 },
+        cephes.ellf{ kind = 'elliptic', type = 'bandstop', n = 3, dbr = 0.5,
+                     fs = 1000, f1 = 100, f2 = 200, dbd = -40 },
+    }
+    local T = 200
+    local x = torch.randn(T)
+
+    for i, design in ipairs(designs) do
+        tester:asserteq(design.sos:size(1), math.floor((design.order + 1) / 2))
+        local filter = cephes.SOSFilter(design)
+        local y = filter:forward(x):clone()
+        local expected = difference(design, x)
+        tester:assertTensorEq(y, expected, 1e-9 * torch.abs(expected):max(), 'design ' .. i)
+    end
+
+    -- a stream of blocks of 3 channels, with one filter per channel
+    local C = 3
+    local signal = torch.randn(T, C)
+    local whole = cephes.SOSFilter({ designs[1], designs[2], designs[3] })
+    local y = whole:forward(signal):clone()
+    local stream = cephes.SOSFilter({ designs[1], designs[2], designs[3] })
+    local t = 1
+    for _, n in ipairs{ 1, 7, 64, 0, 100, 28 } do
+        local out = stream:forward(signal:narrow(1, t, n))
+        for k = 1, n do
+            for c = 1, C do
+                tester:asserteq(out[k][c], y[t + k - 1][c], 'sample ' .. (t + k - 1))
+            end
+        end
+        t = t + n
+    end
+    for c = 1, C do
+        local single = cephes.SOSFilter(designs[c])
+        local column = torch.DoubleTensor(T)
+        for k = 1, T do
+            column[k] = signal[k][c]
+        end
+        local yc = single:forward(column)
+        for k = 1, T do
+            tester:asserteq(yc[k], y[k][c], 'channel ' .. c)
+        end
+    end
+
+    -- shared sections, and a fresh stream after reset
+    local shared = cephes.SOSFilter(designs[2], C)
+    local first = shared:forward(signal):clone()
+    shared:reset()
+    tester:assertTensorEq(shared:forward(signal), first, 0, 'reset')
+    local out = torch.DoubleTensor()
+    tester:asserteq(shared:reset():forward(signal, out), out)
+    tester:assertTensorEq(out, first, 0, 'output tensor')
+    tester:assertError(function() shared:forward(torch.randn(10, 2)) end, 'channels')
+end
+
 tester:add(callTests)
 return tester:run()
@@ -119,7 +119,7 @@ end
 -- Test simple calls for simpsn
 -- Signature: double simpsn(double f[], double delta)
 function callTests.test_simpsn()
-    local f = ffi.new("double[8]", {0, 0, 0, 0, 0, 0, 0, 0})
+    local f = ffi.new("double[9]", {0, 0, 0, 0, 0, 0, 0, 0, 0})
     local delta = 0.5
     tester:assert(cephes.simpsn(f, delta))
 end
@@ -156,6 +156,146 @@ function callTests.test_polygamma()
     tester:assertalmosteq(cephes.polygamma(3, 0.7), 25.879149678427737, 1e-14)
 
     tester:assertalmosteq(cephes.polygamma(0, 0.7), cephes.psi(0.7), 1e-14)
+
+    -- x**(m+1) overflows, the result does not (values from mpmath)
+    local large = {
+        { 170, 66, -5.6677683620836859e-05 },
+        { 20, 1e16, -1.2164510040883212e-303 },
+    }
+    for _, v in ipairs(large) do
+        local m, x, expected = unpack(v)
+        tester:assertalmosteq(cephes.polygamma(m, x), expected, 1e-13 * math.abs(expected),
+                              'polygamma(' .. m .. ', ' .. x .. ')')
+        local result = cephes.polygamma(torch.Tensor{ m }, torch.Tensor{ x })
+        tester:assertalmosteq(result[1], expected, 1e-13 * math.abs(expected),
+                              'batch polygamma(' .. m .. ', ' .. x .. ')')
+    end
+end
+
+function callTests.test_polygamma_batch()
+    local x = torch.linspace(-3.7, 30, 200)
+    for _, m in ipairs{ 0, 1, 2, 5 } do
+        local result = cephes.polygamma(m, x)
+        for i = 1, x:size(1) do
+            local expected
+            if m == 0 then
+                expected = cephes.psi(x[i])
+            else
+                expected = math.pow(-1, m + 1) * cephes.gamma(m + 1) * cephes.zeta(m + 1, x[i])
+            end
+            tester:assertalmosteq(result[i], expected, 1e-14 * math.abs(expected),
+                                  'polygamma(' .. m .. ', ' .. x[i] .. ')')
+        end
+    end
+
+    local m = torch.Tensor{ 1, 2, 3 }
+    local result = cephes.polygamma(m, 0.7)
+    for i = 1, 3 do
+        tester:asserteq(result[i], cephes.polygamma(m[i], 0.7))
+    end
+
+    tester:assertTensorEq(cephes.trigamma(x), cephes.polygamma(1, x), 1e-300)
+    tester:assertalmosteq(cephes.trigamma(1), math.pi * math.pi / 6, 1e-15)
+
+    local q = torch.linspace(0.5, 10, 20)
+    result = cephes.zeta(2.5, q)
+    for i = 1, q:size(1) do
+        tester:asserteq(result[i], cephes.zeta(2.5, q[i]))
+    end
+end
+
+function callTests.test_expint_batch()
+    local x = torch.linspace(0.01, 90, 200)
+    local result = cephes.ei(x)
+    for i = 1, x:size(1) do
+        tester:asserteq(result[i], cephes.ei(x[i]), 'ei(' .. x[i] .. ')')
+    end
+    result = cephes.expn(3, x)
+    for i = 1, x:size(1) do
+        tester:asserteq(result[i], cephes.expn(3, x[i]), 'expn(3, ' .. x[i] .. ')')
+    end
+
+    local y = torch.linspace(-95, 95, 381)
+    local shi, chi = cephes.shichi(y)
+    local si, ci = cephes.sici(y)
+    local a = ffi.new('double[1]')
+    local b = ffi.new('double[1]')
+    for i = 1, y:size(1) do
+        cephes.shichi(y[i], a, b)
+        tester:asserteq(shi[i], a[0], 'shi(' .. y[i] .. ')')
+        tester:asserteq(chi[i], b[0], 'chi(' .. y[i] .. ')')
+        cephes.sici(y[i], a, b)
+        tester:asserteq(si[i], a[0], 'si(' .. y[i] .. ')')
+        tester:asserteq(ci[i], b[0], 'ci(' .. y[i] .. ')')
+    end
+    local s, c = cephes.sici(1)
+    tester:assertalmosteq(s, 0.94608307036718301, 1e-15)
+    tester:assertalmosteq(c, 0.33740392290096813, 1e-15)
+end
+
+function callTests.test_expns()
+    local x = torch.Tensor{ 0.05, 0.7, 1, 2.5, 9.3, 31, 120 }
+    local result = cephes.expns(25, x)
+    tester:asserteq(result:size(1), 7)
+    tester:asserteq(result:size(2), 25)
+    for i = 1, x:size(1) do
+        for n = 1, 25 do
+            local expected = cephes.expn(n, x[i])
+            tester:assertalmosteq(result[i][n], expected, 1e-14 * expected,
+                                  'E_' .. n .. '(' .. x[i] .. ')')
+        end
+    end
+    -- E_n(0) = 1/(n-1)
+    tester:asserteq(cephes.expns(4, 0)[4], 1 / 3)
+end
+
+function callTests.test_polylog_batch()
+    local x = torch.linspace(-2.5, 1, 300)
+    for _, n in ipairs{ 1, 2, 3, 4, 6 } do
+        local result = cephes.polylog(n, x)
+        for i = 1, x:size(1) do
+            tester:asserteq(result[i], cephes.polylog(n, x[i]),
+                            'polylog(' .. n .. ', ' .. x[i] .. ')')
+        end
+    end
+
+    local n = torch.Tensor{ 2, 3, 3, 5, 4, 2 }
+    local y = torch.Tensor{ 0.3, 0.9, -0.5, 0.8, 0.95, -0.2 }
+    local result = cephes.polylog(n, y)
+    for i = 1, n:size(1) do
+        tester:asserteq(result[i], cephes.polylog(n[i], y[i]))
+    end
+
+    local s = torch.linspace(0, 6, 50)
+    result = cephes.spence(s)
+    for i = 1, s:size(1) do
+        tester:asserteq(result[i], cephes.spence(s[i]))
+    end
+end
+
+function callTests.test_polylogs()
+    local x = torch.linspace(-0.99, 0.99, 40):resize(4, 10)
+    local result = cephes.polylogs(7, x)
+    tester:asserteq(result:dim(), 3)
+    tester:asserteq(result:size(3), 7)
+    for i = 1, 4 do
+        for j = 1, 10 do
+            for n = 1, 7 do
+                local expected = cephes.polylog(n, x[i][j])
+                tester:assertalmosteq(result[i][j][n], expected, 1e-14 * math.abs(expected),
+                                      'Li_' .. n .. '(' .. x[i][j] .. ')')
+            end
+        end
+    end
+    local values = cephes.polylogs(3, 1)
+    tester:assertalmosteq(values[2], math.pi * math.pi / 6, 1e-15)
+    tester:assertalmosteq(cephes.polylogs(2, 0.5)[2], math.pi * math.pi / 12 - math.log(2)^2 / 2, 1e-15)
+    -- Li_1(x) = -log(1 - x), to a few ulp near x = -1 too
+    for _, v in ipairs{ -0.999, -0.9, -0.8 } do
+        local expected = -math.log(1 - v)
+        tester:assertalmosteq(cephes.polylogs(4, v)[1], expected, 3e-16 * math.abs(expected),
+                              'Li_1(' .. v .. ')')
+    end
 end
 
 function callTests.test_betagrad()
@@ -187,5 +327,99 @@ function callTests.test_mvgam()
     tester:assert(cephes.mvgam(x,p))
 end
 
+-- Reference: the sum of the p values of lgam
+local function lmvgamSum(x, p)
+    local result = p * (p-1) / 4 * math.log(math.pi)
+    for j = 1, p do
+        result = result + cephes.lgam(x + (1-j)/2)
+    end
+    return result
+end
+
+function callTests.test_lmvgam_batch()
+    local x = torch.linspace(0.1, 400, 100)
+    for _, p in ipairs{ 1, 2, 7, 64, 512 } do
+        local xp = x:clone():add((p-1)/2)
+        local result = cephes.lmvgam(xp, p)
+        for i = 1, xp:size(1) do
+            local expected = lmvgamSum(xp[i], p)
+            tester:assertalmosteq(result[i], expected, 1e-13 * math.max(1, math.abs(expected)),
+                                  'lmvgam(' .. xp[i] .. ', ' .. p .. ')')
+            tester:asserteq(result[i], cephes.lmvgam(xp[i], p))
+        end
+    end
+
+    -- outside of the domain x > (p-1)/2
+    tester:assertalmosteq(cephes.lmvgam(1.3, 6), lmvgamSum(1.3, 6), 1e-13)
+    -- per-element degrees
+    local p = torch.Tensor{ 1, 3, 10 }
+    local result = cephes.lmvgam(20, p)
+    for i = 1, 3 do
+        tester:assertalmosteq(result[i], lmvgamSum(20, p[i]), 1e-13 * result[i])
+    end
+    tester:assertalmosteq(cephes.mvgam(3.5, 3), math.exp(lmvgamSum(3.5, 3)), 1e-13 * cephes.mvgam(3.5, 3))
+end
+
+function callTests.test_lmvgamgrad()
+    for _, p in ipairs{ 1, 4, 33 } do
+        for _, x in ipairs{ (p-1)/2 + 1e-3, p / 2 + 0.3, p + 40 } do
+            local value, grad = cephes.lmvgamgrad(x, p)
+            tester:asserteq(value, cephes.lmvgam(x, p))
+            local expected = 0
+            for j = 1, p do
+                expected = expected + cephes.psi(x + (1-j)/2)
+            end
+            tester:assertalmosteq(grad, expected, 1e-12 * math.max(1, math.abs(expected)))
+        end
+    end
+    local values, grads = cephes.lmvgamgrad(torch.linspace(5, 6, 10), 8)
+    tester:asserteq(values:nElement(), 10)
+    tester:assertalmosteq(grads[1], select(2, cephes.lmvgamgrad(5, 8)), 1e-15)
+end
+
+function callTests.test_simpsn_batch()
+    -- exp on [0, L], L = (N - 1) delta, for several sample counts and
+    -- one spacing per row, with the errors of the rules of N samples
+    local tolerances = { [2] = 2.1, [5] = 1e-3, [9] = 1e-7, [20] = 1e-10, [101] = 1e-13 }
+    for N, tol in pairs(tolerances) do
+        local B = 3
+        local delta = torch.DoubleTensor{ 0.5, 1, 2 }:div(N - 1)
+        local f = torch.DoubleTensor(B, N)
+        for b = 1, B do
+            for j = 1, N do
+                f[b][j] = math.exp((j - 1) * delta[b])
+            end
+        end
+        local area = cephes.simpsn(f, delta)
+        local running = cephes.simpsn(f, delta, true)
+        for b = 1, B do
+            tester:assertalmosteq(area[b], math.exp((N - 1) * delta[b]) - 1, tol, 'N ' .. N)
+            tester:assertalmosteq(running[b][N], area[b], 1e-14, 'last of cumulative')
+            for j = 1, N do
+                tester:assertalmosteq(running[b][j], math.exp((j - 1) * delta[b]) - 1,
+                                      tol, 'cumulative ' .. j)
+            end
+        end
+    end
+
+    -- a single panel is the rule of simpsn
+    local samples = torch.linspace(0, 1, 9):apply(function(x) return math.sin(3 * x) end)
+    local f = ffi.new("double[9]")
+    for j = 0, 8 do
+        f[j] = samples[j + 1]
+    end
+    tester:assertalmosteq(cephes.simpsn(samples, 0.125), cephes.simpsn(f, 0.125), 1e-15)
+
+    -- Gauss-Legendre rules are exact up to degree 2k - 1
+    for _, k in ipairs{ 1, 4, 5, 12 } do
+        local x, w = cephes.gauleg(k, 0, 2)
+        local sum = 0
+        for i = 1, k do
+            sum = sum + w[i] * x[i] ^ (2 * k - 1)
+        end
+        tester:assertalmosteq(sum, 2 ^ (2 * k) / (2 * k), 1e-12 * 2 ^ (2 * k), 'k ' .. k)
+    end
+end
+
 tester:add(callTests)
 return tester:run()
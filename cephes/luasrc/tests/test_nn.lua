@@ -0,0 +1,92 @@
+require 'cephes'
+require 'totem'
+local nnTests = {}
+local tester = totem.Tester()
+
+if not pcall(require, 'nn') then
+    print('nn is not installed, skipping the tests of cephes.nn')
+    return true
+end
+require 'cephes.nn'
+
+local elementwise = {
+    { 'LogGamma', cephes.lgam, cephes.psi },
+    { 'Digamma', cephes.psi, function(x) return cephes.polygamma(1, x) end },
+    { 'Erf', cephes.erf, function(x) return 2 / math.sqrt(math.pi) * math.exp(-x * x) end },
+    { 'BesselI0e', cephes.i0e, function(x) return cephes.i1e(x) - cephes.i0e(x) end },
+    { 'BesselI1e', cephes.i1e, function(x) return cephes.i0e(x) - cephes.i1e(x) / x - cephes.i1e(x) end },
+}
+
+function nnTests.testElementwise()
+    local input = torch.linspace(0.2, 6, 12):resize(3, 4)
+    local gradOutput = torch.linspace(-1, 1, 12):resize(3, 4)
+    for _, case in ipairs(elementwise) do
+        local name, f, df = unpack(case)
+        local module = cephes.nn[name]()
+        local output = module:forward(input)
+        tester:asserteq(output:dim(), 2, name .. ' output shape')
+        local gradInput = module:backward(input, gradOutput)
+        for i = 1, 3 do
+            for j = 1, 4 do
+                local x = input[i][j]
+                tester:asserteq(output[i][j], f(x), name .. ' output')
+                tester:assertalmosteq(gradInput[i][j], gradOutput[i][j] * df(x), 1e-13,
+                                      name .. ' gradInput')
+            end
+        end
+    end
+end
+
+function nnTests.testBufferReuse()
+    local module = cephes.nn.LogGamma()
+    local input = torch.linspace(1, 5, 10)
+    local output = module:forward(input)
+    local gradInput = module:backward(input, torch.ones(10))
+    local derivative = module._derivative
+    input = torch.linspace(2, 6, 10)
+    tester:assert(module:forward(input) == output, 'output should be reused')
+    tester:assert(module:backward(input, torch.ones(10)) == gradInput, 'gradInput should be reused')
+    tester:assert(module._derivative == derivative, 'derivative buffer should be reused')
+    tester:asserteq(output[1], cephes.lgam(2))
+end
+
+function nnTests.testIncGamma()
+    local x = torch.linspace(0.1, 8, 10)
+    local gradOutput = torch.linspace(1, 2, 10)
+
+    local module = cephes.nn.IncGamma(2.5)
+    local output = module:forward(x)
+    local gradInput = module:backward(x, gradOutput)
+    for i = 1, 10 do
+        local f, _, dx = cephes.grad.igam(2.5, x[i])
+        tester:asserteq(output[i], f)
+        tester:assertalmosteq(gradInput[i], gradOutput[i] * dx, 1e-14)
+    end
+
+    -- learnable shape: input {a, x}
+    local a = torch.linspace(1, 4, 10)
+    module = cephes.nn.IncGamma(nil, true)
+    output = module:forward({ a, x })
+    gradInput = module:backward({ a, x }, gradOutput)
+    for i = 1, 10 do
+        local f, da, dx = cephes.grad.igamc(a[i], x[i])
+        tester:asserteq(output[i], f)
+        tester:assertalmosteq(gradInput[1][i], gradOutput[i] * da, 1e-14)
+        tester:assertalmosteq(gradInput[2][i], gradOutput[i] * dx, 1e-14)
+    end
+
+    -- shared shape: its gradient sums over the elements
+    a = torch.Tensor{ 2 }
+    module = cephes.nn.IncGamma()
+    module:forward({ a, x })
+    gradInput = module:backward({ a, x }, gradOutput)
+    local expected = 0
+    for i = 1, 10 do
+        local _, da = cephes.grad.igam(2, x[i])
+        expected = expected + gradOutput[i] * da
+    end
+    tester:assertalmosteq(gradInput[1][1], expected, 1e-13)
+end
+
+tester:add(nnTests)
+return tester:run()
@@ -132,5 +132,289 @@ function callTests.test_revers()
     tester:asserteq(cephes.revers(y, x, n), nil)
 end
 
+-- Coefficients, in ascending order, of the monic polynomial of the
+-- given real roots and complex roots re +- i im
+local function fromRoots(real, complex)
+    local coef = { 1 }
+    local function multiply(factor)
+        local product = {}
+        for i = 1, #coef + #factor - 1 do
+            product[i] = 0
+        end
+        for i = 1, #coef do
+            for j = 1, #factor do
+                product[i + j - 1] = product[i + j - 1] + coef[i] * factor[j]
+            end
+        end
+        coef = product
+    end
+    for _, r in ipairs(real) do
+        multiply{ -r, 1 }
+    end
+    for _, z in ipairs(complex) do
+        multiply{ z[1] * z[1] + z[2] * z[2], -2 * z[1], 1 }
+    end
+    return coef
+end
+
+function callTests.test_polroots()
+    local real = { 1, -2, 3.5, 0.25 }
+    local complex = { { 0.5, 1 }, { -1, 2 } }
+    local coef = torch.DoubleTensor(fromRoots(real, complex))
+    local roots, status = cephes.polroots(coef)
+    tester:asserteq(status, 0)
+    tester:asserteq(roots:size(1), 8)
+    local expected = {}
+    for _, r in ipairs(real) do
+        table.insert(expected, { r, 0 })
+    end
+    for _, z in ipairs(complex) do
+        table.insert(expected, { z[1], z[2] })
+        table.insert(expected, { z[1], -z[2] })
+    end
+    for _, z in ipairs(expected) do
+        local nearest = math.huge
+        for j = 1, 8 do
+            nearest = math.min(nearest, math.sqrt((roots[j][1] - z[1])^2 + (roots[j][2] - z[2])^2))
+        end
+        tester:assert(nearest < 1e-12, 'root ' .. z[1] .. ' ' .. z[2])
+    end
+
+    -- a batch of polynomials of degree 12, with a leading zero in the last
+    local n, m = 50, 12
+    local batch = torch.DoubleTensor(n, m + 1)
+    local roots = {}
+    for b = 1, n do
+        roots[b] = {}
+        for j = 1, m do
+            roots[b][j] = 2 * j - m + b / n
+        end
+        local c = fromRoots(roots[b], {})
+        for k = 1, m + 1 do
+            batch[b][k] = c[k] * b
+        end
+    end
+    batch[n][m + 1] = 0
+    local z, status = cephes.polroots(batch)
+    tester:asserteq(z:size(1), n)
+    tester:asserteq(z:size(2), m)
+    for b = 1, n - 1 do
+        tester:asserteq(status[b], 0, 'status ' .. b)
+        local found = {}
+        for j = 1, m do
+            tester:assertalmosteq(z[b][j][2], 0, 1e-8, 'imaginary part')
+            found[j] = z[b][j][1]
+        end
+        table.sort(found)
+        for j = 1, m do
+            tester:assertalmosteq(found[j], roots[b][j], 1e-8, 'root ' .. j .. ' of ' .. b)
+        end
+    end
+    tester:asserteq(status[n], 4)
+
+    local _, code, message = cephes.polroots(torch.DoubleTensor{ 1, 2, 0 })
+    tester:asserteq(code, 4)
+    tester:asserteq(message, 'leading coefficient is zero')
+    tester:assertError(function() cephes.polroots(torch.DoubleTensor{ 1 }) end, 'degree 0')
+
+    -- roots far from 1, whose squares overflow or underflow
+    local c = math.sqrt(3) / 2
+    for _, case in ipairs{
+        { { 1e200, 0, 1 }, { { 0, 1e100 }, { 0, -1e100 } } },
+        { { 1e-200, 0, 1 }, { { 0, 1e-100 }, { 0, -1e-100 } } },
+        { { 1e300, 0, 0, 1 }, { { -1e100, 0 }, { 0.5e100, c * 1e100 }, { 0.5e100, -c * 1e100 } } },
+    } do
+        local z, status = cephes.polroots(torch.DoubleTensor(case[1]))
+        tester:asserteq(status, 0, 'status of x^' .. #case[2] .. ' + ' .. case[1][1])
+        for _, r in ipairs(case[2]) do
+            local scale = math.sqrt(r[1]^2 + r[2]^2)
+            local nearest = math.huge
+            for j = 1, z:size(1) do
+                nearest = math.min(nearest, math.abs(z[j][1] - r[1]) / scale
+                                            + math.abs(z[j][2] - r[2]) / scale)
+            end
+            tester:assert(nearest < 1e-14, 'root ' .. r[1] .. ' ' .. r[2])
+        end
+    end
+    -- roots 1e-150 and 1e150: non-finite roots are never reported converged
+    local z, status = cephes.polroots(torch.DoubleTensor{ 1, -1e150, 1 })
+    for j = 1, 2 do
+        tester:assert(status ~= 0 or math.abs(z[j][1]) < math.huge, 'finite root ' .. j)
+    end
+    -- NaN or infinite coefficients
+    local nan = 0 / 0
+    for _, coef in ipairs{ { nan, 1, 1 }, { math.huge, 1, 1 }, { nan, 0, 0, 1 } } do
+        z, status = cephes.polroots(torch.DoubleTensor(coef))
+        tester:asserteq(status, 3, 'status of ' .. tostring(coef[1]))
+        for j = 1, z:size(1) do
+            tester:assert(z[j][1] ~= z[j][1] and z[j][2] ~= z[j][2], 'NaN root ' .. j)
+        end
+    end
+end
+
+-- polmul and poldiv switch to the transforms of polfft.c from POLFFT
+-- coefficients on; compare them with the direct loops
+function callTests.test_polfft()
+    local threshold = cephes.ffi.POLFFT
+    local n, m = 300, 120
+    cephes.polini(n)
+    local a = ffi.new("double[?]", n + 1)
+    local b = ffi.new("double[?]", n + 1)
+    local direct = ffi.new("double[?]", n + 1)
+    local fast = ffi.new("double[?]", n + 1)
+    torch.manualSeed(1)
+    for k = 0, m do
+        a[k] = torch.uniform(-1, 1) * 0.5 ^ k
+        b[k] = torch.uniform(-1, 1)
+    end
+    a[0] = 1
+
+    local function compare(f)
+        cephes.ffi.torch_cephes_POLFFT = 1e9
+        f(direct)
+        cephes.ffi.torch_cephes_POLFFT = 64
+        f(fast)
+        local err, size = 0, 0
+        for k = 0, n do
+            err = math.max(err, math.abs(fast[k] - direct[k]))
+            size = math.max(size, math.abs(direct[k]))
+        end
+        return err / size
+    end
+    tester:assertlt(compare(function(c) cephes.polmul(a, m, b, m, c) end), 1e-13, 'polmul')
+    tester:assertlt(compare(function(c) cephes.poldiv(a, m, b, m, c) end), 1e-12, 'poldiv')
+
+    -- product truncated to MAXPOL, and the reciprocal of a
+    tester:assertlt(compare(function(c) cephes.polmul(b, m, b, m, c) end), 1e-13, 'square')
+    local one = ffi.new("double[1]", { 1 })
+    cephes.ffi.torch_cephes_POLFFT = 64
+    cephes.polfrcp(a, m, fast, n)
+    cephes.polmul(a, m, fast, n, direct)
+    tester:assertalmosteq(direct[0], 1, 1e-14, 'a / a')
+    for k = 1, n do
+        tester:assertalmosteq(direct[k], 0, 1e-12, 'a / a, x^' .. k)
+    end
+
+    -- factors growing at different rates: every coefficient, however
+    -- small, to the accuracy of the direct product
+    n = 1300
+    cephes.polini(n)
+    local function geometric(q, m)
+        local x = ffi.new("double[?]", n + 1)
+        for k = 0, m do
+            x[k] = q ^ k
+        end
+        return x
+    end
+    direct = ffi.new("double[?]", n + 1)
+    fast = ffi.new("double[?]", n + 1)
+    for _, case in ipairs{ { 0.9, 599, 1.1, 699 }, { 0.5, 599, 1, 699 } } do
+        a = geometric(case[1], case[2])
+        b = geometric(case[3], case[4])
+        local name = case[1] .. '^k x ' .. case[3] .. '^k'
+        cephes.ffi.torch_cephes_POLFFT = 1e9
+        cephes.polmul(a, case[2], b, case[4], direct)
+        cephes.ffi.torch_cephes_POLFFT = 64
+        cephes.polmul(a, case[2], b, case[4], fast)
+        for k = 0, case[2] + case[4] do
+            tester:assertalmosteq(fast[k] / direct[k], 1, 1e-13, name .. ', x^' .. k)
+        end
+    end
+    tester:asserteq(fast[0], 1, '0.5^k x 1, x^0')
+    tester:asserteq(fast[1], 1.5, '0.5^k x 1, x^1')
+
+    cephes.ffi.torch_cephes_POLFFT = threshold
+    cephes.polini(max_pol)
+end
+
+function callTests.test_polyval()
+    -- one polynomial, points of any size
+    local coef = torch.DoubleTensor{ 1, -2, 0.5, 3 }
+    local x = torch.linspace(-2, 2, 21):resize(3, 7)
+    local y = cephes.polyval(coef, x)
+    tester:asserteq(y:dim(), 2)
+    local c = ffi.new("double[4]", { 1, -2, 0.5, 3 })
+    for i = 1, 3 do
+        for j = 1, 7 do
+            tester:assertalmosteq(y[i][j], cephes.poleva(c, 3, x[i][j]), 1e-13)
+        end
+    end
+
+    -- a batch, with its own points or shared ones, on both paths of
+    -- poleva_batch
+    local n, m = 5, 6
+    local batch = torch.randn(n, m + 1)
+    for _, npoints in ipairs{ 3, 300 } do
+        local points = torch.randn(n, npoints)
+        local shared = torch.randn(npoints)
+        local own = cephes.polyval(batch, points)
+        local all = cephes.polyval(batch, shared)
+        tester:asserteq(own:size(1), n)
+        tester:asserteq(own:size(2), npoints)
+        for b = 1, n do
+            local p = ffi.new("double[?]", m + 1)
+            for k = 0, m do
+                p[k] = batch[b][k + 1]
+            end
+            for j = 1, npoints do
+                tester:assertalmosteq(own[b][j], cephes.poleva(p, m, points[b][j]), 1e-12)
+                tester:assertalmosteq(all[b][j], cephes.poleva(p, m, shared[j]), 1e-12)
+            end
+        end
+    end
+    tester:assertError(function() cephes.polyval(batch, torch.randn(2, 4)) end, 'points')
+end
+
+function callTests.test_series()
+    local d = 10
+    local x = torch.zeros(d + 1)
+    x[2] = 1
+
+    -- exp(x) and atan(x) about 0
+    local e = cephes.series.exp(x)
+    local t = cephes.series.atan(x)
+    local factorial = 1
+    for k = 0, d do
+        factorial = factorial * math.max(k, 1)
+        tester:assertalmosteq(e[k + 1], 1 / factorial, 1e-15, 'exp ' .. k)
+        tester:assertalmosteq(t[k + 1], k % 2 == 1 and (-1) ^ ((k - 1) / 2) / k or 0,
+                              1e-15, 'atan ' .. k)
+    end
+
+    -- identities on a batch of series
+    local n = 40
+    local a = torch.randn(n, d + 1):mul(0.5)
+    local b = torch.randn(n, d + 1)
+    a:select(2, 1):abs():add(2)
+    b:select(2, 1):fill(0)
+    local function close(u, v, tol, name)
+        tester:assertlt((u - v):abs():max(), tol, name)
+    end
+    close(cephes.series.log(cephes.series.exp(a)), a, 1e-12, 'log exp')
+    close(cephes.series.mul(cephes.series.sqrt(a), cephes.series.sqrt(a)), a, 1e-12, 'sqrt')
+    local ab = cephes.series.mul(a, b)
+    close(cephes.series.div(ab, a), b, 1e-10, 'div')
+    close(cephes.series.add(a, b), a + b, 1e-15, 'add')
+    local s, c = cephes.series.sin(a), cephes.series.cos(a)
+    local one = cephes.series.add(cephes.series.mul(s, s), cephes.series.mul(c, c))
+    local expected = torch.zeros(n, d + 1)
+    expected:select(2, 1):fill(1)
+    close(one, expected, 1e-12, 'sin^2 + cos^2')
+    -- exp(b(x)) by composition with the series of exp about 0, b(0) = 0
+    close(cephes.series.compose(e, b), cephes.series.exp(b), 1e-12, 'compose')
+
+    -- status, and a vector with a matrix
+    local r, status = cephes.series.log(torch.DoubleTensor(n, d + 1):zero())
+    tester:asserteq(status:sum(), n)
+    tester:assert(r[1][1] ~= r[1][1], 'NaN')
+    local _, code, message = cephes.series.div(x, x)
+    tester:asserteq(code, 1)
+    tester:asserteq(message, 'constant term of the divisor is zero')
+    local xb = cephes.series.mul(x, b)
+    tester:asserteq(xb:size(1), n)
+    close(xb:narrow(2, 2, d), b:narrow(2, 1, d), 1e-15, 'x b')
+    tester:assertError(function() cephes.series.add(x, torch.zeros(d)) end, 'degrees')
+end
+
 tester:add(callTests)
 return tester:run()
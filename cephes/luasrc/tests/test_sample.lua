@@ -0,0 +1,105 @@
+require 'cephes'
+require 'totem'
+local sampleTests = {}
+local tester = totem.Tester()
+
+-- Uniforms drawn from the same stream position as the next sampler call
+local function uniforms(n)
+    local s = cephes.sample.getSeed()
+    cephes.sample.seed(s)
+    local u = cephes.sample.uniform(n)
+    cephes.sample.seed(s)
+    return u
+end
+
+function sampleTests.testUniform()
+    cephes.sample.seed(1)
+    local u = cephes.sample.uniform(1000)
+    tester:asserteq(torch.typename(u), 'torch.DoubleTensor')
+    tester:asserteq(u:nElement(), 1000, 'should get 1000 samples')
+    tester:assertgt(u:min(), 0, 'uniforms should be > 0')
+    tester:assertlt(u:max(), 1, 'uniforms should be < 1')
+    tester:assertalmosteq(u:mean(), 0.5, 0.05, 'mean of uniforms')
+
+    cephes.sample.seed(1)
+    local v = cephes.sample.uniform(1000)
+    tester:assertTensorEq(u, v, 0, 'same seed should give same stream')
+    local w = cephes.sample.uniform(1000)
+    tester:assertgt((w - v):abs():max(), 0, 'stream should advance between calls')
+end
+
+function sampleTests.testMatchesInverse()
+    cephes.sample.seed(7)
+    local n = 20
+    local u = uniforms(n)
+    local x = cephes.sample.normal(1, 2, n)
+    for i = 1, n do
+        tester:assertalmosteq(x[i], 1 + 2 * cephes.ndtri(u[i]), 1e-12, 'normal')
+    end
+
+    u = uniforms(n)
+    x = cephes.sample.gamma(2, 3.5, n)
+    for i = 1, n do
+        tester:assertalmosteq(x[i], cephes.igami(3.5, u[i]) / 2, 1e-12, 'gamma')
+    end
+
+    u = uniforms(n)
+    x = cephes.sample.beta(2, 3, n)
+    for i = 1, n do
+        tester:assertalmosteq(x[i], cephes.incbi(2, 3, u[i]), 1e-12, 'beta')
+    end
+
+    u = uniforms(n)
+    x = cephes.sample.chi2(4, n)
+    for i = 1, n do
+        tester:assertalmosteq(x[i], cephes.chdtri(4, u[i]), 1e-12, 'chi2')
+    end
+
+    u = uniforms(n)
+    x = cephes.sample.t(5, n)
+    for i = 1, n do
+        tester:assertalmosteq(x[i], cephes.stdtri(5, u[i]), 1e-12, 't')
+    end
+
+    u = uniforms(n)
+    x = cephes.sample.f(3, 7, n)
+    for i = 1, n do
+        tester:assertalmosteq(x[i], cephes.fdtri(3, 7, u[i]), 1e-9, 'F')
+    end
+end
+
+function sampleTests.testTensorParameters()
+    local n = 10
+    local b = torch.linspace(0.5, 5, n)
+    cephes.sample.seed(3)
+    local u = uniforms(n)
+    local x = cephes.sample.gamma(1, b, n)
+    for i = 1, n do
+        tester:assertalmosteq(x[i], cephes.igami(b[i], u[i]), 1e-12, 'gamma with tensor shape')
+    end
+
+    local result = torch.zeros(n)
+    local returned = cephes.sample.beta(b, 2, result)
+    tester:asserteq(returned, result, 'should fill the given tensor')
+
+    tester:assertError(function() cephes.sample.gamma(1, b, n + 1) end,
+                       'should error when parameters and count disagree')
+    tester:assertError(function() cephes.sample.gamma(1, 2) end,
+                       'should error without a count')
+end
+
+function sampleTests.testMoments()
+    cephes.sample.seed(11)
+    local n = 20000
+    local x = cephes.sample.gamma(2, 3, n)
+    tester:assertalmosteq(x:mean(), 1.5, 0.05, 'gamma mean')
+    x = cephes.sample.beta(2, 6, n)
+    tester:assertalmosteq(x:mean(), 0.25, 0.01, 'beta mean')
+    x = cephes.sample.chi2(3, n)
+    tester:assertalmosteq(x:mean(), 3, 0.1, 'chi2 mean')
+    x = cephes.sample.normal(-1, 0.5, n)
+    tester:assertalmosteq(x:std(), 0.5, 0.02, 'normal standard deviation')
+end
+
+tester:add(sampleTests)
+return tester:run()
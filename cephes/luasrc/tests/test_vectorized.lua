@@ -170,5 +170,95 @@ function vectorizeTests.testSingleColumnInputWithResult()
                         1e-16,
                         'Wrong output')
 end
+
+
+-- The incomplete gamma family runs on native batch kernels: compare with
+-- the scalar functions, for shared and per-element shape parameters
+function vectorizeTests.testIncompleteGammaBatch()
+  local n = 300
+  local a = torch.linspace(0.1, 40, n)
+  local x = torch.linspace(0, 60, n)
+  local k = torch.linspace(0, 29.9, n)
+
+  local function check(name, ...)
+    local args = { ... }
+    local result = cephes[name](unpack(args))
+    tester:asserteq(result:size(1), n, name .. ": should get " .. n .. " results")
+    local expected = torch.Tensor(n)
+    for i = 1, n do
+      local scalarArgs = {}
+      for index, arg in ipairs(args) do
+        scalarArgs[index] = torch.isTensor(arg) and arg[i] or arg
+      end
+      expected[i] = cephes[name](unpack(scalarArgs))
+    end
+    tester:assertTensorEq(result, expected, 1e-15, 'Wrong output for ' .. name)
+  end
+
+  for _, name in ipairs{'igam', 'igamc', 'chdtr', 'chdtrc'} do
+    check(name, a, x)
+    check(name, 7.5, x)
+    check(name, a, 12)
+  end
+  for _, name in ipairs{'gdtr', 'gdtrc'} do
+    check(name, 0.5, a, x)
+    check(name, a, 3.5, x)
+  end
+  for _, name in ipairs{'pdtr', 'pdtrc'} do
+    check(name, k, x:clone():add(0.1))
+    check(name, 4, x:clone():add(0.1))
+  end
+
+  -- Domain errors give the values of the scalar functions
+  local result = cephes.gdtr(1, 2, torch.linspace(-1, 1, 3))
+  tester:asserteq(result[1], 0, 'gdtr of a negative x')
+  tester:assertalmosteq(result[3], cephes.gdtr(1, 2, 1), 1e-15, 'gdtr of a positive x')
+end
+
+-- Same for the functions built on the incomplete beta integral
+function vectorizeTests.testIncompleteBetaBatch()
+  local n = 300
+  local a = torch.linspace(0.1, 40, n)
+  local b = torch.linspace(30, 0.5, n)
+  local x = torch.linspace(0, 1, n)
+  local k = torch.linspace(0, 29.9, n)
+  local t = torch.linspace(-20, 5, n)
+
+  local function check(name, ...)
+    local args = { ... }
+    local result = cephes[name](unpack(args))
+    tester:asserteq(result:size(1), n, name .. ": should get " .. n .. " results")
+    local expected = torch.Tensor(n)
+    for i = 1, n do
+      local scalarArgs = {}
+      for index, arg in ipairs(args) do
+        scalarArgs[index] = torch.isTensor(arg) and arg[i] or arg
+      end
+      expected[i] = cephes[name](unpack(scalarArgs))
+    end
+    tester:assertTensorEq(result, expected, 1e-15, 'Wrong output for ' .. name)
+  end
+
+  for _, name in ipairs{'incbet', 'btdtr'} do
+    check(name, a, b, x)
+    check(name, 2.5, 7, x)
+  end
+  for _, name in ipairs{'bdtr', 'bdtrc', 'nbdtr', 'nbdtrc'} do
+    check(name, k, 30, x)
+    check(name, 5, 30, x)
+  end
+  for _, name in ipairs{'fdtr', 'fdtrc'} do
+    check(name, 4, 9, torch.abs(t))
+    check(name, k:clone():add(1), 9, torch.abs(t))
+  end
+  check('stdtr', 5, t)
+  check('stdtr', k:clone():add(1), t)
+
+  -- bdtrc checks k < 0 before a NaN p, as the scalar function does
+  local result = cephes.bdtrc(torch.Tensor{-1, -1}, 30, torch.Tensor{0/0, 0.5})
+  tester:asserteq(result[1], cephes.bdtrc(-1, 30, 0/0), 'bdtrc of k < 0 and a NaN p')
+  tester:asserteq(result[2], 1, 'bdtrc of k < 0')
+end
+
 tester:add(vectorizeTests)
 return tester:run()
@@ -45,12 +45,18 @@ extern double torch_cephes_log ( double );
 extern double torch_cephes_exp ( double );
 extern double torch_cephes_polevl ( double, void *, int );
 extern double torch_cephes_p1evl ( double, void *, int );
+extern void torch_cephes_polevl_batch ( int, double *, double *, int,
+					double * );
+extern void torch_cephes_p1evl_batch ( int, double *, double *, int,
+				       double * );
 #else
 extern double torch_cephes_log(), torch_cephes_exp(), torch_cephes_polevl(),
     torch_cephes_p1evl();
+extern void torch_cephes_polevl_batch(), torch_cephes_p1evl_batch();
 #endif
 
 #define EUL 5.772156649015328606065e-1
+#define CHUNK 256
 
 /* 0 < x <= 2
    Ei(x) - EUL - ln(x) = x A(x)/B(x)
@@ -1061,3 +1067,131 @@ double x;
       return (torch_cephes_exp(x) * w * (1.0 + w * f));
     }
 }
+
+
+
+/*							ei_batch()
+ *
+ *	Exponential integral of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx;
+ * double x[], y[n];
+ *
+ * ei_batch( n, x, sx, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to ei( x[i*sx] ).  A stride of 0 broadcasts the
+ * first value to the whole batch.
+ *
+ * The elements of a chunk are sorted by the interval of their
+ * rational approximation, and each approximation is evaluated
+ * for all its elements at once by polevl_batch() and
+ * p1evl_batch().  The chunks are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as ei().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As ei().
+ *
+ */
+
+/* Rational approximations of ei(), by interval  */
+#define NEI 7
+static double *EIA[NEI] = { (double *) A, (double *) A6, (double *) A5,
+  (double *) A2, (double *) A4, (double *) A7, (double *) A3 };
+static double *EIB[NEI] = { (double *) B, (double *) B6, (double *) B5,
+  (double *) B2, (double *) B4, (double *) B7, (double *) B3 };
+static int EINA[NEI] = { 5, 7, 7, 9, 7, 5, 8 };
+static int EINB[NEI] = { 6, 7, 8, 9, 8, 5, 9 };
+
+
+void torch_cephes_ei_batch (n, x, sx, y)
+     int n, sx;
+     double *x, *y;
+{
+  int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+  for (i = 0; i < n; i += CHUNK)
+    {
+      double w[CHUNK], f[CHUNK], g[CHUNK], xj;
+      int r[CHUNK], pos[CHUNK], start[NEI + 1];
+      int j, k, p, nc;
+
+      nc = n - i < CHUNK ? n - i : CHUNK;
+      for (k = 0; k <= NEI; k++)
+	start[k] = 0;
+      for (j = 0; j < nc; j++)
+	{
+	  xj = x[(i + j) * sx];
+	  if (!(xj > 0.0))
+	    {
+	      r[j] = -1;
+	      if (xj <= 0.0)
+		{
+		  torch_cephes_mtherr ("ei", DOMAIN);
+		  y[i + j] = 0.0;
+		}
+	      else
+		y[i + j] = xj;
+	      continue;
+	    }
+	  k = 0;
+	  if (xj >= 2.0)
+	    for (k = 1; k < NEI - 1 && xj >= (double) (2 << k); k++)
+	      ;
+	  r[j] = k;
+	  start[k + 1] += 1;
+	}
+
+      /* Sort by interval; the elements of interval k end up at
+         pos[start[k]], ..., pos[start[k+1]-1]  */
+      for (k = 0; k < NEI; k++)
+	start[k + 1] += start[k];
+      for (j = 0; j < nc; j++)
+	if (r[j] >= 0)
+	  pos[start[r[j]]++] = j;
+      for (k = NEI; k > 0; k--)
+	start[k] = start[k - 1];
+      start[0] = 0;
+
+      for (p = 0; p < start[NEI]; p++)
+	{
+	  xj = x[(i + pos[p]) * sx];
+	  w[p] = r[pos[p]] == 0 ? xj : 1.0 / xj;
+	}
+      for (k = 0; k < NEI; k++)
+	{
+	  p = start[k];
+	  if (start[k + 1] > p)
+	    {
+	      torch_cephes_polevl_batch (start[k + 1] - p, &w[p], EIA[k],
+					 EINA[k], &f[p]);
+	      torch_cephes_p1evl_batch (start[k + 1] - p, &w[p], EIB[k],
+					EINB[k], &g[p]);
+	    }
+	}
+      for (p = 0; p < start[NEI]; p++)
+	{
+	  j = pos[p];
+	  xj = x[(i + j) * sx];
+	  f[p] = f[p] / g[p];
+	  if (r[j] == 0)
+	    y[i + j] = EUL + torch_cephes_log (xj) + xj * f[p];
+	  else
+	    y[i + j] = torch_cephes_exp (xj) * w[p] * (1.0 + w[p] * f[p]);
+	}
+    }
+}
@@ -55,11 +55,14 @@ extern double torch_cephes_gamma ( double );
 extern double torch_cephes_log ( double );
 extern double torch_cephes_exp ( double );
 extern double torch_cephes_fabs ( double );
+double torch_cephes_expn ( int, double );
 #else
 double torch_cephes_pow(), torch_cephes_gamma(), torch_cephes_log(),
     torch_cephes_exp(), torch_cephes_fabs();
+double torch_cephes_expn();
 #endif
 #define EUL 0.57721566490153286060
+#define CHUNK 256
 #define BIG  1.44115188075855872E+17
 extern double torch_cephes_MAXNUM, torch_cephes_MACHEP, torch_cephes_MAXLOG;
 
@@ -121,7 +124,7 @@ if( x > 1.0 )
 
 /*		Power series expansion		*/
 
-psi = -EUL - log(x);
+psi = -EUL - torch_cephes_log(x);
 for( i=1; i<n; i++ )
 	psi = psi + 1.0/i;
 
@@ -143,7 +146,7 @@ do
 		ans += yk/pk;
 		}
 	if( ans != 0.0 )
-		t = fabs(yk/ans);
+		t = torch_cephes_fabs(yk/ans);
 	else
 		t = 1.0;
 	}
@@ -151,7 +154,7 @@ while( t > torch_cephes_MACHEP );
 k = xk;
 t = n;
 r = n - 1;
-ans = (torch_cephes_pow(z, r) * psi / gamma(t)) - ans;
+ans = (torch_cephes_pow(z, r) * psi / torch_cephes_gamma(t)) - ans;
 goto done;
 
 /*							expn.c	*/
@@ -191,7 +194,7 @@ do
 	pkm1 = pk;
 	qkm2 = qkm1;
 	qkm1 = qk;
-if( fabs(pk) > big )
+if( torch_cephes_fabs(pk) > big )
 		{
 		pkm2 /= big;
 		pkm1 /= big;
@@ -206,3 +209,110 @@ ans *= torch_cephes_exp( -x );
 done:
 return( ans );
 }
+
+
+
+/*							expn_batch()
+ *
+ *	Exponential integrals En of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sk, sx, m;
+ * double k[], x[], y[n], z[n*m];
+ *
+ * expn_batch( n, k, sk, x, sx, y );
+ * expn_orders( n, m, x, sx, z );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * expn_batch() sets y[i] to expn( k[i*sk], x[i*sx] ), the order
+ * being truncated to an integer.  A stride of 0 broadcasts the
+ * first value to the whole batch.
+ *
+ * expn_orders() sets z[i*m + j-1] to E_j( x[i*sx] ) for the
+ * orders j = 1, ..., m, from a single evaluation of expn() at
+ * each x and the recurrence
+ *
+ *                  -x
+ *    j E   (x) =  e    -  x E (x) .
+ *       j+1                  j
+ *
+ * The recurrence is run upwards from the order j0 = floor(x),
+ * or 1 if x < 1, and downwards below it, the directions in which
+ * it is stable; j0 is at most m.  Arguments that are 0, negative
+ * or greater than MAXLOG use expn() for each order.
+ *
+ * The chunks of the batch are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * expn_batch() gives the same values as expn().  The values of
+ * expn_orders() are within a few units in the last place of
+ * those of expn().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As expn().
+ *
+ */
+
+void torch_cephes_expn_batch( n, k, sk, x, sx, y )
+int n, sk, sx;
+double *k, *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	y[i] = torch_cephes_expn( (int) k[i*sk], x[i*sx] );
+}
+
+
+
+void torch_cephes_expn_orders( n, m, x, sx, y )
+int n, m, sx;
+double *x, *y;
+{
+int i;
+
+if( m <= 0 )
+	return;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double e, xj, *yj;
+	int j, k, k0, nc;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	for( j=0; j<nc; j++ )
+		{
+		xj = x[(i+j)*sx];
+		yj = &y[(i+j)*m];
+		if( !(xj > 0.0 && xj <= torch_cephes_MAXLOG) )
+			{
+			for( k=1; k<=m; k++ )
+				yj[k-1] = torch_cephes_expn( k, xj );
+			continue;
+			}
+		e = torch_cephes_exp( -xj );
+		k0 = xj < (double) m ? (int) xj : m;
+		if( k0 < 1 )
+			k0 = 1;
+		yj[k0-1] = torch_cephes_expn( k0, xj );
+		/* downwards, x > k */
+		for( k=k0-1; k>=1; k-- )
+			yj[k-1] = (e - k * yj[k]) / xj;
+		/* upwards, x < k + 1 */
+		for( k=k0; k<m; k++ )
+			yj[k] = (e - xj * yj[k-1]) / k;
+		}
+	}
+}
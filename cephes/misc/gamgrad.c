@@ -0,0 +1,151 @@
+/*							gamgrad.c
+ *
+ *	Gamma functions and their derivatives
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx, sa, sb;
+ * double x[], a[], b[], y[n], dy[n], da[n], db[n];
+ *
+ * lgam_grad( n, x, sx, y, dy );
+ * gamma_grad( n, x, sx, y, dy );
+ * psi_grad( n, x, sx, y, dy );
+ * beta_grad( n, a, sa, b, sb, y, da, db );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Each kernel sets y[i] to the function of the parameters of
+ * element i, which have strides sx, sa, sb (0 to broadcast a
+ * single value), and dy[i], or da[i] and db[i], to its partial
+ * derivatives:
+ *
+ *   d/dx lgam(x)  = psi(x),
+ *   d/dx gamma(x) = gamma(x) psi(x),
+ *   d/dx psi(x)   = polygamma(1,x),
+ *   d/da beta(a,b) = beta(a,b) ( psi(a) - psi(a+b) ),
+ *
+ * and symmetrically in b.  beta_grad() reuses psi(a) and psi(b)
+ * along runs of equal parameters, so that a shared a or b costs
+ * one evaluation per chunk.  The elements are computed in parallel.
+ *
+ *
+ *
+ * ACCURACY:
+ *
+ * The values are those of lgam(), gamma(), psi() and beta(), and
+ * the derivatives have the accuracy of psi() and polygamma().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * Those of the functions and their derivatives.
+ *
+ */
+
+#include "mconf.h"
+#ifdef ANSIPROT
+extern double torch_cephes_lgam ( double );
+extern double torch_cephes_gamma ( double );
+extern double torch_cephes_beta ( double, double );
+extern double torch_cephes_psi ( double );
+extern double torch_cephes_trigamma ( double );
+#else
+double torch_cephes_lgam(), torch_cephes_gamma(), torch_cephes_beta();
+double torch_cephes_psi(), torch_cephes_trigamma();
+#endif
+
+#define CHUNK 256
+
+
+
+void torch_cephes_lgam_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	y[i] = torch_cephes_lgam( x[i*sx] );
+	dy[i] = torch_cephes_psi( x[i*sx] );
+	}
+}
+
+
+
+void torch_cephes_gamma_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	y[i] = torch_cephes_gamma( x[i*sx] );
+	dy[i] = y[i] * torch_cephes_psi( x[i*sx] );
+	}
+}
+
+
+
+void torch_cephes_psi_grad( n, x, sx, y, dy )
+int n, sx;
+double *x, *y, *dy;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	y[i] = torch_cephes_psi( x[i*sx] );
+	dy[i] = torch_cephes_trigamma( x[i*sx] );
+	}
+}
+
+
+
+void torch_cephes_beta_grad( n, a, sa, b, sb, y, da, db )
+int n, sa, sb;
+double *a, *b, *y, *da, *db;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double av, bv, pa, pb, pab, ca, cb;
+	int j, nc;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	/* psi of the last a and b, reused along runs of equal values */
+	ca = a[i*sa];
+	cb = b[i*sb];
+	pa = torch_cephes_psi( ca );
+	pb = torch_cephes_psi( cb );
+	for( j=0; j<nc; j++ )
+		{
+		av = a[(i+j)*sa];
+		bv = b[(i+j)*sb];
+		if( av != ca )
+			{
+			ca = av;
+			pa = torch_cephes_psi( ca );
+			}
+		if( bv != cb )
+			{
+			cb = bv;
+			pb = torch_cephes_psi( cb );
+			}
+		pab = torch_cephes_psi( av + bv );
+		y[i+j] = torch_cephes_beta( av, bv );
+		da[i+j] = y[i+j] * (pa - pab);
+		db[i+j] = y[i+j] * (pb - pab);
+		}
+	}
+}
@@ -0,0 +1,288 @@
+/*							mvgam.c
+ *
+ *	Multivariate gamma function
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, p;
+ * double x, y, lmvgam(), mvgam();
+ *
+ * y = lmvgam( x, p );
+ * y = mvgam( x, p );
+ *
+ * lmvgam_batch( n, x, sx, p, sp, y );
+ * mvgam_batch( n, x, sx, p, sp, y );
+ * lmvgam_grad( n, x, sx, p, sp, y, dy );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Returns the logarithm of the multivariate gamma function of
+ * dimension p,
+ *
+ *                       p-1
+ *                        -
+ *  lmvgam(x,p) = c(p) +  >  lgam( x - j/2 ),   c(p) = p(p-1)/4 log(pi),
+ *                        -
+ *                       j=0
+ *
+ * and mvgam(x,p) = exp( lmvgam(x,p) ).  lmvgam(x,1) = lgam(x).
+ *
+ * In the domain x > (p-1)/2 of the Wishart distribution, the
+ * arguments form two chains z, z+1, z+2, ... starting at
+ * z = x - (p-1)/2 and z = x - (p-2)/2.  Along a chain of k terms
+ *
+ *    k-1                          k-1   i-1
+ *     -                            -     -
+ *     >  lgam( z+i ) = k lgam(z) + >  log | | (z+t),
+ *     -                            -     - -
+ *    i=0                          i=1   t=0
+ *
+ * so that each chain costs one lgam and one log, the products
+ * being accumulated in floating point with a separate binary
+ * exponent.  Elsewhere the terms are summed directly.
+ *
+ * The batch kernels take x and p as arrays of doubles with strides
+ * sx and sp (0 to broadcast a single value), p being truncated to
+ * an integer.  lmvgam_grad also writes the derivative with respect
+ * to x,
+ *
+ *                 p-1
+ *   d              -
+ *  -- lmvgam =     >  psi( x - j/2 ),
+ *  dx              -
+ *                 j=0
+ *
+ * accumulated along the same chains from psi(z+1) = psi(z) + 1/z.
+ *
+ *
+ *
+ * ACCURACY:
+ *
+ * The absolute error of lmvgam is of the order of
+ * p MACHEP max( 1, |lmvgam| ), no worse than the direct sum of the
+ * p values of lgam.
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ *   message         condition      value returned
+ * lmvgam domain       p < 0             0.0
+ *
+ * lgam and psi report the poles x - j/2 = 0, -1, -2, ...
+ *
+ */
+
+#include "mconf.h"
+#ifdef ANSIPROT
+extern double torch_cephes_lgam ( double );
+extern double torch_cephes_psi ( double );
+extern double torch_cephes_log ( double );
+extern double torch_cephes_exp ( double );
+static double chain ( double, int, double * );
+static double lmvgm ( double, int, double * );
+static void lmvgamv ( int, double *, int, double *, int, int, double *,
+		      double * );
+double torch_cephes_lmvgam ( double, int );
+#else
+double torch_cephes_lgam(), torch_cephes_psi();
+double torch_cephes_log(), torch_cephes_exp();
+static double chain(), lmvgm();
+static void lmvgamv();
+double torch_cephes_lmvgam();
+#endif
+
+#define CHUNK 256
+
+static double LOGPI = 1.14472988584940017414;
+static double LOGE2 = 6.93147180559945309417E-1;
+
+/* Rescaling of the products, 2^500 and 2^-500 */
+#define BIG 3.2733906078961418700E150
+#define BIGINV 3.0549363634996046820E-151
+
+
+/* Sum of lgam( z+i ) for i = 0..k-1, z > 0.  If dl is not null,
+ * *dl is set to the sum of psi( z+i ).
+ */
+static double chain( z, k, dl )
+double z;
+int k;
+double *dl;
+{
+double pr, q, zi, l, d;
+int i, ep, eq;
+
+if( k <= 0 )
+	{
+	if( dl )
+		*dl = 0.0;
+	return( 0.0 );
+	}
+/* pr = (z)(z+1)...(z+i-1) 2^(-500 ep) and q the product of the
+ * successive pr 2^(-500 eq).
+ */
+pr = 1.0;
+q = 1.0;
+ep = 0;
+eq = 0;
+d = 0.0;
+zi = z;
+for( i=1; i<k; i++ )
+	{
+	pr *= zi;
+	if( pr > BIG )
+		{
+		pr *= BIGINV;
+		ep += 1;
+		}
+	else if( pr < BIGINV )
+		{
+		pr *= BIG;
+		ep -= 1;
+		}
+	q *= pr;
+	eq += ep;
+	if( q > BIG )
+		{
+		q *= BIGINV;
+		eq += 1;
+		}
+	else if( q < BIGINV )
+		{
+		q *= BIG;
+		eq -= 1;
+		}
+	if( dl && i > 1 )
+		d += (k - i) / zi;
+	zi += 1.0;
+	}
+l = k * torch_cephes_lgam( z ) + torch_cephes_log( q ) + 500.0 * LOGE2 * eq;
+/* psi( z+1 ) = psi( z ) + 1/z, without cancellation at small z */
+if( dl )
+	{
+	if( k == 1 )
+		*dl = torch_cephes_psi( z );
+	else
+		*dl = k * torch_cephes_psi( z + 1.0 ) - 1.0 / z + d;
+	}
+return( l );
+}
+
+
+
+/* lmvgam( x, p ), with the sum of the psi values in *dl if dl
+ * is not null.
+ */
+static double lmvgm( x, p, dl )
+double x;
+int p;
+double *dl;
+{
+double z, l, la, lb, da, db;
+int j;
+
+if( p < 0 )
+	{
+	torch_cephes_mtherr( "lmvgam", DOMAIN );
+	if( dl )
+		*dl = 0.0;
+	return( 0.0 );
+	}
+l = 0.25 * p * (p - 1) * LOGPI;
+z = x - 0.5 * (p - 1);
+if( z > 0.0 )
+	{
+	la = chain( z, (p + 1) / 2, dl ? &da : 0 );
+	lb = chain( z + 0.5, p / 2, dl ? &db : 0 );
+	if( dl )
+		*dl = da + db;
+	return( l + la + lb );
+	}
+
+/* direct sum */
+da = 0.0;
+for( j=0; j<p; j++ )
+	{
+	z = x - 0.5 * j;
+	l += torch_cephes_lgam( z );
+	if( dl )
+		da += torch_cephes_psi( z );
+	}
+if( dl )
+	*dl = da;
+return( l );
+}
+
+
+
+double torch_cephes_lmvgam( x, p )
+double x;
+int p;
+{
+return( lmvgm( x, p, 0 ) );
+}
+
+
+
+double torch_cephes_mvgam( x, p )
+double x;
+int p;
+{
+return( torch_cephes_exp( lmvgm( x, p, 0 ) ) );
+}
+
+
+
+/* lmvgam, or mvgam if ex is nonzero, over a batch */
+static void lmvgamv( n, x, sx, p, sp, ex, y, dy )
+int n, sx, sp, ex;
+double *x, *p, *y, *dy;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	int j, nc;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	for( j=0; j<nc; j++ )
+		{
+		y[i+j] = lmvgm( x[(i+j)*sx], (int) p[(i+j)*sp],
+				dy ? &dy[i+j] : 0 );
+		if( ex )
+			y[i+j] = torch_cephes_exp( y[i+j] );
+		}
+	}
+}
+
+
+
+void torch_cephes_lmvgam_batch( n, x, sx, p, sp, y )
+int n, sx, sp;
+double *x, *p, *y;
+{
+lmvgamv( n, x, sx, p, sp, 0, y, 0 );
+}
+
+
+
+void torch_cephes_mvgam_batch( n, x, sx, p, sp, y )
+int n, sx, sp;
+double *x, *p, *y;
+{
+lmvgamv( n, x, sx, p, sp, 1, y, 0 );
+}
+
+
+
+void torch_cephes_lmvgam_grad( n, x, sx, p, sp, y, dy )
+int n, sx, sp;
+double *x, *p, *y, *dy;
+{
+lmvgamv( n, x, sx, p, sp, 0, y, dy );
+}
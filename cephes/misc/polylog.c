@@ -215,17 +215,31 @@ extern double torch_cephes_powi ( double, int );
 extern double torch_cephes_log ( double );
 extern double torch_cephes_fac ( int i );
 extern double torch_cephes_fabs (double);
+extern void *malloc ( unsigned long );
+extern void free ( void * );
 double torch_cephes_polylog (int, double);
+static int polyreg (int, double);
+static void polylanes (int, int, int, double *, double *);
+static void polygroup (int, int, int, double *, int *, double *);
+static double polyzeta (double *, int, int);
+static void polyorders (int, double, double *, double *);
 #else
 extern double torch_cephes_spence(), torch_cephes_polevl(),
     torch_cephes_p1evl(), torch_cephes_zetac();
 extern double torch_cephes_pow(), torch_cephes_powi(), torch_cephes_log();
 extern double torch_cephes_fac(); /* factorial */
 extern double torch_cephes_fabs();
+void *malloc ();
+void free ();
 double torch_cephes_polylog();
+static int polyreg ();
+static void polylanes (), polygroup (), polyorders ();
+static double polyzeta ();
 #endif
 extern double torch_cephes_MACHEP;
 
+#define CHUNK 256
+
 double
 torch_cephes_polylog (n, x)
      int n;
@@ -467,3 +481,466 @@ pseries:
   s += x;
   return s;
 }
+
+
+
+
+/*							polylog_batch()
+ *
+ *	Polylogarithms of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sk, sx, m;
+ * double k[], x[], y[n], z[n*m];
+ *
+ * polylog_batch( n, k, sk, x, sx, y );
+ * polylog_orders( n, m, x, sx, z );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * polylog_batch() sets y[i] to polylog( k[i*sk], x[i*sx] ), the
+ * order being truncated to an integer.  A stride of 0 broadcasts
+ * the first value to the whole batch.
+ *
+ * Each chunk of the batch is split, for each run of elements of
+ * the same order, into the arguments of the power series, those
+ * of the expansion in powers of log(x), and the others, which go
+ * through polylog().  The two expansions are then summed for all
+ * their arguments at once, term after term, each element leaving
+ * the sum when its own series has converged.  The powers k**n of
+ * the power series and the zeta function values of the expansion
+ * in log(x) are computed once for all the elements of a group.
+ *
+ * polylog_orders() sets z[i*m + j-1] to Li_j( x[i*sx] ) for the
+ * orders j = 1, ..., m.  For |x| < 0.75 the orders share the
+ * powers of x of one power series,
+ *
+ *                inf   k
+ *                 -   x
+ *   Li (x)  =     >   ---  ,
+ *     j           -     j
+ *                k=1   k
+ *
+ * and for 0.75 <= x < 1 the powers of log(x), the log of -log(x)
+ * and the zeta function values of the expansion in log(x).  For
+ * -1 < x <= -0.75 the orders j >= 2 follow from those of x**2 and -x by
+ *
+ *                1-j    2
+ *   Li (x)  =  2    Li (x ) - Li (-x) .
+ *     j               j         j
+ *
+ * The other arguments use polylog() for each order.
+ *
+ * The chunks of the batch are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * polylog_batch() gives the same values as polylog().  The
+ * values of polylog_orders() are within a few units in the last
+ * place of those of polylog().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As polylog().
+ *
+ */
+
+/* Evaluation of polylog (n, x) in a batch */
+#define PSCALAR 0
+#define PSERIES 1
+#define PLOGX 2
+
+static int
+polyreg (n, x)
+     int n;
+     double x;
+{
+  if (n < 2 || x >= 1.0 || x <= -1.0)
+    return PSCALAR;
+  if (n == 2 && x < 0.0)
+    return PSCALAR;
+  if (n == 3)
+    return x > 0.8 ? PSCALAR : PSERIES;
+  if (n == 4)
+    return x >= 0.875 ? PSCALAR : PSERIES;
+  return x < 0.75 ? PSERIES : PLOGX;
+}
+
+
+/* The m arguments x[] of order n of the expansion reg, summed in
+   lock step.  The operations on each element are those of polylog ().  */
+static void
+polylanes (n, reg, m, x, y)
+     int n, reg, m;
+     double *x, *y;
+{
+  double p[CHUNK], q[CHUNK], s[CHUNK], z[CHUNK], e[CHUNK];
+  int a[CHUNK];
+  double c, h, k, r, tol;
+  int i, j, l, na;
+
+  if (reg == PSERIES)
+    {
+      /* Lane i of the sum holds the element a[i]; the elements whose
+         series has converged are moved out, to e[], keeping the lanes
+         still summed contiguous.  */
+      for (i = 0; i < m; i++)
+	{
+	  z[i] = x[i];
+	  p[i] = x[i] * x[i] * x[i];
+	  s[i] = 0.0;
+	  a[i] = i;
+	}
+      tol = n == 3 ? 1.1e-16 : torch_cephes_MACHEP;
+      na = m;
+      k = 3.0;
+      while (na > 0)
+	{
+	  k += 1.0;
+	  r = n == 3 ? k * k * k : torch_cephes_powi (k, n);
+	  for (i = 0; i < na; i++)
+	    {
+	      p[i] = p[i] * z[i];
+	      h = p[i] / r;
+	      s[i] = s[i] + h;
+	      q[i] = h / s[i];
+	    }
+	  l = 0;
+	  for (i = 0; i < na; i++)
+	    {
+	      if (q[i] > tol || q[i] < -tol)
+		{
+		  if (l != i)
+		    {
+		      z[l] = z[i];
+		      p[l] = p[i];
+		      s[l] = s[i];
+		      a[l] = a[i];
+		    }
+		  l += 1;
+		}
+	      else
+		e[a[i]] = s[i];
+	    }
+	  na = l;
+	}
+      for (i = 0; i < m; i++)
+	{
+	  if (n == 3)
+	    {
+	      h = x[i] * x[i] * x[i] / 27.0;
+	      h = h + .125 * x[i] * x[i];
+	      h = h + x[i];
+	      y[i] = e[i] + h;
+	    }
+	  else
+	    {
+	      e[i] += x[i] * x[i] * x[i] / torch_cephes_powi (3.0, n);
+	      e[i] += x[i] * x[i] / torch_cephes_powi (2.0, n);
+	      y[i] = e[i] + x[i];
+	    }
+	}
+      return;
+    }
+
+  /* Expansion in powers of log(x) */
+  for (i = 0; i < m; i++)
+    {
+      z[i] = torch_cephes_log (x[i]);
+      h = -torch_cephes_log (-z[i]);
+      for (j = 1; j < n; j++)
+	h = h + 1.0 / j;
+      e[i] = h;
+      p[i] = 1.0;
+      a[i] = i;
+    }
+  c = torch_cephes_zetac ((double) n) + 1.0;
+  for (i = 0; i < m; i++)
+    s[i] = c;
+  for (j = 1; j <= n + 1; j++)
+    {
+      if (j != n - 1)
+	c = torch_cephes_zetac ((double) (n - j)) + 1.0;
+      for (i = 0; i < m; i++)
+	{
+	  p[i] = p[i] * z[i] / j;
+	  s[i] = s[i] + (j == n - 1 ? e[i] : c) * p[i];
+	}
+    }
+  for (i = 0; i < m; i++)
+    z[i] = z[i] * z[i];
+  na = m;
+  j = n + 3;
+  while (na > 0)
+    {
+      c = torch_cephes_zetac ((double) (n - j)) + 1.0;
+      l = 0;
+      for (i = 0; i < na; i++)
+	{
+	  r = p[a[i]] * z[a[i]] / ((j - 1) * j);
+	  p[a[i]] = r;
+	  h = c * r;
+	  s[a[i]] = s[a[i]] + h;
+	  if (!(torch_cephes_fabs (h / s[a[i]]) < torch_cephes_MACHEP))
+	    a[l++] = a[i];
+	}
+      na = l;
+      j += 2;
+    }
+  for (i = 0; i < m; i++)
+    y[i] = s[i];
+}
+
+
+/* Evaluate the group of m arguments x[] of order n of the expansion
+   reg, and scatter the results to y[idx[]]  */
+static void
+polygroup (n, reg, m, x, idx, y)
+     int n, reg, m;
+     double *x, *y;
+     int *idx;
+{
+  double v[CHUNK];
+  int i;
+
+  if (m == 0)
+    return;
+  polylanes (n, reg, m, x, v);
+  for (i = 0; i < m; i++)
+    y[idx[i]] = v[i];
+}
+
+
+void
+torch_cephes_polylog_batch (n, k, sk, x, sx, y)
+     int n, sk, sx;
+     double *k, *x, *y;
+{
+  int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+  for (i = 0; i < n; i += CHUNK)
+    {
+      double xs[CHUNK], xl[CHUNK], xj;
+      int is[CHUNK], il[CHUNK];
+      int j, nc, ns, nl, kj, ck;
+
+      nc = n - i < CHUNK ? n - i : CHUNK;
+      ns = nl = 0;
+      ck = 0;
+      for (j = 0; j < nc; j++)
+	{
+	  kj = (int) k[(i + j) * sk];
+	  xj = x[(i + j) * sx];
+	  if (kj != ck)
+	    {
+	      polygroup (ck, PSERIES, ns, xs, is, y);
+	      polygroup (ck, PLOGX, nl, xl, il, y);
+	      ns = nl = 0;
+	      ck = kj;
+	    }
+	  if (xj != xj)
+	    {
+	      /* NaN */
+	      y[i + j] = xj;
+	      continue;
+	    }
+	  switch (polyreg (kj, xj))
+	    {
+	    case PSERIES:
+	      xs[ns] = xj;
+	      is[ns++] = i + j;
+	      break;
+	    case PLOGX:
+	      xl[nl] = xj;
+	      il[nl++] = i + j;
+	      break;
+	    default:
+	      y[i + j] = torch_cephes_polylog (kj, xj);
+	    }
+	}
+      polygroup (ck, PSERIES, ns, xs, is, y);
+      polygroup (ck, PLOGX, nl, xl, il, y);
+    }
+}
+
+
+/* Number of odd negative integers of the table of zeta values of
+   polylog_orders (), beyond which the terms are negligible  */
+#define NZETA 40
+
+/* zeta (q) from the table zt[] of zeta (m), ..., zeta (0), then
+   zeta (-1), zeta (-3), ..., zeta (-2 NZETA + 1); 0 beyond  */
+static double
+polyzeta (zt, m, q)
+     double *zt;
+     int m, q;
+{
+  if (q >= 0)
+    return zt[m - q];
+  if ((q & 1) == 0)
+    return 0.0;
+  q = (-q + 1) / 2;
+  if (q > NZETA)
+    return 0.0;
+  return zt[m + q];
+}
+
+
+/* Li_1 (x), ..., Li_m (x) to y[], for -0.75 < x < 1, from the table
+   zt[] of polyzeta ()  */
+static void
+polyorders (m, x, zt, y)
+     int m;
+     double x;
+     double *zt, *y;
+{
+  double h, p, r, t, u, v, w;
+  int o, q, top;
+
+  y[0] = -torch_cephes_log (1.0 - x);
+  if (m == 1)
+    return;
+
+  if (x < 0.75)
+    {
+      /* Power series of the orders 2, ..., top from the same powers
+         of x; the higher orders converge first.  The first three
+         terms are added last, as in polylog ().  */
+      for (o = 2; o <= m; o++)
+	y[o - 1] = 0.0;
+      p = x * x * x;
+      t = 3.0;
+      top = m;
+      while (top >= 2)
+	{
+	  p = p * x;
+	  t += 1.0;
+	  r = 1.0 / t;
+	  h = p * r;
+	  for (o = 2; o <= top; o++)
+	    {
+	      h = h * r;
+	      y[o - 1] = y[o - 1] + h;
+	    }
+	  /* h is the term of order top */
+	  while (top >= 2 && torch_cephes_fabs (h)
+		 <= torch_cephes_MACHEP * torch_cephes_fabs (y[top - 1]))
+	    {
+	      top -= 1;
+	      h = h * t;
+	    }
+	}
+      u = x * x * x / 3.0;
+      v = x * x / 2.0;
+      for (o = 2; o <= m; o++)
+	{
+	  u = u / 3.0;
+	  v = v / 2.0;
+	  y[o - 1] = y[o - 1] + u + v + x;
+	}
+      return;
+    }
+
+  /* Expansion in powers of w = log(x): the coefficient of
+     w**(o-1)/(o-1)! is -log(-w) + 1 + 1/2 + ... + 1/(o-1) in
+     place of zeta (1).  */
+  w = torch_cephes_log (x);
+  r = -torch_cephes_log (-w);
+  for (o = 2; o <= m; o++)
+    {
+      r = r + 1.0 / (o - 1);
+      p = 1.0;
+      u = zt[m - o];
+      for (q = 1; q <= o + 1; q++)
+	{
+	  p = p * w / q;
+	  u = u + (q == o - 1 ? r : polyzeta (zt, m, o - q)) * p;
+	}
+      for (q = o + 3; q - o <= 2 * NZETA - 1; q += 2)
+	{
+	  p = p * w * w / ((q - 1) * q);
+	  h = polyzeta (zt, m, o - q) * p;
+	  u = u + h;
+	  if (torch_cephes_fabs (h) < torch_cephes_MACHEP * torch_cephes_fabs (u))
+	    break;
+	}
+      y[o - 1] = u;
+    }
+}
+
+
+void
+torch_cephes_polylog_orders (n, m, x, sx, y)
+     int n, m, sx;
+     double *x, *y;
+{
+  double *zt;
+  int i, q;
+
+  if (m <= 0)
+    return;
+  zt = (double *) malloc ((m + 1 + NZETA) * sizeof (double));
+  if (zt == (double *) 0)
+    {
+      for (i = 0; i < n; i++)
+	for (q = 1; q <= m; q++)
+	  y[i * m + q - 1] = torch_cephes_polylog (q, x[i * sx]);
+      return;
+    }
+  for (q = 0; q <= m; q++)
+    zt[m - q] = q == 1 ? 0.0 : torch_cephes_zetac ((double) q) + 1.0;
+  for (q = 1; q <= NZETA; q++)
+    zt[m + q] = torch_cephes_zetac ((double) (1 - 2 * q)) + 1.0;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+  for (i = 0; i < n; i += CHUNK)
+    {
+      double *v, f, xj, *yj;
+      int j, nc, o;
+
+      nc = n - i < CHUNK ? n - i : CHUNK;
+      v = (double *) 0;
+      for (j = 0; j < nc; j++)
+	{
+	  xj = x[(i + j) * sx];
+	  yj = &y[(i + j) * m];
+	  if (xj > -0.75 && xj < 1.0)
+	    {
+	      polyorders (m, xj, zt, yj);
+	      continue;
+	    }
+	  if (xj > -1.0 && xj <= -0.75)
+	    {
+	      if (v == (double *) 0)
+		v = (double *) malloc (m * sizeof (double));
+	      if (v != (double *) 0)
+		{
+		  polyorders (m, xj * xj, zt, yj);
+		  polyorders (m, -xj, zt, v);
+		  /* Li_1 directly: the recurrence cancels for it  */
+		  yj[0] = -torch_cephes_log (1.0 - xj);
+		  f = 0.5;
+		  for (o = 2; o <= m; o++)
+		    {
+		      yj[o - 1] = f * yj[o - 1] - v[o - 1];
+		      f = 0.5 * f;
+		    }
+		  continue;
+		}
+	    }
+	  for (o = 1; o <= m; o++)
+	    yj[o - 1] = torch_cephes_polylog (o, xj);
+	}
+      if (v)
+	free (v);
+    }
+  free (zt);
+}
@@ -504,11 +504,15 @@ extern double torch_cephes_log ( double );
 extern double torch_cephes_exp ( double );
 extern double torch_cephes_fabs ( double );
 extern double torch_cephes_chbevl ( double, void *, int );
+extern void torch_cephes_chbevl_batch ( int, double *, double *, int,
+					double * );
 #else
 double torch_cephes_log(), torch_cephes_exp(), torch_cephes_fabs(),
     torch_cephes_chbevl();
+void torch_cephes_chbevl_batch();
 #endif
 #define EUL 0.57721566490153286061
+#define CHUNK 256
 extern double torch_cephes_MACHEP, torch_cephes_MAXNUM, torch_cephes_PIO2;
 
 int torch_cephes_shichi( x, si, ci )
@@ -598,3 +602,192 @@ if( sign )
 *ci = EUL + torch_cephes_log(x) + c;
 return(0);
 }
+
+
+
+/*							shichi_batch()
+ *
+ *	Hyperbolic sine and cosine integrals of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx;
+ * double x[], shi[n], chi[n];
+ *
+ * shichi_batch( n, x, sx, shi, chi );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets shi[i] and chi[i] to the integrals Shi and Chi of
+ * x[i*sx], as shichi().  A stride of 0 broadcasts the first
+ * value to the whole batch.
+ *
+ * The elements of a chunk are sorted by method.  The power
+ * series of the arguments below 8 are summed together, term
+ * after term, each element leaving the sum when its own series
+ * has converged.  The Chebyshev expansions of each interval are
+ * evaluated for all their arguments at once by chbevl_batch().
+ * The chunks are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as shichi().
+ *
+ */
+
+void torch_cephes_shichi_batch( n, x, sx, shi, chi )
+int n, sx;
+double *x, *shi, *chi;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double z[CHUNK], a[CHUNK], s[CHUNK], c[CHUNK], u[CHUNK];
+	double k, t, xj;
+	int m[CHUNK], pos[CHUNK], start[4];
+	int j, l, na, nc, p, q;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	/* 0: power series, 1: 8 <= x < 18, 2: 18 <= x <= 88 */
+	start[0] = start[1] = start[2] = start[3] = 0;
+	for( j=0; j<nc; j++ )
+		{
+		xj = torch_cephes_fabs( x[(i+j)*sx] );
+		m[j] = -1;
+		if( xj == 0.0 )
+			{
+			shi[i+j] = 0.0;
+			chi[i+j] = -torch_cephes_MAXNUM;
+			}
+		else if( xj > 88.0 )
+			{
+			shi[i+j] = x[(i+j)*sx] < 0.0 ? -torch_cephes_MAXNUM
+				: torch_cephes_MAXNUM;
+			chi[i+j] = torch_cephes_MAXNUM;
+			}
+		else if( xj != xj )
+			shi[i+j] = chi[i+j] = xj;
+		else
+			{
+			m[j] = xj < 8.0 ? 0 : (xj < 18.0 ? 1 : 2);
+			start[m[j]+1] += 1;
+			}
+		}
+	for( q=0; q<3; q++ )
+		start[q+1] += start[q];
+	for( j=0; j<nc; j++ )
+		if( m[j] >= 0 )
+			pos[start[m[j]]++] = j;
+	for( q=3; q>0; q-- )
+		start[q] = start[q-1];
+	start[0] = 0;
+
+	/* Power series, with the elements still summed in the
+	 * lanes l < na; lane l holds the element pos[m[l]].
+	 */
+	na = start[1];
+	for( l=0; l<na; l++ )
+		{
+		xj = torch_cephes_fabs( x[(i+pos[l])*sx] );
+		z[l] = xj * xj;
+		a[l] = 1.0;
+		s[l] = 1.0;
+		c[l] = 0.0;
+		m[l] = l;
+		}
+	k = 2.0;
+	while( na > 0 )
+		{
+		t = k + 1.0;
+		for( l=0; l<na; l++ )
+			{
+			a[l] *= z[l]/k;
+			c[l] += a[l]/k;
+			a[l] /= t;
+			s[l] += a[l]/t;
+			u[l] = a[l]/s[l];
+			}
+		k = t + 1.0;
+		q = 0;
+		for( l=0; l<na; l++ )
+			{
+			if( torch_cephes_fabs(u[l]) > torch_cephes_MACHEP )
+				{
+				if( q != l )
+					{
+					z[q] = z[l];
+					a[q] = a[l];
+					s[q] = s[l];
+					c[q] = c[l];
+					m[q] = m[l];
+					}
+				q += 1;
+				}
+			else
+				{
+				/* converged */
+				shi[i+pos[m[l]]] = s[l];
+				chi[i+pos[m[l]]] = c[l];
+				}
+			}
+		na = q;
+		}
+	for( p=0; p<start[1]; p++ )
+		{
+		j = pos[p];
+		xj = torch_cephes_fabs( x[(i+j)*sx] );
+		shi[i+j] *= xj;
+		}
+
+	/* Chebyshev expansions */
+	for( p=start[1]; p<start[3]; p++ )
+		{
+		xj = torch_cephes_fabs( x[(i+pos[p])*sx] );
+		if( p < start[2] )
+			z[p] = (576.0/xj - 52.0)/10.0;
+		else
+			z[p] = (6336.0/xj - 212.0)/70.0;
+		}
+	p = start[1];
+	q = start[2];
+	if( q > p )
+		{
+		torch_cephes_chbevl_batch( q-p, &z[p], (double *) S1, 22, &s[p] );
+		torch_cephes_chbevl_batch( q-p, &z[p], (double *) C1, 23, &c[p] );
+		}
+	p = start[2];
+	q = start[3];
+	if( q > p )
+		{
+		torch_cephes_chbevl_batch( q-p, &z[p], (double *) S2, 23, &s[p] );
+		torch_cephes_chbevl_batch( q-p, &z[p], (double *) C2, 24, &c[p] );
+		}
+	for( p=start[1]; p<start[3]; p++ )
+		{
+		j = pos[p];
+		xj = torch_cephes_fabs( x[(i+j)*sx] );
+		k = torch_cephes_exp(xj) / xj;
+		shi[i+j] = k * s[p];
+		chi[i+j] = k * c[p];
+		}
+
+	for( p=0; p<start[3]; p++ )
+		{
+		j = pos[p];
+		xj = x[(i+j)*sx];
+		if( xj < 0.0 )
+			{
+			shi[i+j] = -shi[i+j];
+			xj = -xj;
+			}
+		chi[i+j] = EUL + torch_cephes_log(xj) + chi[i+j];
+		}
+	}
+}
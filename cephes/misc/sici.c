@@ -577,15 +577,22 @@ static unsigned short GD8[] = {
 
 #ifdef ANSIPROT
 extern double torch_cephes_log ( double );
+extern double torch_cephes_fabs ( double );
 extern double torch_cephes_sin ( double );
 extern double torch_cephes_cos ( double );
 extern double torch_cephes_polevl ( double, void *, int );
 extern double torch_cephes_p1evl ( double, void *, int );
+extern void torch_cephes_polevl_batch ( int, double *, double *, int,
+					double * );
+extern void torch_cephes_p1evl_batch ( int, double *, double *, int,
+				       double * );
 #else
-double torch_cephes_log(), torch_cephes_sin(), torch_cephes_cos(),
-    torch_cephes_polevl(), torch_cephes_p1evl();
+double torch_cephes_log(), torch_cephes_fabs(), torch_cephes_sin(),
+    torch_cephes_cos(), torch_cephes_polevl(), torch_cephes_p1evl();
+void torch_cephes_polevl_batch(), torch_cephes_p1evl_batch();
 #endif
 #define EUL 0.57721566490153286061
+#define CHUNK 256
 extern double torch_cephes_MAXNUM, torch_cephes_PIO2, torch_cephes_MACHEP;
 
 
@@ -678,3 +685,141 @@ if( sign )
 
 return(0);
 }
+
+
+
+/*							sici_batch()
+ *
+ *	Sine and cosine integrals of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx;
+ * double x[], si[n], ci[n];
+ *
+ * sici_batch( n, x, sx, si, ci );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets si[i] and ci[i] to the integrals Si and Ci of x[i*sx],
+ * as sici().  A stride of 0 broadcasts the first value to the
+ * whole batch.
+ *
+ * The elements of a chunk are sorted by the interval of their
+ * rational approximations, which are evaluated for all the
+ * elements of an interval at once by polevl_batch() and
+ * p1evl_batch().  The chunks are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as sici().
+ *
+ */
+
+/* Rational approximations of sici(), by interval: numerators and
+ * denominators of s and c for x <= 4, of f and g for 4 < x < 8 and
+ * for x >= 8.
+ */
+static double *SICA[3][4] = {
+	{ (double *) SN, (double *) SD, (double *) CN, (double *) CD },
+	{ (double *) FN4, (double *) FD4, (double *) GN4, (double *) GD4 },
+	{ (double *) FN8, (double *) FD8, (double *) GN8, (double *) GD8 } };
+static int SICN[3][4] = { { 5, 5, 5, 5 }, { 6, 7, 7, 7 }, { 8, 8, 8, 9 } };
+
+void torch_cephes_sici_batch( n, x, sx, si, ci )
+int n, sx;
+double *x, *si, *ci;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double z[CHUNK], v[4][CHUNK], c, f, g, s, xj;
+	int r[CHUNK], pos[CHUNK], start[4];
+	int j, p, q, nc;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	start[0] = start[1] = start[2] = start[3] = 0;
+	for( j=0; j<nc; j++ )
+		{
+		xj = torch_cephes_fabs( x[(i+j)*sx] );
+		r[j] = -1;
+		if( xj == 0.0 )
+			{
+			si[i+j] = 0.0;
+			ci[i+j] = -torch_cephes_MAXNUM;
+			}
+		else if( xj > 1.0e9 )
+			{
+			si[i+j] = torch_cephes_PIO2 - torch_cephes_cos(xj)/xj;
+			ci[i+j] = torch_cephes_sin(xj)/xj;
+			}
+		else if( xj != xj )
+			si[i+j] = ci[i+j] = xj;
+		else
+			{
+			r[j] = xj <= 4.0 ? 0 : (xj < 8.0 ? 1 : 2);
+			start[r[j]+1] += 1;
+			}
+		}
+	for( q=0; q<3; q++ )
+		start[q+1] += start[q];
+	for( j=0; j<nc; j++ )
+		if( r[j] >= 0 )
+			pos[start[r[j]]++] = j;
+	for( q=3; q>0; q-- )
+		start[q] = start[q-1];
+	start[0] = 0;
+
+	for( p=0; p<start[3]; p++ )
+		{
+		xj = torch_cephes_fabs( x[(i+pos[p])*sx] );
+		z[p] = p < start[1] ? xj * xj : 1.0/(xj*xj);
+		}
+	for( q=0; q<3; q++ )
+		{
+		p = start[q];
+		if( start[q+1] == p )
+			continue;
+		for( j=0; j<4; j++ )
+			{
+			if( q > 0 && (j & 1) )
+				torch_cephes_p1evl_batch( start[q+1] - p, &z[p],
+					SICA[q][j], SICN[q][j], &v[j][p] );
+			else
+				torch_cephes_polevl_batch( start[q+1] - p, &z[p],
+					SICA[q][j], SICN[q][j], &v[j][p] );
+			}
+		}
+
+	for( p=0; p<start[3]; p++ )
+		{
+		j = pos[p];
+		xj = torch_cephes_fabs( x[(i+j)*sx] );
+		if( p < start[1] )
+			{
+			s = xj * v[0][p] / v[1][p];
+			c = z[p] * v[2][p] / v[3][p];
+			si[i+j] = s;
+			ci[i+j] = EUL + torch_cephes_log(xj) + c;
+			}
+		else
+			{
+			s = torch_cephes_sin(xj);
+			c = torch_cephes_cos(xj);
+			f = v[0][p] / (xj * v[1][p]);
+			g = z[p] * v[2][p] / v[3][p];
+			si[i+j] = torch_cephes_PIO2 - f * c - g * s;
+			ci[i+j] = f * s - g * c;
+			}
+		if( x[(i+j)*sx] < 0.0 )
+			si[i+j] = -si[i+j];
+		}
+	}
+}
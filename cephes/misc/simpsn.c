@@ -4,6 +4,8 @@
  * at equally spaced arguments
  */
 
+#include "mconf.h"
+
 /* Coefficients for Cote integration formulas */
 
 /* Note: these numbers were computed using 40-decimal precision. */
@@ -79,3 +81,232 @@ for( i=0; i < NCOTE/2; i++ )
 
 return( ans * delta * NCOTE );
 }
+
+
+
+/*							simpsn_batch
+ *
+ *	Composite Cotes integration of batches of tabulated functions
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, m, sd, cum;
+ * double f[n*m], delta[], y[];
+ *
+ * simpsn_batch( n, m, f, delta, sd, cum, y );
+ *
+ * int k;
+ * double a, b, x[k], w[k];
+ *
+ * gauleg( k, a, b, x, w );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * simpsn_batch() integrates each of n functions tabulated at m
+ * equally spaced arguments, the samples of function i being
+ * f[i*m] ... f[i*m+m-1] and their spacing delta[i*sd]; sd = 0
+ * gives them all the spacing delta[0].
+ *
+ * The samples are covered by panels of NCOTE+1 of them, as many as
+ * fit, each integrated by the rule of simpsn().  The last
+ * (m-1) mod NCOTE intervals are integrated with the polynomial
+ * through the last NCOTE+1 samples, so that the order of the rule
+ * is kept up to the end.  With fewer than NCOTE+1 samples, the
+ * polynomial through all of them is integrated, the Newton-Cotes
+ * rule of m points.
+ *
+ * If cum is 0, y[i] is the integral of function i over its m
+ * samples.  If cum is 1, y[i*m+j] is the integral from the first
+ * sample to sample j, the polynomial of each panel giving the
+ * integrals up to its interior samples.
+ *
+ * gauleg() sets x and w to the k nodes and weights of the Gauss-
+ * Legendre rule on [a, b]: the integral of f over [a, b] is then
+ * approximately the sum of w[i] f(x[i]), exactly for polynomials
+ * of degree 2k-1.  The nodes are the roots of the Legendre
+ * polynomial of degree k, refined by Newton's method from
+ * asymptotic approximations.
+ *
+ * The functions of a batch are distributed among threads.
+ *
+ */
+
+#ifdef ANSIPROT
+extern double torch_cephes_cos ( double );
+extern double torch_cephes_fabs ( double );
+void torch_cephes_simpsn_batch ( int, int, double *, double *, int, int,
+	double * );
+void torch_cephes_gauleg ( int, double, double, double *, double * );
+static void cotes ( int, double, double, double * );
+#else
+double torch_cephes_cos(), torch_cephes_fabs();
+void torch_cephes_simpsn_batch(), torch_cephes_gauleg();
+static void cotes();
+#endif
+extern double torch_cephes_PI, torch_cephes_MACHEP;
+
+/* w[i] = integral from lo to hi of the Lagrange polynomial of the
+ * node i of the nodes 0, 1, ..., p-1, p <= NCOTE+1, by the Gauss
+ * rule of (p+1)/2 points, exact for it; the product form of the
+ * polynomial avoids the cancellation of its expanded coefficients.
+ */
+static void cotes( p, lo, hi, w )
+int p;
+double lo, hi;
+double *w;
+{
+double gx[NCOTE+1], gw[NCOTE+1], s, t;
+int g, i, j, k;
+
+k = (p + 1) / 2;
+torch_cephes_gauleg( k, lo, hi, gx, gw );
+for( i=0; i<p; i++ )
+	{
+	s = 0.0;
+	for( g=0; g<k; g++ )
+		{
+		t = gw[g];
+		for( j=0; j<p; j++ )
+			if( j != i )
+				t *= (gx[g] - j) / (i - j);
+		s += t;
+		}
+	w[i] = s;
+	}
+}
+
+
+
+void torch_cephes_simpsn_batch( n, m, f, delta, sd, cum, y )
+int n, m, sd, cum;
+double *f, *delta, *y;
+{
+double pw[NCOTE][NCOTE+1], ew[NCOTE][NCOTE+1];
+int i, p, r, s;
+
+/* panels of p samples, and the weights of the r last intervals
+ * with the window of the last p samples */
+p = m < NCOTE + 1 ? m : NCOTE + 1;
+r = m < NCOTE + 1 ? 0 : (m - 1) % NCOTE;
+for( s=1; s<p; s++ )
+	cotes( p, 0.0, (double) s, pw[s-1] );
+for( s=1; s<=r; s++ )
+	cotes( p, (double) (NCOTE - r), (double) (NCOTE - r + s), ew[s-1] );
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i++ )
+	{
+	double acc[NCOTE+1], *g, *h, base, t, dx;
+	int j, k, l, q;
+
+	g = f + (long) i * m;
+	dx = delta[(long) i * sd];
+	base = 0.0;
+	for( l=0; l<=NCOTE; l++ )
+		acc[l] = 0.0;
+	h = cum ? y + (long) i * m : (double *) 0;
+	if( cum && m > 0 )
+		h[0] = 0.0;
+	/* whole panels */
+	q = p > 1 ? (m - 1) / (p - 1) : 0;
+	for( k=0; k<q; k++ )
+		{
+		if( cum )
+			{
+			for( j=1; j<p; j++ )
+				{
+				t = 0.0;
+				for( l=0; l<p; l++ )
+					t += pw[j-1][l] * g[l];
+				h[k*(p-1)+j] = base + t * dx;
+				}
+			base = h[k*(p-1)+p-1];
+			}
+		else if( p == NCOTE + 1 )
+			{
+			/* the samples of each position in the panels, weighted
+			 * after the loop */
+			for( l=0; l<=NCOTE; l++ )
+				acc[l] += g[l];
+			}
+		else
+			{
+			t = 0.0;
+			for( l=0; l<p; l++ )
+				t += pw[p-2][l] * g[l];
+			base += t;
+			}
+		g += p - 1;
+		}
+	if( !cum && p == NCOTE + 1 )
+		for( l=0; l<=NCOTE; l++ )
+			base += pw[NCOTE-1][l] * acc[l];
+	/* the last intervals */
+	if( r > 0 )
+		{
+		g = f + (long) i * m + m - p;
+		if( cum )
+			{
+			for( j=1; j<=r; j++ )
+				{
+				t = 0.0;
+				for( l=0; l<p; l++ )
+					t += ew[j-1][l] * g[l];
+				h[m-1-r+j] = base + t * dx;
+				}
+			}
+		else
+			{
+			t = 0.0;
+			for( l=0; l<p; l++ )
+				t += ew[r-1][l] * g[l];
+			base += t;
+			}
+		}
+	if( !cum )
+		y[i] = base * dx;
+	}
+}
+
+
+
+void torch_cephes_gauleg( k, a, b, x, w )
+int k;
+double a, b;
+double *x, *w;
+{
+double z, z1, p1, p2, p3, pp, xm, xl;
+int i, j, it;
+
+xm = 0.5 * (b + a);
+xl = 0.5 * (b - a);
+for( i=0; i<(k+1)/2; i++ )
+	{
+	z = torch_cephes_cos( torch_cephes_PI * (i + 0.75) / (k + 0.5) );
+	for( it=0; it<100; it++ )
+		{
+		/* P_k(z) by the recurrence, and its derivative */
+		p1 = 1.0;
+		p2 = 0.0;
+		for( j=0; j<k; j++ )
+			{
+			p3 = p2;
+			p2 = p1;
+			p1 = ((2.0 * j + 1.0) * z * p2 - j * p3) / (j + 1);
+			}
+		pp = k * (z * p1 - p2) / (z * z - 1.0);
+		z1 = z;
+		z = z1 - p1 / pp;
+		if( torch_cephes_fabs( z - z1 ) <= 4.0 * torch_cephes_MACHEP )
+			break;
+		}
+	x[i] = xm - xl * z;
+	x[k-1-i] = xm + xl * z;
+	w[i] = 2.0 * xl / ((1.0 - z * z) * pp * pp);
+	w[k-1-i] = w[i];
+	}
+}
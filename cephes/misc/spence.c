@@ -148,6 +148,8 @@ double torch_cephes_fabs(), torch_cephes_log(), torch_cephes_polevl();
 #endif
 extern double torch_cephes_PI, torch_cephes_MACHEP;
 
+#define CHUNK 256
+
 double torch_cephes_spence(x)
 double x;
 {
@@ -204,3 +206,127 @@ if( flag & 2 )
 
 return( y );
 }
+
+
+
+
+/*							spence_batch()
+ *
+ *	Dilogarithm of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx;
+ * double x[], y[n];
+ *
+ * spence_batch( n, x, sx, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Sets y[i] to spence( x[i*sx] ).  A stride of 0 broadcasts the
+ * first value to the whole batch.
+ *
+ * The elements of a chunk are first reduced to the interval of
+ * the rational approximation, which is then evaluated for all of
+ * them in one loop, before the transformations of 1/x and 1-x are
+ * undone.  The chunks are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * The same values as spence().
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As spence().
+ *
+ */
+
+void torch_cephes_spence_batch( n, x, sx, y )
+int n, sx;
+double *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double u[CHUNK], w[CHUNK], *a, *b, p, q, z;
+	int flag[CHUNK];
+	int j, k, nc;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	for( j=0; j<nc; j++ )
+		{
+		u[j] = x[(i+j)*sx];
+		flag[j] = 0;
+		if( u[j] < 0.0 )
+			{
+			torch_cephes_mtherr( "spence", DOMAIN );
+			flag[j] = -1;
+			w[j] = 0.0;
+			continue;
+			}
+		if( u[j] == 1.0 || u[j] == 0.0 )
+			{
+			flag[j] = -1;
+			w[j] = u[j] == 0.0 ? torch_cephes_PI*torch_cephes_PI/6.0 : 0.0;
+			continue;
+			}
+		if( u[j] > 2.0 )
+			{
+			u[j] = 1.0/u[j];
+			flag[j] |= 2;
+			}
+		if( u[j] > 1.5 )
+			{
+			w[j] = (1.0/u[j]) - 1.0;
+			flag[j] |= 2;
+			}
+		else if( u[j] < 0.5 )
+			{
+			w[j] = -u[j];
+			flag[j] |= 1;
+			}
+		else
+			w[j] = u[j] - 1.0;
+		}
+
+	/* The rational approximation, as polevl() */
+	a = (double *) A;
+	b = (double *) B;
+	for( j=0; j<nc; j++ )
+		{
+		p = a[0];
+		q = b[0];
+		for( k=1; k<8; k++ )
+			{
+			p = p * w[j] + a[k];
+			q = q * w[j] + b[k];
+			}
+		y[i+j] = -w[j] * p / q;
+		}
+
+	for( j=0; j<nc; j++ )
+		{
+		if( flag[j] < 0 )
+			{
+			y[i+j] = w[j];
+			continue;
+			}
+		if( flag[j] & 1 )
+			y[i+j] = (torch_cephes_PI * torch_cephes_PI)/6.0
+				- torch_cephes_log(u[j]) * torch_cephes_log(1.0-u[j]) - y[i+j];
+		if( flag[j] & 2 )
+			{
+			z = torch_cephes_log(u[j]);
+			y[i+j] = -0.5 * z * z  -  y[i+j];
+			}
+		}
+	}
+}
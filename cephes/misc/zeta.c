@@ -64,11 +64,30 @@ Copyright 1984, 1987, 2000 by Stephen L. Moshier
 extern double torch_cephes_fabs ( double );
 extern double torch_cephes_pow ( double, double );
 extern double torch_cephes_floor ( double );
+extern double torch_cephes_gamma ( double );
+extern double torch_cephes_psi ( double );
+extern double torch_cephes_frexp ( double, int * );
+extern double torch_cephes_ldexp ( double, int );
+static int zetadom ( double, double, double * );
+static void zetacoef ( double, double * );
+static double ipow ( double, int );
+static double ipowm ( double, int, int * );
+static double zetasum ( double, double, int, double *, int * );
+static double polygam ( int, double, int *, double *, double * );
+double torch_cephes_polygamma ( int, double );
 #else
 double torch_cephes_fabs(), torch_cephes_pow(), torch_cephes_floor();
+double torch_cephes_gamma(), torch_cephes_psi();
+double torch_cephes_frexp(), torch_cephes_ldexp();
+static int zetadom();
+static void zetacoef();
+static double ipow(), ipowm(), zetasum(), polygam();
+double torch_cephes_polygamma();
 #endif
 extern double torch_cephes_MAXNUM, torch_cephes_MACHEP;
 
+#define CHUNK 256
+
 /* Expansion coefficients
  * for Euler-Maclaurin summation formula
  * (2k)! / B2k
@@ -187,3 +206,369 @@ s = (s + b)/(1.0-b);
 return(s);
 */
 }
+
+
+
+/*							zeta_batch()
+ *
+ *	Hurwitz zeta, polygamma and trigamma functions of a vector
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int n, sx, sq, sm, k;
+ * double x[], q[], m[], y[n], z, v;
+ *
+ * v = polygamma( k, z );
+ * v = trigamma( z );
+ *
+ * zeta_batch( n, x, sx, q, sq, y );
+ * polygamma_batch( n, m, sm, x, sx, y );
+ * trigamma_batch( n, x, sx, y );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * zeta_batch() sets y[i] to zeta( x[i*sx], q[i*sq] ).  A stride
+ * of 0 broadcasts the first value to the whole batch.
+ *
+ * polygamma( k, x ) is the derivative of order k of psi at x,
+ * and polygamma_batch() sets y[i] to polygamma( m[i*sm], x[i*sx] ),
+ * m being truncated to an integer:
+ *
+ *    (m)            m+1
+ *   psi   (x)  = (-1)    m!  zeta( m+1, x ),     m >= 1,
+ *
+ * and psi(x) for m = 0.  trigamma() and trigamma_batch() are those
+ * of order 1.
+ *
+ * The series is the Euler-Maclaurin expansion of zeta().  The
+ * coefficients x(x+1)...(x+2j) / ((2j)!/B2j) of its tail depend
+ * only on the exponent x, and are computed once for each run of
+ * elements with the same exponent.  For polygamma the exponent is
+ * an integer, and the leading terms of the sum, which shift the
+ * argument up to the range of the expansion by the recurrence
+ *
+ *    (m)          (m)          m+1      -m-1
+ *   psi   (x) = psi   (x+1) - (-1)   m! x    ,
+ *
+ * use integer powers instead of pow().
+ *
+ * The chunks of the batch are evaluated in parallel.
+ *
+ *
+ * ACCURACY:
+ *
+ * Within a few units in the last place of zeta(), and of the
+ * scalar expression of polygamma above.
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * As zeta(), and
+ *   message         condition      value returned
+ * polygamma domain   m < 0              0.0
+ *
+ */
+
+/* The cases of zeta( x, q ) that do not use the expansion:
+ * returns 1 and sets *y if x, q are one of them.
+ */
+static int zetadom( x, q, y )
+double x, q;
+double *y;
+{
+
+if( x == 1.0 )
+	{
+	*y = torch_cephes_MAXNUM;
+	return( 1 );
+	}
+if( x < 1.0 )
+	{
+	torch_cephes_mtherr( "zeta", DOMAIN );
+	*y = 0.0;
+	return( 1 );
+	}
+if( q <= 0.0 )
+	{
+	if( q == torch_cephes_floor(q) )
+		{
+		torch_cephes_mtherr( "zeta", SING );
+		*y = torch_cephes_MAXNUM;
+		return( 1 );
+		}
+	if( x != torch_cephes_floor(x) )
+		{
+		torch_cephes_mtherr( "zeta", DOMAIN );
+		*y = 0.0;
+		return( 1 );
+		}
+	}
+return( 0 );
+}
+
+
+/* Coefficients of the tail of the expansion for exponent x */
+static void zetacoef( x, c )
+double x;
+double *c;
+{
+double a, k;
+int i;
+
+a = 1.0;
+k = 0.0;
+for( i=0; i<12; i++ )
+	{
+	a *= x + k;
+	c[i] = a / A[i];
+	k += 1.0;
+	a *= x + k;
+	k += 1.0;
+	}
+}
+
+
+/* a**n, n > 0, by repeated squaring */
+static double ipow( a, n )
+double a;
+int n;
+{
+double p;
+
+p = 1.0;
+for( ; n>0; n>>=1 )
+	{
+	if( n & 1 )
+		p *= a;
+	a *= a;
+	}
+return( p );
+}
+
+
+/* a**-n = m * 2**e, n > 0, returning m and setting *pe to e: the
+ * powers of the mantissa of a are renormalized as they are squared,
+ * so that neither a**n nor a**-n need be representable.
+ */
+static double ipowm( a, n, pe )
+double a;
+int n;
+int *pe;
+{
+double p, r;
+int e, ep, er;
+
+r = torch_cephes_frexp( a, &er );
+p = 1.0;
+ep = 0;
+for( ; n>0; n>>=1 )
+	{
+	if( n & 1 )
+		{
+		p = torch_cephes_frexp( p * r, &e );
+		ep += e + er;
+		}
+	r = torch_cephes_frexp( r * r, &e );
+	er = 2 * er + e;
+	}
+*pe = -ep;
+return( 1.0 / p );
+}
+
+
+/* Euler-Maclaurin sum for zeta( x, q ), given the coefficients c[]
+ * of exponent x.  If ix > 0, x is the integer ix.  The sum is the
+ * result times 2**(*pe): *pe is 0 unless ix > 0 and the powers of
+ * the terms would overflow or underflow, in which case they are
+ * scaled by the first one.
+ */
+static double zetasum( x, q, ix, c, pe )
+double x, q;
+int ix;
+double *c;
+int *pe;
+{
+double a, b, s, t, w;
+int i, e, scaled;
+
+*pe = 0;
+scaled = 0;
+if( ix > 0 )
+	{
+	/* the terms run from q**-ix to about (q+10)**-ix */
+	s = ipow( q, ix );
+	b = ipow( (q > 1.0 ? q : 1.0) + 10.0, ix );
+	scaled = !(s > 1.0e-300 && b < 1.0e300) && ix <= 1024;
+	if( scaled )
+		s = ipowm( q, ix, pe );
+	else
+		s = 1.0 / s;
+	}
+else
+	s = torch_cephes_pow( q, -x );
+a = q;
+i = 0;
+b = 0.0;
+while( (i < 9) || (a <= 9.0) )
+	{
+	i += 1;
+	a += 1.0;
+	if( scaled )
+		{
+		b = ipowm( a, ix, &e );
+		b = torch_cephes_ldexp( b, e - *pe );
+		}
+	else if( ix > 0 )
+		b = 1.0 / ipow( a, ix );
+	else
+		b = torch_cephes_pow( a, -x );
+	s += b;
+	if( torch_cephes_fabs(b/s) < torch_cephes_MACHEP )
+		return( s );
+	}
+
+w = a;
+s += b*w/(x-1.0);
+s -= 0.5 * b;
+for( i=0; i<12; i++ )
+	{
+	b /= w;
+	t = c[i] * b;
+	s = s + t;
+	if( torch_cephes_fabs(t/s) < torch_cephes_MACHEP )
+		break;
+	b /= w;
+	}
+return( s );
+}
+
+
+
+void torch_cephes_zeta_batch( n, x, sx, q, sq, y )
+int n, sx, sq;
+double *x, *q, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double c[12], xj, cx;
+	int j, nc, e;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	cx = 0.0;
+	for( j=0; j<nc; j++ )
+		{
+		xj = x[(i+j)*sx];
+		if( zetadom( xj, q[(i+j)*sq], &y[i+j] ) )
+			continue;
+		if( xj != cx )
+			{
+			zetacoef( xj, c );
+			cx = xj;
+			}
+		y[i+j] = zetasum( xj, q[(i+j)*sq], 0, c, &e );
+		}
+	}
+}
+
+
+
+/* polygamma( m, x ), where *cm, *f and c[] hold the order, the factor
+ * (-1)**(m+1) m! and the coefficients of exponent m+1 of the previous
+ * call, if *cm > 0.
+ */
+static double polygam( m, x, cm, f, c )
+int m;
+double x;
+int *cm;
+double *f, *c;
+{
+double z, f0;
+int e, e0;
+
+if( m < 0 )
+	{
+	torch_cephes_mtherr( "polygamma", DOMAIN );
+	return( 0.0 );
+	}
+if( m == 0 )
+	return( torch_cephes_psi( x ) );
+if( m != *cm )
+	{
+	*f = torch_cephes_gamma( (double) (m + 1) );
+	if( (m & 1) == 0 )
+		*f = -*f;
+	zetacoef( (double) (m + 1), c );
+	*cm = m;
+	}
+if( zetadom( (double) (m + 1), x, &z ) )
+	return( *f * z );
+z = zetasum( (double) (m + 1), x, m + 1, c, &e );
+if( e == 0 )
+	return( *f * z );
+/* f z 2**e, rounded once at the end */
+f0 = torch_cephes_frexp( *f, &e0 );
+return( torch_cephes_ldexp( f0 * z, e0 + e ) );
+}
+
+
+
+double torch_cephes_polygamma( m, x )
+int m;
+double x;
+{
+double c[12], f;
+int cm;
+
+cm = 0;
+return( polygam( m, x, &cm, &f, c ) );
+}
+
+
+
+double torch_cephes_trigamma( x )
+double x;
+{
+
+return( torch_cephes_polygamma( 1, x ) );
+}
+
+
+
+void torch_cephes_polygamma_batch( n, m, sm, x, sx, y )
+int n, sm, sx;
+double *m, *x, *y;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double c[12], f;
+	int j, nc, cm;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	cm = 0;
+	f = 0.0;
+	for( j=0; j<nc; j++ )
+		y[i+j] = polygam( (int) m[(i+j)*sm], x[(i+j)*sx], &cm, &f, c );
+	}
+}
+
+
+
+void torch_cephes_trigamma_batch( n, x, sx, y )
+int n, sx;
+double *x, *y;
+{
+double one;
+
+one = 1.0;
+torch_cephes_polygamma_batch( n, &one, 0, x, sx, y );
+}
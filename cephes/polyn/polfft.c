@@ -0,0 +1,443 @@
+/*							polfft.c
+ *
+ *	Fast multiplication and division of polynomials
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * double a[na+1], b[nb+1], c[nc+1];
+ * int na, nb, nc;
+ *
+ * polfmul( a, na, b, nb, c, nc );	c = b * a, up to degree nc
+ * polfrcp( a, na, c, nc );		c = 1 / a, up to degree nc
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * polfmul() sets c[0] ... c[nc] to the coefficients of the product
+ * of the polynomials a and b of degrees na and nb, truncated to
+ * degree nc, with zeros above degree na + nb.  The product is the
+ * cyclic convolution of a and b padded to a power of 2 at least
+ * na + nb + 1, computed by one complex fast Fourier transform of
+ * a + i b and one inverse transform, in O((na+nb) log(na+nb))
+ * operations.  Factors with fewer than POLFFT coefficients are
+ * multiplied by the direct O(na nb) loop instead, and so are those
+ * the transform would not reproduce accurately (see ACCURACY).
+ *
+ * polfrcp() sets c[0] ... c[nc] to the coefficients of the power
+ * series of 1/a(x), which requires a[0] != 0.  Newton's iteration
+ *
+ *   r <- r (2 - a r)
+ *
+ * doubles the number of correct coefficients of r at each step, so
+ * that the reciprocal costs a few multiplications of degree nc.
+ *
+ * polmul() of polyn.c calls polfmul() when both factors have at
+ * least POLFFT coefficients, 256 by default, and poldiv() calls
+ * polfrcp() when MAXPOL + 1 is at least 4 POLFFT, about where the
+ * transforms overtake the direct loops; set POLFFT to a larger
+ * value to keep the direct loops.  Any of a, b, c may refer to the
+ * same array.
+ *
+ *
+ * ACCURACY:
+ *
+ * The transform spreads rounding errors evenly over the
+ * coefficients of the product: the error of each is about
+ * MACHEP log2(na+nb) times the largest |a[i]| times the largest
+ * |b[j]|, instead of a bound on the terms of its own sum.  To
+ * keep small coefficients accurate, polfmul() substitutes 2^-g x
+ * for x in the factors before the transform and 2^g x in the
+ * product after it, g the slope of the least squares line through
+ * the points (k, log2 |coefficient of x^k|) of both factors, if
+ * the points are within a few orders of the line and the two
+ * factors have about the same slope.  This balances
+ * the coefficients of series that grow or decrease geometrically,
+ * such as reciprocals.  Factors whose coefficients are further
+ * from the line, like those of exp(x) that decrease faster, go to
+ * the direct loop.
+ *
+ *
+ * ERROR MESSAGES:
+ *
+ * polfrcp() calls mtherr( "polfrcp", SING ) and returns zeros
+ * if a[0] is 0.
+ *
+ */
+
+/*
+Cephes Math Library Release 2.8:  June, 2000
+Copyright 1984, 1987, 2000 by Stephen L. Moshier
+*/
+
+#include "mconf.h"
+#if ANSIPROT
+extern void * malloc ( unsigned long );
+extern void * realloc ( void *, unsigned long );
+extern void free ( void * );
+extern double torch_cephes_cos ( double );
+extern double torch_cephes_sin ( double );
+extern double torch_cephes_exp ( double );
+extern double torch_cephes_frexp ( double, int * );
+extern double torch_cephes_ldexp ( double, int );
+extern double torch_cephes_floor ( double );
+extern int torch_cephes_mtherr ( char *, int );
+void torch_cephes_polfmul ( double *, int, double *, int, double *, int );
+void torch_cephes_polfrcp ( double *, int, double *, int );
+static void twiddles ( int );
+static void fft ( double *, int, int );
+static double slope ( double *, int, int *, double * );
+static void scale ( double *, int, int, double );
+static int magnitude ( double *, int );
+#else
+void * malloc();
+void * realloc();
+void free ();
+double torch_cephes_cos(), torch_cephes_sin(), torch_cephes_exp();
+double torch_cephes_frexp(), torch_cephes_ldexp(), torch_cephes_floor();
+int torch_cephes_mtherr();
+void torch_cephes_polfmul(), torch_cephes_polfrcp();
+static void twiddles(), fft(), scale();
+static double slope();
+static int magnitude();
+#endif
+extern double torch_cephes_PI, torch_cephes_LOGE2;
+
+/* Smallest number of coefficients of both factors for which
+ * polmul(), poldiv() and polfmul() use the transform.
+ */
+int torch_cephes_POLFFT = 256;
+
+/* exp(2 pi i k / ntw), k < ntw/2, real and imaginary parts
+ * interleaved; kept from one call to the next, like the
+ * temporary arrays of polyn.c.
+ */
+static double *tw = 0;
+static int ntw = 0;
+
+
+/* Fill the table of twiddle factors for transforms of length n,
+ * and all the shorter ones.
+ */
+static void twiddles( n )
+int n;
+{
+double t;
+int k;
+
+if( n <= ntw )
+	return;
+tw = (double *) realloc( tw, n * sizeof(double) );
+ntw = n;
+for( k=0; k<n/2; k++ )
+	{
+	t = 2.0 * torch_cephes_PI * k / n;
+	tw[2*k] = torch_cephes_cos( t );
+	tw[2*k+1] = torch_cephes_sin( t );
+	}
+}
+
+
+/* In place transform of the n complex numbers x[2k] + i x[2k+1],
+ * n a power of 2, of sign -1 for the forward transform and +1 for
+ * the inverse one, not scaled.
+ */
+static void fft( x, n, sign )
+double *x;
+int n, sign;
+{
+double t, ur, ui, wr, wi;
+double *p, *q;
+int i, j, k, len, half, step;
+
+/* bit reversed order */
+j = 0;
+for( i=0; i<n-1; i++ )
+	{
+	if( i < j )
+		{
+		t = x[2*i];
+		x[2*i] = x[2*j];
+		x[2*j] = t;
+		t = x[2*i+1];
+		x[2*i+1] = x[2*j+1];
+		x[2*j+1] = t;
+		}
+	k = n >> 1;
+	while( k <= j )
+		{
+		j -= k;
+		k >>= 1;
+		}
+	j += k;
+	}
+
+for( len=2; len<=n; len<<=1 )
+	{
+	half = len >> 1;
+	step = ntw / len;
+	for( i=0; i<n; i+=len )
+		{
+		p = x + 2*i;
+		q = p + 2*half;
+		for( k=0; k<half; k++ )
+			{
+			wr = tw[2*k*step];
+			wi = sign * tw[2*k*step+1];
+			ur = q[2*k] * wr - q[2*k+1] * wi;
+			ui = q[2*k] * wi + q[2*k+1] * wr;
+			q[2*k] = p[2*k] - ur;
+			q[2*k+1] = p[2*k+1] - ui;
+			p[2*k] += ur;
+			p[2*k+1] += ui;
+			}
+		}
+	}
+}
+
+
+
+/* Slope of the least squares line through the points (k, log2 |a[k]|)
+ * of the nonzero coefficients, with the binary exponents for the
+ * logarithms; *w receives the number of points, and *r the mean
+ * square distance of the points to the line.
+ */
+static double slope( a, n, w, r )
+double *a;
+int n;
+int *w;
+double *r;
+{
+double sk, sy, skk, sky, syy, d, g;
+int k, e, m;
+
+sk = 0.0;
+sy = 0.0;
+skk = 0.0;
+sky = 0.0;
+syy = 0.0;
+m = 0;
+for( k=0; k<=n; k++ )
+	{
+	if( a[k] == 0.0 )
+		continue;
+	torch_cephes_frexp( a[k], &e );
+	sk += k;
+	sy += e;
+	skk += (double) k * k;
+	sky += (double) k * e;
+	syy += (double) e * e;
+	m += 1;
+	}
+*w = m;
+*r = 0.0;
+d = m * skk - sk * sk;
+if( m < 2 || d == 0.0 )
+	return( 0.0 );
+g = (m * sky - sk * sy) / d;
+*r = (syy - sy * sy / m - g * g * d / m) / m;
+return( g );
+}
+
+
+/* x[k*s] *= 2^(g k), k = 0 ... n, by a product refreshed every
+ * 32 steps, or at each one for steep slopes, and with the integer
+ * part of the exponent applied by ldexp() so that the factor does
+ * not overflow where the scaled coefficient does not.
+ */
+static void scale( x, s, n, g )
+double *x;
+int s, n;
+double g;
+{
+double q, t, u;
+int e, k;
+
+q = torch_cephes_exp( g * torch_cephes_LOGE2 );
+u = 1.0;
+e = 0;
+for( k=0; k<=n; k++ )
+	{
+	if( (k & 31) == 0 || g > 16.0 || g < -16.0 )
+		{
+		t = g * k;
+		e = (int) torch_cephes_floor( t );
+		u = torch_cephes_exp( (t - e) * torch_cephes_LOGE2 );
+		}
+	x[k*s] = torch_cephes_ldexp( x[k*s] * u, e );
+	u *= q;
+	}
+}
+
+
+
+/* Divide x[2k], k = 0 ... n, by the power of 2 of their largest
+ * magnitude, and return its exponent.
+ */
+static int magnitude( x, n )
+double *x;
+int n;
+{
+double m;
+int e, k;
+
+m = 0.0;
+for( k=0; k<=n; k++ )
+	{
+	if( x[2*k] > m )
+		m = x[2*k];
+	else if( -x[2*k] > m )
+		m = -x[2*k];
+	}
+if( m == 0.0 )
+	return( 0 );
+torch_cephes_frexp( m, &e );
+for( k=0; k<=n; k++ )
+	x[2*k] = torch_cephes_ldexp( x[2*k], -e );
+return( e );
+}
+
+
+
+void torch_cephes_polfmul( a, na, b, nb, c, nc )
+double a[], b[], c[];
+int na, nb, nc;
+{
+double *z, ar, ai, br, bi, xr, xi, g;
+int i, j, k, n, np, ea, eb, direct;
+
+if( na > nc )
+	na = nc;
+if( nb > nc )
+	nb = nc;
+np = na + nb < nc ? na + nb : nc;
+
+/* mean growth of the coefficients, in binary orders per degree;
+ * the product is scaled by it if that amounts to 8 orders or more.
+ * If a and b grow apart, no scaling balances both of them, and
+ * the product is left to the direct sum. */
+g = 0.0;
+direct = na + 1 < torch_cephes_POLFFT || nb + 1 < torch_cephes_POLFFT;
+if( !direct )
+	{
+	ar = slope( a, na, &i, &ai );
+	br = slope( b, nb, &j, &bi );
+	g = i + j > 0 ? (ar * i + br * j) / (i + j) : 0.0;
+	xr = (ar - br) * (na + nb);
+	if( g * (na + nb) < 8.0 && g * (na + nb) > -8.0 )
+		g = 0.0;
+	/* slopes that differ, or coefficients too far from geometric,
+	 * for the transform to keep the small ones */
+	if( xr >= 8.0 || xr <= -8.0 || ai > 16.0 || bi > 16.0 )
+		direct = 1;
+	}
+
+if( direct )
+	{
+	z = (double *) malloc( (np + 1) * sizeof(double) );
+	for( k=0; k<=np; k++ )
+		z[k] = 0.0;
+	for( i=0; i<=na; i++ )
+		{
+		xr = a[i];
+		for( j=0; j<=nb && i+j<=np; j++ )
+			z[i+j] += xr * b[j];
+		}
+	for( k=0; k<=np; k++ )
+		c[k] = z[k];
+	goto done;
+	}
+
+n = 1;
+while( n < na + nb + 1 )
+	n <<= 1;
+twiddles( n );
+z = (double *) malloc( 2 * n * sizeof(double) );
+for( k=0; k<n; k++ )
+	{
+	z[2*k] = k <= na ? a[k] : 0.0;
+	z[2*k+1] = k <= nb ? b[k] : 0.0;
+	}
+if( g != 0.0 )
+	{
+	scale( z, 2, na, -g );
+	scale( z + 1, 2, nb, -g );
+	}
+/* a and b of the same magnitude, for neither to drown the other
+ * in the common transform */
+ea = magnitude( z, na );
+eb = magnitude( z + 1, nb );
+fft( z, n, -1 );
+
+/* The transforms of a and b are the even and odd parts of that of
+ * a + i b: A = (Z[k] + conj Z[n-k])/2, B = (Z[k] - conj Z[n-k])/2i.
+ * Each pair k, n-k is replaced by the transform of the product.
+ */
+for( k=0; k<=n/2; k++ )
+	{
+	j = (n - k) & (n - 1);
+	ar = 0.5 * (z[2*k] + z[2*j]);
+	ai = 0.5 * (z[2*k+1] - z[2*j+1]);
+	br = 0.5 * (z[2*k+1] + z[2*j+1]);
+	bi = -0.5 * (z[2*k] - z[2*j]);
+	xr = ar * br - ai * bi;
+	xi = ar * bi + ai * br;
+	/* at n-k, A and B are the conjugates */
+	z[2*k] = xr;
+	z[2*k+1] = xi;
+	z[2*j] = xr;
+	z[2*j+1] = -xi;
+	}
+fft( z, n, 1 );
+for( k=0; k<=np; k++ )
+	c[k] = torch_cephes_ldexp( z[2*k] / n, ea + eb );
+if( g != 0.0 )
+	scale( c, 1, np, g );
+
+done:
+for( k=np+1; k<=nc; k++ )
+	c[k] = 0.0;
+free( z );
+}
+
+
+
+void torch_cephes_polfrcp( a, na, c, nc )
+double a[], c[];
+int na, nc;
+{
+double *r, *t;
+int k, m, m2, ne;
+
+if( a[0] == 0.0 )
+	{
+	torch_cephes_mtherr( "polfrcp", SING );
+	for( k=0; k<=nc; k++ )
+		c[k] = 0.0;
+	return;
+	}
+
+r = (double *) malloc( (nc + 1) * sizeof(double) );
+t = (double *) malloc( (nc + 1) * sizeof(double) );
+r[0] = 1.0 / a[0];
+m = 1;
+while( m <= nc )
+	{
+	/* r has m correct coefficients; now 2m of them, or nc + 1.
+	 * 1 - a r = x^m e(x), e of degree na - 1 at most, and
+	 * r (1 + x^m e) adds the next ones. */
+	m2 = 2 * m < nc + 1 ? 2 * m : nc + 1;
+	ne = na - 1 < m2 - m - 1 ? na - 1 : m2 - m - 1;
+	torch_cephes_polfmul( a, na < m2 - 1 ? na : m2 - 1, r, m - 1, t, m2 - 1 );
+	for( k=m; k<=m+ne; k++ )
+		t[k] = -t[k];
+	torch_cephes_polfmul( r, m2 - m - 1, t + m, ne, r + m, m2 - m - 1 );
+	m = m2;
+	}
+for( k=0; k<=nc; k++ )
+	c[k] = r[k];
+free( t );
+free( r );
+}
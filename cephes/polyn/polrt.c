@@ -18,6 +18,9 @@
  *
  * polrt( xcof, cof, m, root )
  *
+ * int n, status[n];
+ * polrt_batch( n, m, xcof, root, status );
+ *
  *
  *
  * DESCRIPTION:
@@ -39,6 +42,31 @@
  * accuracy after the first root in the neighborhood has been
  * found.
  *
+ *
+ * BATCH:
+ *
+ * polrt_batch() finds the m roots of each of n polynomials of
+ * degree m: the coefficients of polynomial b are
+ * xcof[b*(m+1)] ... xcof[b*(m+1)+m], in ascending order, and its
+ * roots go to root[b*m] ... root[b*m+m-1].  status[b] is 0 when
+ * all the roots converged, 3 when some did not in 500
+ * iterations or are not finite, and, as for polrt(), 1 if m <= 0, 2 if m > 36 and
+ * 4 if the leading coefficient is 0; the roots are then 0.  A
+ * polynomial with a NaN or infinite coefficient has status 3
+ * and NaN roots.
+ *
+ * The roots are refined all at once by the Aberth-Ehrlich
+ * iteration, on the polynomial scaled by a power of 2 that
+ * brings the moduli of its roots about 1, from points on
+ * circles about the origin, until
+ * the polynomial at each root is within rounding error of its
+ * evaluation, or the correction is below the precision of the
+ * root.  The iteration runs on blocks of polynomials in lock
+ * step, the inner loops going across the polynomials of a
+ * block, and the blocks are distributed among threads.  Roots
+ * of real polynomials come in conjugate pairs up to rounding
+ * error, in no particular order.
+ *
  */
 
 /*							polrt	*/
@@ -55,9 +83,28 @@ typedef struct
 */
 #ifdef ANSIPROT
 extern double torch_cephes_fabs ( double );
+extern double torch_cephes_sqrt ( double );
+extern double torch_cephes_log ( double );
+extern double torch_cephes_exp ( double );
+extern double torch_cephes_cos ( double );
+extern double torch_cephes_sin ( double );
+extern double torch_cephes_frexp ( double, int * );
+extern double torch_cephes_ldexp ( double, int );
+extern int torch_cephes_isfinite ( double );
+int torch_cephes_polrt ( double *, double *, int, cmplx * );
+void torch_cephes_polrt_batch ( int, int, double *, cmplx *, int * );
+static void starts ( double *, int, int, double *, double * );
 #else
-double torch_cephes_fabs();
+double torch_cephes_fabs(), torch_cephes_sqrt(), torch_cephes_log();
+double torch_cephes_exp(), torch_cephes_cos(), torch_cephes_sin();
+double torch_cephes_frexp(), torch_cephes_ldexp();
+int torch_cephes_isfinite();
+int torch_cephes_polrt();
+void torch_cephes_polrt_batch();
+static void starts();
 #endif
+extern double torch_cephes_PI, torch_cephes_MACHEP, torch_cephes_MAXNUM;
+extern double torch_cephes_NAN;
 
 int torch_cephes_polrt( xcof, cof, m, root )
 double xcof[], cof[];
@@ -225,3 +272,273 @@ if( n > 0 )
 	goto nxtrut;
 return(0);
 }
+
+
+/* polynomials per block, and the largest degree, as polrt() */
+#define CHUNK 32
+#define MAXDEG 36
+#define MAXIT 500
+
+/* Starting points of the Aberth iteration for the monic polynomial
+ * of degree m whose coefficients of x^k have the absolute values
+ * aa[k*s]: on circles of the radii given by the upper convex hull
+ * of the points (k, log aa[k]), as many on each circle as the
+ * width of its edge of the hull (Bini, 1996).
+ */
+static void starts( aa, s, m, zr, zi )
+double *aa;
+int s, m;
+double *zr, *zi;
+{
+double y[MAXDEG+1], r, th, yk, ur, ui, cr, ci;
+int h[MAXDEG+1];
+int j, k, nh, q, w;
+
+nh = 0;
+for( k=0; k<=m; k++ )
+	{
+	if( k < m && aa[k*s] == 0.0 )
+		continue;
+	yk = k < m ? torch_cephes_log( aa[k*s] ) : 0.0;
+	while( nh >= 2 && (h[nh-1] - h[nh-2]) * (yk - y[nh-2])
+		- (y[nh-1] - y[nh-2]) * (k - h[nh-2]) >= 0.0 )
+		nh -= 1;
+	h[nh] = k;
+	y[nh] = yk;
+	nh += 1;
+	}
+
+/* roots at 0, below the first point of the hull */
+for( j=0; j<h[0]; j++ )
+	{
+	zr[j*s] = 0.0;
+	zi[j*s] = 0.0;
+	}
+for( k=0; k<nh-1; k++ )
+	{
+	w = h[k+1] - h[k];
+	r = torch_cephes_exp( (y[k] - y[k+1]) / w );
+	/* r exp(i th), th = 2 pi (q/w + k/m) + 0.4, q = 0 .. w-1 */
+	th = 2.0 * torch_cephes_PI * k / m + 0.4;
+	ur = r * torch_cephes_cos( th );
+	ui = r * torch_cephes_sin( th );
+	th = 2.0 * torch_cephes_PI / w;
+	cr = torch_cephes_cos( th );
+	ci = torch_cephes_sin( th );
+	for( q=0; q<w; q++ )
+		{
+		zr[j*s] = ur;
+		zi[j*s] = ui;
+		th = ur * cr - ui * ci;
+		ui = ur * ci + ui * cr;
+		ur = th;
+		j += 1;
+		}
+	}
+}
+
+
+void torch_cephes_polrt_batch( n, m, xcof, root, status )
+int n, m;
+double *xcof;
+cmplx *root;
+int *status;
+{
+int i;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double a[MAXDEG][CHUNK], aa[MAXDEG][CHUNK];
+	double zr[MAXDEG][CHUNK], zi[MAXDEG][CHUNK];
+	double pr[CHUNK], pi[CHUNK], dr[CHUNK], di[CHUNK];
+	double sr[CHUNK], si[CHUNK], e[CHUNK], az[CHUNK];
+	char done[MAXDEG][CHUNK];
+	double *c, t, w, hr, hi, eps;
+	int pend[MAXDEG], sc[CHUNK];
+	int nc, l, j, k, iter, left, st;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	if( m <= 0 || m > MAXDEG )
+		{
+		for( l=0; l<nc; l++ )
+			{
+			status[i+l] = m <= 0 ? 1 : 2;
+			for( j=0; j<m; j++ )
+				{
+				root[(i+l)*m+j].r = 0.0;
+				root[(i+l)*m+j].i = 0.0;
+				}
+			}
+		continue;
+		}
+
+	/* monic coefficients, and the starting points */
+	left = 0;
+	for( j=0; j<m; j++ )
+		pend[j] = 0;
+	for( l=0; l<nc; l++ )
+		{
+		c = xcof + (long) (i+l) * (m+1);
+		st = c[m] == 0.0 ? 4 : 0;
+		for( k=0; k<=m; k++ )
+			if( !torch_cephes_isfinite( c[k] ) )
+				st = 3;
+		status[i+l] = st;
+		for( k=0; k<m; k++ )
+			a[k][l] = st ? 0.0 : c[k] / c[m];
+		/* The iteration squares moduli: scale the roots by 2^-sc,
+		 * the geometric mean of the moduli of the nonzero roots
+		 * rounded to a power of 2, so that they are about 1.  This
+		 * multiplies a[k] by 2^-(m-k)sc, exactly.
+		 */
+		sc[l] = 0;
+		for( k=0; k<m && a[k][l] == 0.0; k++ )
+			;
+		if( k < m )
+			{
+			torch_cephes_frexp( a[k][l], &j );
+			sc[l] = (j >= 0 ? j + (m-k)/2 : j - (m-k)/2) / (m-k);
+			}
+		for( k=0; k<m; k++ )
+			{
+			a[k][l] = torch_cephes_ldexp( a[k][l], -(m-k) * sc[l] );
+			aa[k][l] = torch_cephes_fabs( a[k][l] );
+			}
+		if( st == 0 )
+			starts( &aa[0][l], CHUNK, m, &zr[0][l], &zi[0][l] );
+		for( j=0; j<m; j++ )
+			{
+			if( st != 0 )
+				{
+				zr[j][l] = 0.0;
+				zi[j][l] = 0.0;
+				}
+			done[j][l] = st != 0;
+			pend[j] += st == 0;
+			}
+		left += m * (st == 0);
+		}
+
+	/* (2 m MACHEP)^2, Horner's rounding error bound relative to e */
+	eps = 4.0 * m * m * torch_cephes_MACHEP * torch_cephes_MACHEP;
+	for( iter=0; iter<MAXIT && left>0; iter++ )
+		{
+		for( j=0; j<m; j++ )
+			{
+			if( pend[j] == 0 )
+				continue;
+			/* p(z), p'(z), and the bound e on the rounding
+			 * error of p(z), by Horner's scheme */
+			for( l=0; l<nc; l++ )
+				{
+				pr[l] = 1.0;
+				pi[l] = 0.0;
+				dr[l] = 0.0;
+				di[l] = 0.0;
+				e[l] = 1.0;
+				az[l] = torch_cephes_sqrt( zr[j][l] * zr[j][l]
+					+ zi[j][l] * zi[j][l] );
+				}
+			for( k=m-1; k>=0; k-- )
+				{
+				for( l=0; l<nc; l++ )
+					{
+					t = dr[l] * zr[j][l] - di[l] * zi[j][l] + pr[l];
+					di[l] = dr[l] * zi[j][l] + di[l] * zr[j][l] + pi[l];
+					dr[l] = t;
+					t = pr[l] * zr[j][l] - pi[l] * zi[j][l] + a[k][l];
+					pi[l] = pr[l] * zi[j][l] + pi[l] * zr[j][l];
+					pr[l] = t;
+					e[l] = e[l] * az[l] + aa[k][l];
+					}
+				}
+
+			/* sum over the other roots of 1/(z_j - z_k) */
+			for( l=0; l<nc; l++ )
+				{
+				sr[l] = 0.0;
+				si[l] = 0.0;
+				}
+			for( k=0; k<m; k++ )
+				{
+				if( k == j )
+					continue;
+				for( l=0; l<nc; l++ )
+					{
+					hr = zr[j][l] - zr[k][l];
+					hi = zi[j][l] - zi[k][l];
+					w = hr * hr + hi * hi;
+					/* no term for equal points: roots at 0, and the
+					 * lanes of invalid polynomials */
+					w = 1.0 / (w + (w == 0.0));
+					sr[l] += hr * w;
+					si[l] -= hi * w;
+					}
+				}
+
+			/* z_j -= 1/(p'/p - s), a last time once p(z_j) is
+			 * within the rounding error bound */
+			for( l=0; l<nc; l++ )
+				{
+				if( done[j][l] )
+					continue;
+				w = pr[l] * pr[l] + pi[l] * pi[l];
+				if( w <= eps * e[l] * e[l] )
+					{
+					done[j][l] = 1;
+					pend[j] -= 1;
+					left -= 1;
+					if( w == 0.0 )
+						continue;
+					}
+				hr = (dr[l] * pr[l] + di[l] * pi[l]) / w - sr[l];
+				hi = (di[l] * pr[l] - dr[l] * pi[l]) / w - si[l];
+				w = hr * hr + hi * hi;
+				if( w == 0.0 )
+					{
+					/* perturb a stationary point */
+					zr[j][l] += torch_cephes_MACHEP * (1.0 + az[l]);
+					continue;
+					}
+				hr = hr / w;
+				hi = -hi / w;
+				zr[j][l] -= hr;
+				zi[j][l] -= hi;
+				if( !done[j][l] && hr * hr + hi * hi <= 4.0
+					* torch_cephes_MACHEP * torch_cephes_MACHEP
+					* az[l] * az[l] )
+					{
+					done[j][l] = 1;
+					pend[j] -= 1;
+					left -= 1;
+					}
+				}
+			}
+		}
+
+	for( l=0; l<nc; l++ )
+		{
+		/* a coefficient that is not finite */
+		if( status[i+l] == 3 )
+			{
+			for( j=0; j<m; j++ )
+				{
+				root[(i+l)*m+j].r = torch_cephes_NAN;
+				root[(i+l)*m+j].i = torch_cephes_NAN;
+				}
+			continue;
+			}
+		for( j=0; j<m; j++ )
+			{
+			t = torch_cephes_ldexp( zr[j][l], sc[l] );
+			w = torch_cephes_ldexp( zi[j][l], sc[l] );
+			root[(i+l)*m+j].r = t;
+			root[(i+l)*m+j].i = w;
+			if( !done[j][l] || !(torch_cephes_fabs(t) <= torch_cephes_MAXNUM
+				&& torch_cephes_fabs(w) <= torch_cephes_MAXNUM) )
+				status[i+l] = 3;
+			}
+		}
+	}
+}
@@ -27,6 +27,8 @@
  *
  *
  * sum = poleva( a, na, x );	Evaluate polynomial a(t) at t = x.
+ * poleva_batch( m, a, na, sa, n, x, sx, y );
+ *				Evaluate m polynomials at n points each.
  * polprt( a, na, D );		Print the coefficients of a to D digits.
  * polclr( a, na );		Set a identically equal to zero, up to a[na].
  * polmov( a, na, b );		Set b = a.
@@ -57,6 +59,21 @@
  * poldiv() is an integer routine; poleva() is double.
  * Any of the arguments a, b, c may refer to the same array.
  *
+ * poleva_batch() sets y[i*n + j] to the value of the polynomial
+ * a + i*sa at the point x[i*sx + j], for i < m and j < n; sa = 0
+ * or sx = 0 share one polynomial, or one set of points, among all.
+ * It runs Horner's rule on blocks of points at once, two
+ * coefficients per pass over the block, in vector multiply-adds
+ * across the points, and the blocks go to different threads.
+ * With fewer than 8 points per polynomial, the blocks are of
+ * polynomials instead.
+ *
+ * When both factors have at least POLFFT coefficients, polmul()
+ * multiplies by fast Fourier transform, and when MAXPOL is at
+ * least 4 POLFFT, poldiv() multiplies b by the reciprocal series of
+ * a found by Newton's iteration, in O(n log n) operations instead
+ * of O(n^2); see polfft.c.
+ *
  */
 
 #include <stdio.h>
@@ -69,12 +86,17 @@ void torch_cephes_polclr ( double *, int );
 void torch_cephes_polmov ( double *, int, double * );
 void torch_cephes_polmul ( double *, int, double *, int, double * );
 int torch_cephes_poldiv ( double *, int, double *, int, double * );
+void torch_cephes_polfmul ( double *, int, double *, int, double *, int );
+void torch_cephes_polfrcp ( double *, int, double *, int );
+void torch_cephes_poleva_batch ( int, double *, int, int, int, double *,
+	int, double * );
 #else
 void exit();
 void * malloc();
 void free ();
 void torch_cephes_polclr(), torch_cephes_polmov(), torch_cephes_poldiv(),
-    torch_cephes_polmul();
+    torch_cephes_polmul(), torch_cephes_polfmul(), torch_cephes_polfrcp(),
+    torch_cephes_poleva_batch();
 #endif
 #ifndef NULL
 #define NULL 0
@@ -97,6 +119,9 @@ static double *pt3 = 0;
 int torch_cephes_MAXPOL = 0;
 extern int torch_cephes_MAXPOL;
 
+/* Smallest number of coefficients for the transforms of polfft.c */
+extern int torch_cephes_POLFFT;
+
 /* Number of bytes (chars) in maximum size polynomial. */
 static int psize = 0;
 
@@ -230,6 +255,13 @@ int i, j, k, nc;
 double x;
 
 nc = na + nb;
+if( na + 1 >= torch_cephes_POLFFT && nb + 1 >= torch_cephes_POLFFT )
+	{
+	if( nc > torch_cephes_MAXPOL )
+		nc = torch_cephes_MAXPOL;
+	torch_cephes_polfmul( a, na, b, nb, c, nc );
+	return;
+	}
 torch_cephes_polclr( pt3, torch_cephes_MAXPOL );
 
 for( i=0; i<=na; i++ )
@@ -376,6 +408,20 @@ nzero:
 	goto done;
 	}
 
+/* Reciprocal of a by Newton's iteration, times b.
+ */
+if( torch_cephes_MAXPOL + 1 >= 4 * torch_cephes_POLFFT )
+	{
+	if( na > torch_cephes_MAXPOL )
+		na = torch_cephes_MAXPOL;
+	if( nb > torch_cephes_MAXPOL )
+		nb = torch_cephes_MAXPOL;
+	torch_cephes_polfrcp( ta, na, tq, torch_cephes_MAXPOL );
+	torch_cephes_polfmul( tq, torch_cephes_MAXPOL, tb, nb, c,
+		torch_cephes_MAXPOL );
+	goto done;
+	}
+
 /* Long division algorithm.  ta[0] is nonzero.
  */
 for( i=0; i <= torch_cephes_MAXPOL; i++ )
@@ -469,3 +515,83 @@ for( i=na-1; i>=0; i-- )
 	}
 return(s);
 }
+
+
+
+#define CHUNK 256
+
+/* Evaluate m polynomials a + i*sa at n points x + i*sx each.
+ */
+void torch_cephes_poleva_batch( m, a, na, sa, n, x, sx, y )
+int m, na, sa, n, sx;
+double a[], x[], y[];
+{
+int t, nt, per;
+
+if( m <= 0 || n <= 0 )
+	return;
+if( n >= 8 )
+	{
+	/* blocks of points of one polynomial */
+	per = (n + CHUNK - 1) / CHUNK;
+	nt = m * per;
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+	for( t=0; t<nt; t++ )
+		{
+		double s[CHUNK], c, d, *p, *xt, *yt;
+		int i, j, k, nc;
+
+		i = t / per;
+		k = (t % per) * CHUNK;
+		nc = n - k < CHUNK ? n - k : CHUNK;
+		p = a + (long) i * sa;
+		xt = x + (long) i * sx + k;
+		yt = y + (long) i * n + k;
+		c = p[na];
+		for( j=0; j<nc; j++ )
+			s[j] = c;
+		/* two coefficients per pass over the block */
+		for( k=na-1; k>0; k-=2 )
+			{
+			c = p[k];
+			d = p[k-1];
+			for( j=0; j<nc; j++ )
+				s[j] = (s[j] * xt[j] + c) * xt[j] + d;
+			}
+		if( k == 0 )
+			{
+			c = p[0];
+			for( j=0; j<nc; j++ )
+				s[j] = s[j] * xt[j] + c;
+			}
+		for( j=0; j<nc; j++ )
+			yt[j] = s[j];
+		}
+	}
+else
+	{
+	/* blocks of polynomials, for each point */
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+	for( t=0; t<m; t+=CHUNK )
+		{
+		double s[CHUNK], v[CHUNK];
+		int i, j, k, l, nc;
+
+		nc = m - t < CHUNK ? m - t : CHUNK;
+		for( j=0; j<n; j++ )
+			{
+			for( l=0; l<nc; l++ )
+				{
+				i = t + l;
+				v[l] = x[(long) i * sx + j];
+				s[l] = a[(long) i * sa + na];
+				}
+			for( k=na-1; k>=0; k-- )
+				for( l=0; l<nc; l++ )
+					s[l] = s[l] * v[l] + a[(long) (t + l) * sa + k];
+			for( l=0; l<nc; l++ )
+				y[(long) (t + l) * n + j] = s[l];
+			}
+		}
+	}
+}
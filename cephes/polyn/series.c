@@ -0,0 +1,341 @@
+/*							series.c
+ *
+ *	Arithmetic of batches of truncated power series
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int op, n, d, sa, sb, status[n];
+ * double a[], b[], c[n*(d+1)];
+ *
+ * series_batch( op, n, d, a, sa, b, sb, c, status );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Operates on n power series truncated at degree d, the
+ * coefficients of x^0 ... x^d of series i being a[i*sa] ...
+ * a[i*sa+d] and b[i*sb] ... b[i*sb+d], in ascending order as in
+ * polyn.c.  sa = 0 or sb = 0 uses the same series for all.  The
+ * result goes to c[i*(d+1)] ... c[i*(d+1)+d], truncated at
+ * degree d; c may be a or b if its stride is d+1.
+ *
+ *    op   c                     condition
+ *
+ *     0   a + b
+ *     1   a * b
+ *     2   a / b                 b[0] != 0
+ *     3   a( b(x) )
+ *     4   exp( a )
+ *     5   log( a )              a[0] > 0
+ *     6   sqrt( a )             a[0] > 0
+ *     7   sin( a )
+ *     8   cos( a )
+ *     9   atan( a )
+ *
+ * b is read by operations 0 to 3 only.  The functions of a are
+ * the Taylor series of f( a(x) ) about x = 0, so that with
+ * a = a0 + x they are those of f about a0; c[k] is then the k-th
+ * derivative of f at a0 divided by k!.  Composition treats a as a
+ * polynomial of degree d; for a truncated series, b[0] should be
+ * 0.
+ *
+ * The quotient, exp, log, sqrt, sin and cos follow the usual
+ * recurrences from the derivative of f( a(x) ) in O(d^2)
+ * operations, and atan integrates a' / (1 + a^2); composition
+ * is Horner's rule over series, in O(d^3).  Unlike the
+ * functions of polyn.c and polmisc.c, no global storage is
+ * used and there is no limit on d.
+ *
+ * The series are processed in blocks, in lock step: the inner
+ * loops run across the series of a block, and the blocks are
+ * distributed among threads.
+ *
+ * status[i] is 0, or 1 if the condition above fails for series
+ * i, whose coefficients are then all NAN; 2 for an unknown op.
+ *
+ */
+
+/*
+Cephes Math Library Release 2.8:  June, 2000
+Copyright 1984, 1987, 2000 by Stephen L. Moshier
+*/
+
+#include "mconf.h"
+#ifdef ANSIPROT
+extern void * malloc ( unsigned long );
+extern void free ( void * );
+extern double torch_cephes_exp ( double );
+extern double torch_cephes_log ( double );
+extern double torch_cephes_sqrt ( double );
+extern double torch_cephes_sin ( double );
+extern double torch_cephes_cos ( double );
+extern double torch_cephes_atan ( double );
+void torch_cephes_series_batch ( int, int, int, double *, int, double *,
+	int, double *, int * );
+static void block ( int, int, double *, double *, double *, double *,
+	double *, int * );
+#else
+void * malloc();
+void free ();
+double torch_cephes_exp(), torch_cephes_log(), torch_cephes_sqrt();
+double torch_cephes_sin(), torch_cephes_cos(), torch_cephes_atan();
+void torch_cephes_series_batch();
+static void block();
+#endif
+extern double torch_cephes_NAN;
+
+/* series per block */
+#define CHUNK 32
+
+/* Coefficient k of series l of a block */
+#define X(p,k,l) p[(k)*CHUNK + (l)]
+
+
+/* Operation op on the CHUNK series of a block, A, B to C, with
+ * the work arrays U, V; st[l] receives the status of series l.
+ */
+static void block( op, d, A, B, C, U, V, st )
+int op, d;
+double *A, *B, *C, *U, *V;
+int *st;
+{
+double r[CHUNK], q, t;
+int i, j, k, l;
+
+for( l=0; l<CHUNK; l++ )
+	st[l] = 0;
+
+switch( op )
+	{
+	case 0:
+	for( k=0; k<=d; k++ )
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = X(A,k,l) + X(B,k,l);
+	break;
+
+	case 1:
+	for( k=0; k<=d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = 0.0;
+		for( i=0; i<=k; i++ )
+			for( l=0; l<CHUNK; l++ )
+				X(C,k,l) += X(A,i,l) * X(B,k-i,l);
+		}
+	break;
+
+	case 2:
+	for( l=0; l<CHUNK; l++ )
+		{
+		st[l] = X(B,0,l) == 0.0;
+		r[l] = 1.0 / X(B,0,l);
+		}
+	for( k=0; k<=d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			U[l] = X(A,k,l);
+		for( i=1; i<=k; i++ )
+			for( l=0; l<CHUNK; l++ )
+				U[l] -= X(B,i,l) * X(C,k-i,l);
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = U[l] * r[l];
+		}
+	break;
+
+	case 3:
+	/* c = c b + a[j], j = d ... 0 */
+	for( k=0; k<=d; k++ )
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = 0.0;
+	for( l=0; l<CHUNK; l++ )
+		X(C,0,l) = X(A,d,l);
+	for( j=d-1; j>=0; j-- )
+		{
+		for( k=0; k<=d; k++ )
+			{
+			for( l=0; l<CHUNK; l++ )
+				X(U,k,l) = 0.0;
+			for( i=0; i<=k; i++ )
+				for( l=0; l<CHUNK; l++ )
+					X(U,k,l) += X(C,i,l) * X(B,k-i,l);
+			}
+		for( k=0; k<=d; k++ )
+			for( l=0; l<CHUNK; l++ )
+				X(C,k,l) = X(U,k,l);
+		for( l=0; l<CHUNK; l++ )
+			X(C,0,l) += X(A,j,l);
+		}
+	break;
+
+	case 4:
+	/* c' = a' c */
+	for( l=0; l<CHUNK; l++ )
+		X(C,0,l) = torch_cephes_exp( X(A,0,l) );
+	for( k=1; k<=d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = 0.0;
+		for( j=1; j<=k; j++ )
+			{
+			t = (double) j / k;
+			for( l=0; l<CHUNK; l++ )
+				X(C,k,l) += t * X(A,j,l) * X(C,k-j,l);
+			}
+		}
+	break;
+
+	case 5:
+	/* a c' = a' */
+	for( l=0; l<CHUNK; l++ )
+		{
+		st[l] = !(X(A,0,l) > 0.0);
+		X(C,0,l) = st[l] ? 0.0 : torch_cephes_log( X(A,0,l) );
+		r[l] = 1.0 / X(A,0,l);
+		}
+	for( k=1; k<=d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			U[l] = X(A,k,l);
+		for( j=1; j<k; j++ )
+			{
+			t = (double) j / k;
+			for( l=0; l<CHUNK; l++ )
+				U[l] -= t * X(C,j,l) * X(A,k-j,l);
+			}
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = U[l] * r[l];
+		}
+	break;
+
+	case 6:
+	/* c c = a */
+	for( l=0; l<CHUNK; l++ )
+		{
+		st[l] = !(X(A,0,l) > 0.0);
+		X(C,0,l) = st[l] ? 0.0 : torch_cephes_sqrt( X(A,0,l) );
+		r[l] = 0.5 / X(C,0,l);
+		}
+	for( k=1; k<=d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			U[l] = X(A,k,l);
+		for( j=1; j<k; j++ )
+			for( l=0; l<CHUNK; l++ )
+				U[l] -= X(C,j,l) * X(C,k-j,l);
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = U[l] * r[l];
+		}
+	break;
+
+	case 7:
+	case 8:
+	/* s' = a' c, c' = -a' s; sin in U, cos in V */
+	for( l=0; l<CHUNK; l++ )
+		{
+		X(U,0,l) = torch_cephes_sin( X(A,0,l) );
+		X(V,0,l) = torch_cephes_cos( X(A,0,l) );
+		}
+	for( k=1; k<=d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			{
+			X(U,k,l) = 0.0;
+			X(V,k,l) = 0.0;
+			}
+		for( j=1; j<=k; j++ )
+			{
+			t = (double) j / k;
+			for( l=0; l<CHUNK; l++ )
+				{
+				q = t * X(A,j,l);
+				X(U,k,l) += q * X(V,k-j,l);
+				X(V,k,l) -= q * X(U,k-j,l);
+				}
+			}
+		}
+	for( k=0; k<=d; k++ )
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = op == 7 ? X(U,k,l) : X(V,k,l);
+	break;
+
+	case 9:
+	/* c' = a' / (1 + a^2): 1 + a^2 in U, a' / (1 + a^2) in V */
+	for( k=0; k<d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			X(U,k,l) = k == 0 ? 1.0 : 0.0;
+		for( i=0; i<=k; i++ )
+			for( l=0; l<CHUNK; l++ )
+				X(U,k,l) += X(A,i,l) * X(A,k-i,l);
+		}
+	for( k=0; k<d; k++ )
+		{
+		for( l=0; l<CHUNK; l++ )
+			X(V,k,l) = (k + 1) * X(A,k+1,l);
+		for( i=1; i<=k; i++ )
+			for( l=0; l<CHUNK; l++ )
+				X(V,k,l) -= X(U,i,l) * X(V,k-i,l);
+		for( l=0; l<CHUNK; l++ )
+			X(V,k,l) /= X(U,0,l);
+		}
+	for( l=0; l<CHUNK; l++ )
+		X(C,0,l) = torch_cephes_atan( X(A,0,l) );
+	for( k=1; k<=d; k++ )
+		for( l=0; l<CHUNK; l++ )
+			X(C,k,l) = X(V,k-1,l) / k;
+	break;
+
+	default:
+	for( l=0; l<CHUNK; l++ )
+		st[l] = 2;
+	}
+}
+
+
+
+void torch_cephes_series_batch( op, n, d, a, sa, b, sb, c, status )
+int op, n, d, sa, sb;
+double *a, *b, *c;
+int *status;
+{
+int i;
+
+if( d < 0 )
+	return;
+
+#pragma omp parallel for copyin(torch_cephes_stats_id)
+for( i=0; i<n; i+=CHUNK )
+	{
+	double *A, *B, *C, *U, *V;
+	int st[CHUNK];
+	int k, l, nc;
+	long m;
+
+	nc = n - i < CHUNK ? n - i : CHUNK;
+	m = (long) (d + 1) * CHUNK;
+	A = (double *) malloc( 5 * m * sizeof(double) );
+	B = A + m;
+	C = B + m;
+	U = C + m;
+	V = U + m;
+
+	/* lanes past the end of the batch repeat the last series */
+	for( l=0; l<CHUNK; l++ )
+		for( k=0; k<=d; k++ )
+			{
+			X(A,k,l) = a[(long) (i + (l < nc ? l : nc - 1)) * sa + k];
+			X(B,k,l) = op > 3 ? 0.0 : b[(long) (i + (l < nc ? l : nc - 1)) * sb + k];
+			}
+	block( op, d, A, B, C, U, V, st );
+	for( l=0; l<nc; l++ )
+		{
+		status[i+l] = st[l];
+		for( k=0; k<=d; k++ )
+			c[(long) (i+l) * (d+1) + k] = st[l] ? torch_cephes_NAN : X(C,k,l);
+		}
+	free( A );
+	}
+}
@@ -62,6 +62,10 @@ int torch_cephes_merror = 0;
 #define MAXERRLEN 100
 char torch_cephes_errtxt[MAXERRLEN];
 
+/* Error counters, see torch_stats.c */
+extern int torch_cephes_stats_enabled;
+extern void torch_cephes_stats_error ( int );
+
 /* Notice: the order of appearance of the following
  * messages is bound to the error codes defined
  * in mconf.h.
@@ -81,22 +85,31 @@ int torch_cephes_mtherr( name, code )
     char *name;
     int code;
 {
+    int msg;
 
-    torch_cephes_merror = code;
+    if( torch_cephes_stats_enabled )
+        torch_cephes_stats_error( code );
 
     /* Display error message defined
      * by the code argument.
      */
-    if( (code <= 0) || (code >= 7) )
-        code = 0;
+    msg = code;
+    if( (msg <= 0) || (msg >= 7) )
+        msg = 0;
 
     /* Display string passed by calling program,
      * which is supposed to be the name of the
      * function in which the error occurred:
      */
-    /* Set global error message word */
-    snprintf( torch_cephes_errtxt, MAXERRLEN,
-              "%s: %s error", name, ermsg[code] );
+    /* Set global error message word, under a lock: the batch
+     * kernels may get here from several threads at once.
+     */
+#pragma omp critical (torch_cephes_mtherr)
+    {
+        torch_cephes_merror = code;
+        snprintf( torch_cephes_errtxt, MAXERRLEN,
+                  "%s: %s error", name, ermsg[msg] );
+    }
 
     /* Return to calling
      * program
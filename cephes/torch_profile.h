@@ -0,0 +1,67 @@
+/*							torch_profile.h
+ *
+ *	Code path counters of the instrumentation build
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * #include "../torch_profile.h"
+ *
+ * PROFILE( function, path, iterations );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * The functions below choose among very different algorithms
+ * by argument region.  When the library is built with
+ * TORCH_CEPHES_PROFILE defined (cmake -DCEPHES_PROFILE=ON), they
+ * record each algorithm they run, with the number of terms of its
+ * series or continued fraction, while torch_cephes_stats_enabled
+ * is set; torch_cephes_profile_read in torch_stats.c returns the
+ * counts of each path, as histograms of the iterations over the
+ * buckets 0, 1, 2-3, 4-7, ..., 2^14-2^15-1, and 2^15 and more.
+ * Otherwise PROFILE expands to a void expression.
+ *
+ *  function       paths
+ *
+ *  PROF_JV        0 j0 or j1, 1 ascending series, 2 Hankel
+ *                 expansion, 3 continued fraction and backward
+ *                 recurrence, 4 uniform asymptotic expansion,
+ *                 5 transition region expansion, 6 error or zero
+ *  PROF_HYP2F1    0 ... 9 the branches HDIV ... HSER of
+ *                 hyp2f1.c, 10 power series, 11 psi expansion
+ *  PROF_IGAM      0 power series (igam), 1 continued fraction
+ *                 (igamc), 2 error or underflow
+ *  PROF_INCBET    0 power series, 1 continued fraction incbcf,
+ *                 2 continued fraction incbd, 3 x and a, b
+ *                 exchanged, 4 error or limit
+ *  PROF_NDTRI     0 central region, 1 tail, 2 far tail
+ *                 (y < exp(-32)), 3 error
+ *
+ */
+
+#define PROF_JV 0
+#define PROF_HYP2F1 1
+#define PROF_IGAM 2
+#define PROF_INCBET 3
+#define PROF_NDTRI 4
+#define PROF_FUNCTIONS 5
+
+/* paths per function, and buckets of iterations */
+#define PROF_PATHS 16
+#define PROF_BUCKETS 17
+
+#ifdef TORCH_CEPHES_PROFILE
+extern int torch_cephes_stats_enabled;
+#ifdef ANSIPROT
+extern void torch_cephes_profile ( int, int, int );
+#else
+void torch_cephes_profile();
+#endif
+#define PROFILE(f, p, n) \
+	do { if( torch_cephes_stats_enabled ) torch_cephes_profile( f, p, n ); } while( 0 )
+#else
+#define PROFILE(f, p, n) ((void) 0)
+#endif
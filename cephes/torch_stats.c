@@ -0,0 +1,233 @@
+/*							torch_stats.c
+ *
+ *	Call and error counters of the lua wrappers
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int id, n;
+ * double elements, out[n * TORCH_CEPHES_STATS_FIELDS];
+ *
+ * torch_cephes_stats_enabled = 1;
+ * torch_cephes_stats_begin( id );
+ * ... call of function id ...
+ * torch_cephes_stats_end( id, elements );
+ *
+ * torch_cephes_stats_read( n, out );
+ * torch_cephes_stats_reset();
+ *
+ * double hist[PROF_FUNCTIONS * PROF_PATHS * PROF_BUCKETS];
+ * torch_cephes_profile_read( hist );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * While torch_cephes_stats_enabled is nonzero, the wrappers of
+ * error_handling.lua count, for each function, the calls, the
+ * elements computed and the time spent, in nanoseconds, between
+ * torch_cephes_stats_begin and torch_cephes_stats_end; and mtherr
+ * counts the errors of each code of mconf.h, 0 for the unknown
+ * ones, for the function of the call in progress.  id is an
+ * index from 1 to TORCH_CEPHES_STATS_MAX - 1 given by the
+ * wrappers; errors raised outside of a wrapped call are counted
+ * for id 0.  The call in progress is kept per thread, and the
+ * batch kernels pass it to their threads, so that calls made at
+ * once by several threads are each charged their own errors.
+ *
+ * The counters are kept per thread, threads of the batch kernels
+ * included, so that counting takes no lock; each thread
+ * allocates its counters on first use.  torch_cephes_stats_read
+ * sums them over all threads for ids 0 ... n-1 into out, in
+ * rows of TORCH_CEPHES_STATS_FIELDS values:
+ *
+ *    calls, elements, nanoseconds,
+ *    errors of code 0, 1, ..., 6
+ *
+ * and returns the number of threads.  torch_cephes_stats_reset
+ * clears the counters of all threads.  Neither is synchronized
+ * with calls in progress in other threads.
+ *
+ * In the instrumentation build, see torch_profile.h, the same
+ * per-thread storage holds the code path histograms, which
+ * torch_cephes_profile_read sums over all threads into hist,
+ * hist[(f * PROF_PATHS + p) * PROF_BUCKETS + b] being the count
+ * of path p of function f with iterations in bucket b.  It
+ * returns 1, or 0 and no histograms if the library was built
+ * without TORCH_CEPHES_PROFILE.  torch_cephes_stats_reset clears
+ * them too.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cmath/mconf.h"
+#include "torch_profile.h"
+
+#define TORCH_CEPHES_STATS_MAX 512
+#define TORCH_CEPHES_STATS_FIELDS 10
+
+int torch_cephes_stats_enabled = 0;
+
+typedef struct statsblock
+{
+    unsigned long long count[TORCH_CEPHES_STATS_MAX][TORCH_CEPHES_STATS_FIELDS];
+#ifdef TORCH_CEPHES_PROFILE
+    unsigned long long path[PROF_FUNCTIONS][PROF_PATHS][PROF_BUCKETS];
+#endif
+    struct timespec start;
+    struct statsblock *next;
+} statsblock;
+
+/* Counters of all threads, and of the current one */
+static statsblock *blocks = NULL;
+static statsblock *mine = NULL;
+#ifdef _OPENMP
+#pragma omp threadprivate(mine)
+#endif
+
+/* Function of the wrapped call in progress in each thread, given
+ * to the threads of its batch kernels by copyin, see mconf.h */
+int torch_cephes_stats_id = 0;
+
+static statsblock *myblock()
+{
+    if( mine == NULL )
+    {
+        mine = (statsblock *) calloc( 1, sizeof(statsblock) );
+        if( mine == NULL )
+            return NULL;
+#pragma omp critical (torch_cephes_stats)
+        {
+            mine->next = blocks;
+            blocks = mine;
+        }
+    }
+    return mine;
+}
+
+void torch_cephes_stats_begin( id )
+    int id;
+{
+    statsblock *b = myblock();
+
+    if( b == NULL || id <= 0 || id >= TORCH_CEPHES_STATS_MAX )
+        return;
+    torch_cephes_stats_id = id;
+    clock_gettime( CLOCK_MONOTONIC, &b->start );
+}
+
+void torch_cephes_stats_end( id, elements )
+    int id;
+    double elements;
+{
+    statsblock *b = myblock();
+    struct timespec now;
+
+    torch_cephes_stats_id = 0;
+    if( b == NULL || id <= 0 || id >= TORCH_CEPHES_STATS_MAX )
+        return;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    b->count[id][0] += 1;
+    b->count[id][1] += (unsigned long long) elements;
+    b->count[id][2] += (now.tv_sec - b->start.tv_sec) * 1000000000LL
+                       + (now.tv_nsec - b->start.tv_nsec);
+}
+
+/* Called by mtherr */
+void torch_cephes_stats_error( code )
+    int code;
+{
+    statsblock *b = myblock();
+
+    if( b == NULL )
+        return;
+    if( (code <= 0) || (code >= 7) )
+        code = 0;
+    b->count[torch_cephes_stats_id][3 + code] += 1;
+}
+
+int torch_cephes_stats_read( n, out )
+    int n;
+    double *out;
+{
+    statsblock *b;
+    int i, j, threads;
+
+    if( n > TORCH_CEPHES_STATS_MAX )
+        n = TORCH_CEPHES_STATS_MAX;
+    for( i = 0; i < n * TORCH_CEPHES_STATS_FIELDS; i++ )
+        out[i] = 0.0;
+    threads = 0;
+#pragma omp critical (torch_cephes_stats)
+    for( b = blocks; b != NULL; b = b->next )
+    {
+        threads += 1;
+        for( i = 0; i < n; i++ )
+            for( j = 0; j < TORCH_CEPHES_STATS_FIELDS; j++ )
+                out[i * TORCH_CEPHES_STATS_FIELDS + j] += (double) b->count[i][j];
+    }
+    return threads;
+}
+
+void torch_cephes_stats_reset()
+{
+    statsblock *b;
+    int i, j;
+
+#pragma omp critical (torch_cephes_stats)
+    for( b = blocks; b != NULL; b = b->next )
+    {
+        for( i = 0; i < TORCH_CEPHES_STATS_MAX; i++ )
+            for( j = 0; j < TORCH_CEPHES_STATS_FIELDS; j++ )
+                b->count[i][j] = 0;
+#ifdef TORCH_CEPHES_PROFILE
+        memset( b->path, 0, sizeof(b->path) );
+#endif
+    }
+}
+
+/* Called through PROFILE, see torch_profile.h */
+void torch_cephes_profile( f, p, n )
+    int f, p, n;
+{
+#ifdef TORCH_CEPHES_PROFILE
+    statsblock *b = myblock();
+    int k;
+
+    if( b == NULL || f < 0 || f >= PROF_FUNCTIONS || p < 0 || p >= PROF_PATHS )
+        return;
+    /* bucket 0 for n = 0, k+1 for 2^k <= n < 2^(k+1) */
+    for( k = 0; n > 0 && k < PROF_BUCKETS - 1; k++ )
+        n >>= 1;
+    b->path[f][p][k] += 1;
+#else
+    (void) f;
+    (void) p;
+    (void) n;
+#endif
+}
+
+int torch_cephes_profile_read( out )
+    double *out;
+{
+#ifdef TORCH_CEPHES_PROFILE
+    statsblock *b;
+    int f, p, k;
+
+    for( f = 0; f < PROF_FUNCTIONS * PROF_PATHS * PROF_BUCKETS; f++ )
+        out[f] = 0.0;
+#pragma omp critical (torch_cephes_stats)
+    for( b = blocks; b != NULL; b = b->next )
+        for( f = 0; f < PROF_FUNCTIONS; f++ )
+            for( p = 0; p < PROF_PATHS; p++ )
+                for( k = 0; k < PROF_BUCKETS; k++ )
+                    out[(f * PROF_PATHS + p) * PROF_BUCKETS + k] += (double) b->path[f][p][k];
+    return 1;
+#else
+    (void) out;
+    return 0;
+#endif
+}